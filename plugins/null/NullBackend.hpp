@@ -1,12 +1,15 @@
 #pragma once
 #include "backend/include/IRenderBackend.h"
 #include "core/util/Logger.h"
+#include <algorithm>
 #include <glm/glm.hpp>
 
 namespace gfx {
 
 class NullBackend final : public IRenderBackend {
   public:
+    static constexpr uint64_t kPlacementAlignment = 64 * 1024; // what desktop GPUs ask for render targets
+
     bool init(void*) override {
         core::util::Logger::info("[Null] init");
         return true;
@@ -38,7 +41,64 @@ class NullBackend final : public IRenderBackend {
     void destroyBuffer(BufferHandle) override {
     }
 
-    void cmdBeginRenderPass(CmdHandle, void*, uint32_t) override {
+    /* tightly packed 4-byte texels with the full mip chain, no real memory behind it */
+    MemoryRequirements memoryRequirements(const TextureDesc& d) override {
+        uint64_t bytes = 0;
+        for (uint32_t m = 0; m < d.mipLevels; ++m)
+            bytes += uint64_t{std::max(d.width >> m, 1u)} * std::max(d.height >> m, 1u) * 4;
+        return {bytes * d.layers, kPlacementAlignment};
+    }
+    MemoryRequirements memoryRequirements(const BufferDesc& d) override {
+        return {d.sizeBytes, 256};
+    }
+    HeapHandle createHeap(const HeapDesc&) override {
+        ++m_liveHeaps;
+        return {};
+    }
+    void destroyHeap(HeapHandle) override {
+        --m_liveHeaps;
+    }
+    /* created and not yet destroyed, so tests can follow when memory goes */
+    uint32_t liveHeaps() const noexcept {
+        return m_liveHeaps;
+    }
+    TextureHandle createPlacedTexture(const TextureDesc&, HeapHandle, uint64_t) override {
+        return {};
+    }
+    BufferHandle createPlacedBuffer(const BufferDesc&, HeapHandle, uint64_t) override {
+        return {};
+    }
+
+    /* claims an async queue so RenderGraph's queue scheduling runs headless */
+    bool hasAsyncCompute() const override {
+        return true;
+    }
+    CmdHandle beginBatch(QueueType) override {
+        return {};
+    }
+    void batchWait(CmdHandle, SyncPoint) override {
+    }
+    SyncPoint submitBatch(CmdHandle, QueueType, bool) override {
+        return {};
+    }
+
+    /* nothing runs, so nothing to time */
+    TimestampReadback beginTimestamps(uint32_t, uint64_t) override {
+        return {};
+    }
+    void cmdWriteTimestamp(CmdHandle, QueueType, uint32_t) override {
+    }
+
+    /* handles of their own, so tests can tell where a pass recorded */
+    CmdHandle beginSecondary(CmdHandle, bool continueRenderPass) override {
+        return {continueRenderPass ? &m_continuingSecondary : &m_secondary};
+    }
+    void endSecondary(CmdHandle) override {
+    }
+    void cmdExecuteSecondaries(CmdHandle, std::span<const CmdHandle>) override {
+    }
+
+    void cmdBeginRenderPass(CmdHandle, void*, uint32_t, bool, const RenderPassOps&) override {
     }
     void cmdEndRenderPass(CmdHandle) override {
     }
@@ -55,8 +115,15 @@ class NullBackend final : public IRenderBackend {
     void cmdDrawIndexed(CmdHandle, uint32_t, uint32_t, uint32_t, int32_t, uint32_t) override {
     }
 
+    void cmdBarriers(CmdHandle, std::span<const ResourceBarrier>) override {
+    }
+
     void transition(gfx::CmdHandle, gfx::TextureHandle, int, int, int, int, int, int) override {
     }
+
+  private:
+    char m_secondary{0}, m_continuingSecondary{0};
+    uint32_t m_liveHeaps{0};
 };
 
 /* exported factory */
@@ -1,6 +1,9 @@
 #pragma once
+#include "graphics/resources/CookedMesh.h"
 #include <array>
+#include <cstddef>
 #include <glm/glm.hpp>
+#include <vector>
 #include <volk.h>
 
 struct Vertex {
@@ -43,3 +46,76 @@ struct Vertex {
         return attr;
     }
 };
+
+/* 20-byte quantized vertex – byte-for-byte gfx::MeshVertex, so cooked
+   .vmesh vertex data uploads as-is.  Decoding is split between the
+   vertex-fetch formats and the shader:
+   * position: unorm16 in [0,1] across the mesh AABB; the AABB scale /
+     offset is folded into the MVP (see dequantizeMatrix)
+   * normal:   octahedral snorm16 × 2, unfolded in the shader
+   * uv:       half × 2 (fetched as float)
+   * color:    unorm8 × 4 */
+struct PackedVertex {
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t uv[2];
+    uint8_t color[4];
+
+    static VkVertexInputBindingDescription GetBindingDescription() {
+        VkVertexInputBindingDescription binding{};
+        binding.binding = 0;
+        binding.stride = sizeof(PackedVertex);
+        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        return binding;
+    }
+
+    static std::array<VkVertexInputAttributeDescription, 4> GetAttributeDescriptions() {
+        std::array<VkVertexInputAttributeDescription, 4> attr{};
+
+        attr[0].binding = 0;
+        attr[0].location = 0;
+        attr[0].format = VK_FORMAT_R16G16B16A16_UNORM;
+        attr[0].offset = offsetof(PackedVertex, position);
+
+        attr[1].binding = 0;
+        attr[1].location = 1;
+        attr[1].format = VK_FORMAT_R16G16_SNORM;
+        attr[1].offset = offsetof(PackedVertex, normal);
+
+        attr[2].binding = 0;
+        attr[2].location = 2;
+        attr[2].format = VK_FORMAT_R16G16_SFLOAT;
+        attr[2].offset = offsetof(PackedVertex, uv);
+
+        attr[3].binding = 0;
+        attr[3].location = 3;
+        attr[3].format = VK_FORMAT_R8G8B8A8_UNORM;
+        attr[3].offset = offsetof(PackedVertex, color);
+
+        return attr;
+    }
+
+    /* object-space position = min + q * (max - min), as a matrix to post-multiply the model matrix with */
+    static glm::mat4 dequantizeMatrix(const gfx::MeshBounds& b) {
+        glm::mat4 m(1.f);
+        for (int c = 0; c < 3; ++c) {
+            m[c][c] = b.max[c] - b.min[c];
+            m[3][c] = b.min[c];
+        }
+        return m;
+    }
+};
+static_assert(sizeof(PackedVertex) == sizeof(gfx::MeshVertex));
+static_assert(offsetof(PackedVertex, color) == offsetof(gfx::MeshVertex, color));
+static_assert(sizeof(PackedVertex) * 2 < sizeof(Vertex), "packed layout should be under half the fp32 one");
+
+/* Binding + attributes of one interleaved vertex stream, for pipeline creation */
+struct VertexLayout {
+    VkVertexInputBindingDescription binding{};
+    std::vector<VkVertexInputAttributeDescription> attributes;
+
+    template <typename V> static VertexLayout Of() {
+        const auto attr = V::GetAttributeDescriptions();
+        return {V::GetBindingDescription(), {attr.begin(), attr.end()}};
+    }
+};
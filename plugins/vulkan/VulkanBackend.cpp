@@ -1,10 +1,13 @@
 // VulkanBackend.cpp
 #define VK_NO_PROTOTYPES
 #include "VulkanBackend.h"
+#include "core/jobs/JobSystem.h"
 #include "core/util/Logger.h"
 #include "platform/Window.h"
+#include <algorithm>
 #include <glm/glm.hpp>
 #include <iostream>
+#include <limits>
 #include <volk.h>
 
 using gfx::CmdHandle;
@@ -55,6 +58,7 @@ gfx::CmdHandle VulkanBackend::beginFrame() {
     VkFence inf = s.getInFlight();
     vkWaitForFences(m_device.logical(), 1, &inf, VK_TRUE, UINT64_MAX);
     vkResetFences(m_device.logical(), 1, &inf);
+    prepareFramePools(); // this frame's batches and secondaries are no longer in flight
 
     uint32_t imgIdx;
     vkAcquireNextImageKHR(m_device.logical(), m_swap.Get(), UINT64_MAX, s.getImageAvailable(), VK_NULL_HANDLE, &imgIdx);
@@ -67,46 +71,19 @@ gfx::CmdHandle VulkanBackend::beginFrame() {
     bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     vkBeginCommandBuffer(m_currentCmd, &bi);
 
-    /* ----- ensure image is COLOR_ATTACHMENT_OPTIMAL ----- */
-    VkImageLayout old = m_imgLayout[m_currentImg];
-
-    // Transition from TRANSFER_DST_OPTIMAL → COLOR_ATTACHMENT_OPTIMAL
-    VkImageMemoryBarrier toClear{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-    toClear.oldLayout = m_imgLayout[m_currentImg];
-    toClear.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    toClear.srcAccessMask = 0;
-    toClear.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    toClear.image = m_swap.CurrentImage(m_currentImg);
-    toClear.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
-
-    vkCmdPipelineBarrier(m_currentCmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr,
-                         0, nullptr, 1, &toClear);
-
-    m_imgLayout[m_currentImg] = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
+    /* layout transitions of the swapchain image come from the RenderGraph (see cmdBarriers) */
     return {m_currentCmd};
 }
 
 void VulkanBackend::endFrame(gfx::CmdHandle /*h*/) {
     auto& f = m_sync[m_frameIndex];
-    VkSemaphore ws = f.getImageAvailable();
     VkSemaphore rf = f.getRenderFinished();
-    VkFence inf = f.getInFlight();
 
     vkEndCommandBuffer(m_currentCmd);
 
     /* ----- submit + present ----- */
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    VkSubmitInfo submit{VK_STRUCTURE_TYPE_SUBMIT_INFO};
-    submit.waitSemaphoreCount = 1;
-    submit.pWaitSemaphores = &ws;
-    submit.pWaitDstStageMask = &waitStage;
-    submit.commandBufferCount = 1;
-    submit.pCommandBuffers = &m_currentCmd;
-    submit.signalSemaphoreCount = 1;
-    submit.pSignalSemaphores = &rf;
-
-    vkQueueSubmit(m_device.GetGraphicsQueue(), 1, &submit, f.getInFlight());
+    submit(m_device.GetGraphicsQueue(), m_currentCmd, !m_frameBatches[m_frameIndex].acquireWaited, rf,
+           f.getInFlight());
 
     VkPresentInfoKHR pres{VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
     pres.waitSemaphoreCount = 1;
@@ -135,6 +112,148 @@ void VulkanBackend::clearColor(gfx::CmdHandle h, gfx::TextureHandle, const float
                          &mag, 1, &sr);
 }
 
+namespace {
+
+struct UsageState {
+    VkImageLayout layout;
+    VkAccessFlags access;
+    VkPipelineStageFlags stages;
+};
+
+UsageState usageState(ResourceUsage u, bool depth) {
+    switch (u) {
+    case ResourceUsage::Undefined:
+        return {VK_IMAGE_LAYOUT_UNDEFINED, 0, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+    case ResourceUsage::ColorAttachment:
+        return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+    case ResourceUsage::DepthAttachment:
+        return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT};
+    case ResourceUsage::Sampled:
+        return {depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT};
+    case ResourceUsage::Storage:
+        return {VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT};
+    case ResourceUsage::TransferSrc:
+        return {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT};
+    case ResourceUsage::TransferDst:
+        return {VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT};
+    case ResourceUsage::Present:
+        return {VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, 0, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
+    case ResourceUsage::VertexBuffer:
+        return {VK_IMAGE_LAYOUT_UNDEFINED, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT};
+    case ResourceUsage::IndexBuffer:
+        return {VK_IMAGE_LAYOUT_UNDEFINED, VK_ACCESS_INDEX_READ_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT};
+    case ResourceUsage::Uniform:
+        return {VK_IMAGE_LAYOUT_UNDEFINED, VK_ACCESS_UNIFORM_READ_BIT,
+                VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT};
+    }
+    return {VK_IMAGE_LAYOUT_UNDEFINED, 0, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT};
+}
+
+/* what a compute-only queue may name in a barrier */
+constexpr VkPipelineStageFlags kComputeQueueStages =
+    VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+VkPipelineStageFlags computeQueueStages(VkPipelineStageFlags stages, VkPipelineStageFlags fallback) {
+    return (stages & kComputeQueueStages) ? stages & kComputeQueueStages : fallback;
+}
+
+} // namespace
+
+/* All barriers of one pass boundary → one vkCmdPipelineBarrier.  Only
+   writes need to be made available, so reads never enter srcAccessMask.
+   A queue transfer between different families is a release (source
+   half) then an acquire (destination half) with the same layouts;
+   within one family the release is dropped and the acquire is a
+   plain barrier. */
+void VulkanBackend::cmdBarriers(CmdHandle h, std::span<const ResourceBarrier> barriers) {
+    std::vector<VkImageMemoryBarrier> images;
+    std::vector<VkBufferMemoryBarrier> buffers;
+    VkPipelineStageFlags srcStages = 0, dstStages = 0;
+
+    for (const ResourceBarrier& b : barriers) {
+        const UsageState src = usageState(b.before, b.depth);
+        const UsageState dst = usageState(b.after, b.depth);
+        VkAccessFlags srcAccess = isWriteUsage(b.before) ? src.access : 0;
+        VkAccessFlags dstAccess = dst.access;
+        VkPipelineStageFlags srcStage = src.stages;
+        VkPipelineStageFlags dstStage = dst.stages;
+        if (b.previousAlias != ResourceUsage::Undefined) { // memory handed over from another transient
+            const UsageState prev = usageState(b.previousAlias, b.depth);
+            srcStage |= prev.stages;
+            srcAccess |= isWriteUsage(b.previousAlias) ? prev.access : 0;
+        }
+
+        const uint32_t srcFamily = queueFamily(b.srcQueue), dstFamily = queueFamily(b.dstQueue);
+        const bool ownership = b.transfer != QueueTransfer::None && srcFamily != dstFamily;
+        if (b.transfer == QueueTransfer::Release && !ownership)
+            continue;
+        if (ownership && b.transfer == QueueTransfer::Release) { // the acquire side makes it visible
+            dstAccess = 0;
+            dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        } else if (ownership) { // the semaphore already waited for the release
+            srcAccess = 0;
+            srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        }
+        const QueueType recordedOn = b.transfer == QueueTransfer::Release ? b.srcQueue : b.dstQueue;
+        if (recordedOn == QueueType::AsyncCompute && m_device.hasAsyncCompute()) {
+            srcStage = computeQueueStages(srcStage, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+            dstStage = computeQueueStages(dstStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        }
+        const uint32_t srcIndex = ownership ? srcFamily : VK_QUEUE_FAMILY_IGNORED;
+        const uint32_t dstIndex = ownership ? dstFamily : VK_QUEUE_FAMILY_IGNORED;
+
+        if (const auto* tex = std::get_if<TextureHandle>(&b.handle)) {
+            VkImage img = VK_NULL_HANDLE;
+            if (tex->id == BackbufferTexture.id) {
+                img = m_swap.CurrentImage(m_currentImg); // may run on a worker: no tracking writes here
+            } else if (auto it = m_images.find(tex->id); it != m_images.end()) {
+                img = it->second;
+            }
+            if (img == VK_NULL_HANDLE)
+                continue;
+            VkImageMemoryBarrier ib{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            ib.srcAccessMask = srcAccess;
+            ib.dstAccessMask = dstAccess;
+            ib.oldLayout = src.layout;
+            ib.newLayout = dst.layout;
+            ib.srcQueueFamilyIndex = srcIndex;
+            ib.dstQueueFamilyIndex = dstIndex;
+            ib.image = img;
+            ib.subresourceRange = {static_cast<VkImageAspectFlags>(b.depth ? VK_IMAGE_ASPECT_DEPTH_BIT
+                                                                           : VK_IMAGE_ASPECT_COLOR_BIT),
+                                   0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+            images.push_back(ib);
+        } else {
+            const auto it = m_buffers.find(std::get<BufferHandle>(b.handle).id);
+            if (it == m_buffers.end() || it->second == VK_NULL_HANDLE)
+                continue;
+            VkBufferMemoryBarrier bb{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+            bb.srcAccessMask = srcAccess;
+            bb.dstAccessMask = dstAccess;
+            bb.srcQueueFamilyIndex = srcIndex;
+            bb.dstQueueFamilyIndex = dstIndex;
+            bb.buffer = it->second;
+            bb.size = VK_WHOLE_SIZE;
+            buffers.push_back(bb);
+        }
+        srcStages |= srcStage;
+        dstStages |= dstStage;
+    }
+    if (images.empty() && buffers.empty())
+        return;
+
+    vkCmdPipelineBarrier(toCmd(h), srcStages, dstStages, 0, 0, nullptr, static_cast<uint32_t>(buffers.size()),
+                         buffers.data(), static_cast<uint32_t>(images.size()), images.data());
+}
+
 void VulkanBackend::transition(gfx::CmdHandle cmd, gfx::TextureHandle tex, int oldLayout, int newLayout, int srcAccess,
                                int dstAccess, int srcStage, int dstStage) {
     VkCommandBuffer vkCmd = static_cast<VkCommandBuffer>(cmd.ptr);
@@ -180,7 +299,24 @@ void VulkanBackend::shutdown() {
 
     /* 3. Command buffers & pool ---------------------------------- */
     m_cmd.Destroy(m_device.logical()); // wrapper frees buffers
-    // if you created an extra pool, destroy it here
+    for (auto& frame : m_workerPools)
+        for (auto& wp : frame)
+            vkDestroyCommandPool(m_device.logical(), wp.pool, nullptr); // frees its secondaries
+    m_workerPools.clear();
+    for (auto& fb : m_frameBatches) {
+        vkDestroyCommandPool(m_device.logical(), fb.graphics.pool, nullptr);
+        vkDestroyCommandPool(m_device.logical(), fb.compute.pool, nullptr);
+        for (VkSemaphore s : fb.semaphores)
+            vkDestroySemaphore(m_device.logical(), s, nullptr);
+    }
+    m_frameBatches.clear();
+    for (const TimestampPool& tp : m_timestampPools)
+        if (tp.pool)
+            vkDestroyQueryPool(m_device.logical(), tp.pool, nullptr);
+    m_timestampPools.clear();
+    for (const auto& [key, variant] : m_renderPassVariants)
+        vkDestroyRenderPass(m_device.logical(), variant, nullptr);
+    m_renderPassVariants.clear();
 
     /* 4. Swap-chain & depth -------------------------------------- */
     m_swap.Destroy(); // frees image-views, depth
@@ -207,35 +343,379 @@ BufferHandle VulkanBackend::createBuffer(const BufferDesc& d) {
     return {id};
 }
 void VulkanBackend::destroyTexture(TextureHandle h) {
+    if (auto it = m_images.find(h.id); it != m_images.end() && it->second != VK_NULL_HANDLE)
+        vkDestroyImage(m_device.logical(), it->second, nullptr);
     m_images.erase(h.id);
 }
 void VulkanBackend::destroyBuffer(BufferHandle h) {
+    if (auto it = m_buffers.find(h.id); it != m_buffers.end() && it->second != VK_NULL_HANDLE)
+        vkDestroyBuffer(m_device.logical(), it->second, nullptr);
     m_buffers.erase(h.id);
 }
 
-void VulkanBackend::cmdBeginRenderPass(CmdHandle h, void* pipeVoid, uint32_t fbIdx) {
+/* ---------------- transient heaps (RenderGraph aliasing) ---------------- */
+namespace {
+
+VkImageCreateInfo placedImageInfo(const TextureDesc& d, VkFormat depthFormat) {
+    const bool depth = d.format == TextureDesc::Format::Depth24;
+    VkImageCreateInfo ci{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    ci.flags = VK_IMAGE_CREATE_ALIAS_BIT;
+    ci.imageType = VK_IMAGE_TYPE_2D;
+    ci.format = depth ? depthFormat : VK_FORMAT_R8G8B8A8_UNORM;
+    ci.extent = {d.width, d.height, 1};
+    ci.mipLevels = d.mipLevels;
+    ci.arrayLayers = d.layers;
+    ci.samples = VK_SAMPLE_COUNT_1_BIT;
+    ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+    ci.usage = depth ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+                     : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
+                           VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    return ci;
+}
+
+VkBufferCreateInfo placedBufferInfo(const BufferDesc& d) {
+    VkBufferCreateInfo ci{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    ci.size = d.sizeBytes;
+    ci.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+               VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+               VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    return ci;
+}
+
+} // namespace
+
+MemoryRequirements VulkanBackend::memoryRequirements(const TextureDesc& d) {
+    const VkImageCreateInfo ci = placedImageInfo(d, m_swap.GetDepthFormat());
+    VkImage probe = VK_NULL_HANDLE;
+    backend::CheckVkResult(vkCreateImage(m_device.logical(), &ci, nullptr, &probe), "Failed to create probe image");
+    VkMemoryRequirements req;
+    vkGetImageMemoryRequirements(m_device.logical(), probe, &req);
+    vkDestroyImage(m_device.logical(), probe, nullptr);
+    return {req.size, req.alignment, req.memoryTypeBits};
+}
+
+MemoryRequirements VulkanBackend::memoryRequirements(const BufferDesc& d) {
+    const VkBufferCreateInfo ci = placedBufferInfo(d);
+    VkBuffer probe = VK_NULL_HANDLE;
+    backend::CheckVkResult(vkCreateBuffer(m_device.logical(), &ci, nullptr, &probe), "Failed to create probe buffer");
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(m_device.logical(), probe, &req);
+    vkDestroyBuffer(m_device.logical(), probe, nullptr);
+    return {req.size, req.alignment, req.memoryTypeBits};
+}
+
+HeapHandle VulkanBackend::createHeap(const HeapDesc& d) {
+    VkPhysicalDeviceMemoryProperties props;
+    vkGetPhysicalDeviceMemoryProperties(m_device.physical(), &props);
+    uint32_t type = UINT32_MAX;
+    for (uint32_t i = 0; i < props.memoryTypeCount && type == UINT32_MAX; ++i)
+        if ((d.memoryTypeBits & (1u << i)) &&
+            (props.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+            type = i;
+    if (type == UINT32_MAX || d.sizeBytes == 0) {
+        core::util::Logger::error("[VK] no device-local memory type for a {} byte heap", d.sizeBytes);
+        return InvalidHeap;
+    }
+
+    VkMemoryAllocateInfo ai{VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    ai.allocationSize = d.sizeBytes;
+    ai.memoryTypeIndex = type;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    backend::CheckVkResult(vkAllocateMemory(m_device.logical(), &ai, nullptr, &memory), "Failed to allocate heap");
+    const uint32_t id = m_nextHandle++;
+    m_heaps[id] = {memory, d.sizeBytes, type};
+    return {id};
+}
+
+void VulkanBackend::destroyHeap(HeapHandle h) {
+    if (auto it = m_heaps.find(h.id); it != m_heaps.end()) {
+        vkFreeMemory(m_device.logical(), it->second.memory, nullptr);
+        m_heaps.erase(it);
+    }
+}
+
+TextureHandle VulkanBackend::createPlacedTexture(const TextureDesc& d, HeapHandle h, uint64_t offset) {
+    const auto heap = m_heaps.find(h.id);
+    if (heap == m_heaps.end())
+        return InvalidTexture;
+    const VkImageCreateInfo ci = placedImageInfo(d, m_swap.GetDepthFormat());
+    VkImage img = VK_NULL_HANDLE;
+    backend::CheckVkResult(vkCreateImage(m_device.logical(), &ci, nullptr, &img), "Failed to create placed image");
+    VkMemoryRequirements req;
+    vkGetImageMemoryRequirements(m_device.logical(), img, &req);
+    if (!(req.memoryTypeBits & (1u << heap->second.typeIndex)) || offset % req.alignment ||
+        offset + req.size > heap->second.size) {
+        core::util::Logger::error("[VK] image does not fit its heap at offset {}", offset);
+        vkDestroyImage(m_device.logical(), img, nullptr);
+        return InvalidTexture;
+    }
+    backend::CheckVkResult(vkBindImageMemory(m_device.logical(), img, heap->second.memory, offset),
+                           "Failed to bind placed image");
+    const uint32_t id = m_nextHandle++;
+    m_images[id] = img;
+    return {id};
+}
+
+BufferHandle VulkanBackend::createPlacedBuffer(const BufferDesc& d, HeapHandle h, uint64_t offset) {
+    const auto heap = m_heaps.find(h.id);
+    if (heap == m_heaps.end())
+        return InvalidBuffer;
+    const VkBufferCreateInfo ci = placedBufferInfo(d);
+    VkBuffer buf = VK_NULL_HANDLE;
+    backend::CheckVkResult(vkCreateBuffer(m_device.logical(), &ci, nullptr, &buf), "Failed to create placed buffer");
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(m_device.logical(), buf, &req);
+    if (!(req.memoryTypeBits & (1u << heap->second.typeIndex)) || offset % req.alignment ||
+        offset + req.size > heap->second.size) {
+        core::util::Logger::error("[VK] buffer does not fit its heap at offset {}", offset);
+        vkDestroyBuffer(m_device.logical(), buf, nullptr);
+        return InvalidBuffer;
+    }
+    backend::CheckVkResult(vkBindBufferMemory(m_device.logical(), buf, heap->second.memory, offset),
+                           "Failed to bind placed buffer");
+    const uint32_t id = m_nextHandle++;
+    m_buffers[id] = buf;
+    return {id};
+}
+
+/* 1b. queue batches & secondary command buffers -----------------------------*/
+/* One submission: the waits batchWait() registered for cb, plus the
+   swapchain acquire for the frame's first graphics submission */
+void VulkanBackend::submit(VkQueue queue, VkCommandBuffer cb, bool acquire, VkSemaphore signal, VkFence fence) {
+    std::vector<VkSemaphore> waits;
+    if (auto it = m_batchWaits.find(cb); it != m_batchWaits.end()) {
+        waits = std::move(it->second);
+        m_batchWaits.erase(it);
+    }
+    std::vector<VkPipelineStageFlags> stages(waits.size(), VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+    if (acquire) {
+        waits.push_back(m_sync[m_frameIndex].getImageAvailable());
+        stages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+        m_frameBatches[m_frameIndex].acquireWaited = true;
+    }
+
+    VkSubmitInfo si{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    si.waitSemaphoreCount = static_cast<uint32_t>(waits.size());
+    si.pWaitSemaphores = waits.data();
+    si.pWaitDstStageMask = stages.data();
+    si.commandBufferCount = 1;
+    si.pCommandBuffers = &cb;
+    si.signalSemaphoreCount = signal != VK_NULL_HANDLE ? 1 : 0;
+    si.pSignalSemaphores = &signal;
+    vkQueueSubmit(queue, 1, &si, fence);
+}
+
+CmdHandle VulkanBackend::beginBatch(QueueType queue) {
+    FrameBatches& fb = m_frameBatches[m_frameIndex];
+    VkCommandBuffer cb = nextBuffer(queue == QueueType::AsyncCompute ? fb.compute : fb.graphics, queueFamily(queue),
+                                    VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    VkCommandBufferBeginInfo bi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(cb, &bi);
+    if (queue == QueueType::Graphics)
+        m_currentCmd = cb; // endFrame() submits the last graphics batch
+    return {cb};
+}
+
+void VulkanBackend::batchWait(CmdHandle h, SyncPoint point) {
+    m_batchWaits[toCmd(h)].push_back(m_frameBatches[m_frameIndex].semaphores.at(point.id));
+}
+
+SyncPoint VulkanBackend::submitBatch(CmdHandle h, QueueType queue, bool signal) {
+    FrameBatches& fb = m_frameBatches[m_frameIndex];
+    VkCommandBuffer cb = toCmd(h);
+    vkEndCommandBuffer(cb);
+
+    SyncPoint point{};
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    if (signal) {
+        if (fb.usedSemaphores == fb.semaphores.size()) {
+            VkSemaphoreCreateInfo ci{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+            fb.semaphores.push_back(VK_NULL_HANDLE);
+            backend::CheckVkResult(vkCreateSemaphore(m_device.logical(), &ci, nullptr, &fb.semaphores.back()),
+                                   "Failed to create batch semaphore");
+        }
+        point.id = static_cast<uint32_t>(fb.usedSemaphores++);
+        semaphore = fb.semaphores[point.id];
+    }
+    const bool graphics = queue == QueueType::Graphics;
+    submit(graphics ? m_device.GetGraphicsQueue() : m_device.GetComputeQueue(), cb, graphics && !fb.acquireWaited,
+           semaphore, VK_NULL_HANDLE);
+    return point;
+}
+
+VulkanBackend::TimestampReadback VulkanBackend::beginTimestamps(uint32_t count, uint64_t tag) {
+    if (!m_device.graphicsTimestamps() || m_timestampPools.empty())
+        return {};
+    TimestampPool& tp = m_timestampPools[m_frameIndex];
+    VkDevice dev = m_device.logical();
+
+    /* no WAIT: the frame's fence has signalled, anything unavailable was never written */
+    TimestampReadback back{tp.tag, {}};
+    if (tp.count > 0) {
+        std::vector<uint64_t> raw(std::size_t{tp.count} * 2); // value, availability
+        vkGetQueryPoolResults(dev, tp.pool, 0, tp.count, raw.size() * sizeof(uint64_t), raw.data(),
+                              2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        const double secondsPerTick = m_device.timestampPeriod() * 1e-9;
+        back.seconds.resize(tp.count);
+        for (uint32_t q = 0; q < tp.count; ++q)
+            back.seconds[q] = raw[2 * q + 1] ? static_cast<double>(raw[2 * q]) * secondsPerTick
+                                             : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (count > tp.capacity) {
+        if (tp.pool)
+            vkDestroyQueryPool(dev, tp.pool, nullptr);
+        VkQueryPoolCreateInfo ci{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+        ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        ci.queryCount = std::max(count, 2 * tp.capacity);
+        backend::CheckVkResult(vkCreateQueryPool(dev, &ci, nullptr, &tp.pool), "Failed to create timestamp pool");
+        tp.capacity = ci.queryCount;
+    }
+    if (count > 0)
+        vkResetQueryPool(dev, tp.pool, 0, count);
+    tp.count = count;
+    tp.tag = tag;
+    return back;
+}
+
+void VulkanBackend::cmdWriteTimestamp(CmdHandle h, QueueType queue, uint32_t query) {
+    const bool supported =
+        queue == QueueType::AsyncCompute ? m_device.computeTimestamps() : m_device.graphicsTimestamps();
+    if (!supported || m_timestampPools.empty())
+        return;
+    const TimestampPool& tp = m_timestampPools[m_frameIndex];
+    if (query < tp.count) // bottom of pipe: when everything recorded before it has finished
+        vkCmdWriteTimestamp(toCmd(h), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, tp.pool, query);
+}
+
+VkCommandBuffer VulkanBackend::nextBuffer(WorkerPool& wp, uint32_t family, VkCommandBufferLevel level) {
+    if (wp.pool == VK_NULL_HANDLE) {
+        VkCommandPoolCreateInfo ci{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        ci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        ci.queueFamilyIndex = family;
+        backend::CheckVkResult(vkCreateCommandPool(m_device.logical(), &ci, nullptr, &wp.pool),
+                               "Failed to create command pool");
+    }
+    if (wp.used == wp.buffers.size()) {
+        VkCommandBufferAllocateInfo ai{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        ai.commandPool = wp.pool;
+        ai.level = level;
+        ai.commandBufferCount = 1;
+        VkCommandBuffer cb = VK_NULL_HANDLE;
+        backend::CheckVkResult(vkAllocateCommandBuffers(m_device.logical(), &ai, &cb),
+                               "Failed to allocate command buffer");
+        wp.buffers.push_back(cb);
+    }
+    return wp.buffers[wp.used++];
+}
+
+void VulkanBackend::prepareFramePools() {
+    const std::size_t threads = core::jobs::JobSystem::workerCount() + 1; // + the thread outside the pool
+    m_workerPools.resize(m_sync.size());
+    auto& pools = m_workerPools[m_frameIndex];
+    pools.resize(std::max(pools.size(), threads)); // pools are created on first use, by their own thread
+
+    m_frameBatches.resize(m_sync.size());
+    m_timestampPools.resize(m_sync.size());
+    FrameBatches& fb = m_frameBatches[m_frameIndex];
+    fb.usedSemaphores = 0;
+    fb.acquireWaited = false;
+    m_batchWaits.clear();
+
+    auto reset = [&](WorkerPool& wp) {
+        if (wp.used == 0)
+            return;
+        vkResetCommandPool(m_device.logical(), wp.pool, 0);
+        wp.used = 0;
+    };
+    for (WorkerPool& wp : pools)
+        reset(wp);
+    reset(fb.graphics);
+    reset(fb.compute);
+}
+
+CmdHandle VulkanBackend::beginSecondary(CmdHandle, bool continueRenderPass) {
+    WorkerPool& wp = m_workerPools[m_frameIndex].at(core::jobs::JobSystem::workerIndex());
+    VkCommandBuffer cb = nextBuffer(wp, m_device.graphicsFamily(), VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
+    VkCommandBufferInheritanceInfo inherit{VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+    VkCommandBufferBeginInfo bi{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (continueRenderPass) {
+        inherit.renderPass = m_activeRenderPass;
+        inherit.subpass = 0;
+        inherit.framebuffer = m_activeFramebuffer;
+        bi.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    }
+    bi.pInheritanceInfo = &inherit;
+    vkBeginCommandBuffer(cb, &bi);
+    return {cb};
+}
+
+void VulkanBackend::endSecondary(CmdHandle h) {
+    vkEndCommandBuffer(toCmd(h));
+}
+
+void VulkanBackend::cmdExecuteSecondaries(CmdHandle primary, std::span<const CmdHandle> secondaries) {
+    std::vector<VkCommandBuffer> cbs;
+    cbs.reserve(secondaries.size());
+    for (CmdHandle h : secondaries)
+        if (h.ptr)
+            cbs.push_back(toCmd(h));
+    if (!cbs.empty())
+        vkCmdExecuteCommands(toCmd(primary), static_cast<uint32_t>(cbs.size()), cbs.data());
+}
+
+VkRenderPass VulkanBackend::renderPassFor(const backend::VulkanPipeline& pipe, const RenderPassOps& ops) {
+    constexpr VkAttachmentLoadOp kLoad[] = {VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_LOAD_OP_CLEAR,
+                                            VK_ATTACHMENT_LOAD_OP_DONT_CARE};
+    constexpr VkAttachmentStoreOp kStore[] = {VK_ATTACHMENT_STORE_OP_STORE, VK_ATTACHMENT_STORE_OP_DONT_CARE};
+    const uint32_t bits = static_cast<uint32_t>(ops.color.load) | static_cast<uint32_t>(ops.color.store) << 2 |
+                          static_cast<uint32_t>(ops.depth.load) << 3 | static_cast<uint32_t>(ops.depth.store) << 5;
+
+    std::lock_guard lock(m_renderPassVariantsMutex);
+    VkRenderPass& variant = m_renderPassVariants[{pipe.GetRenderPass(), bits}];
+    if (!variant)
+        variant = pipe.CreateCompatibleRenderPass(
+            m_device.logical(), kLoad[static_cast<int>(ops.color.load)], kStore[static_cast<int>(ops.color.store)],
+            kLoad[static_cast<int>(ops.depth.load)], kStore[static_cast<int>(ops.depth.store)]);
+    return variant;
+}
+
+void VulkanBackend::cmdBeginRenderPass(CmdHandle h, void* pipeVoid, uint32_t fbIdx, bool secondaryContents,
+                                       const RenderPassOps& ops) {
     auto* pipe = static_cast<backend::VulkanPipeline*>(pipeVoid);
     VkCommandBuffer cmd = toCmd(h);
 
     VkFramebuffer fb = pipe->GetFramebuffers()[fbIdx];
     // VkExtent2D     extent = pipe->GetExtent();
 
-    /* Optional clear values (depth is ignored by our pass anyway) */
+    /* used by whichever attachments the ops clear */
     VkClearValue clears[2]{};
     clears[0].color = {0.f, 0.f, 0.f, 1.f};
     clears[1].depthStencil = {1.f, 0};
 
     VkRenderPassBeginInfo rpbi{VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
-    rpbi.renderPass = pipe->GetRenderPass();
+    rpbi.renderPass = renderPassFor(*pipe, ops);
     rpbi.framebuffer = fb;
     rpbi.renderArea.extent = extent;
     rpbi.clearValueCount = 2;
     rpbi.pClearValues = clears;
 
-    vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
+    m_activeRenderPass = rpbi.renderPass;
+    m_activeFramebuffer = fb;
+    const VkSubpassContents contents =
+        secondaryContents ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+    vkCmdBeginRenderPass(cmd, &rpbi, contents);
 }
 void VulkanBackend::cmdEndRenderPass(CmdHandle h) {
     vkCmdEndRenderPass(toCmd(h));
+    m_activeRenderPass = VK_NULL_HANDLE;
+    m_activeFramebuffer = VK_NULL_HANDLE;
 }
 
 /* 2. pipeline & descriptor binding -----------------------------------------*/
@@ -11,8 +11,12 @@
 #include "backend/include/IRenderBackend.h"
 #include "core/util/Logger.h"
 #include "glm/glm.hpp"
+#include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <unordered_map>
+#include <utility>
 
 namespace gfx {
 
@@ -32,6 +36,13 @@ class VulkanBackend final : public IRenderBackend {
     void destroyTexture(TextureHandle) override;
     void destroyBuffer(BufferHandle) override;
 
+    MemoryRequirements memoryRequirements(const TextureDesc&) override;
+    MemoryRequirements memoryRequirements(const BufferDesc&) override;
+    HeapHandle createHeap(const HeapDesc&) override;
+    void destroyHeap(HeapHandle) override;
+    TextureHandle createPlacedTexture(const TextureDesc&, HeapHandle, uint64_t offset) override;
+    BufferHandle createPlacedBuffer(const BufferDesc&, HeapHandle, uint64_t offset) override;
+
     VkCommandBuffer currentCommandBuffer() const noexcept {
         return m_currentCmd;
     }
@@ -43,8 +54,23 @@ class VulkanBackend final : public IRenderBackend {
         return m_sync;
     }
 
+    bool hasAsyncCompute() const override {
+        return m_device.hasAsyncCompute();
+    }
+    CmdHandle beginBatch(QueueType) override;
+    void batchWait(CmdHandle, SyncPoint) override;
+    SyncPoint submitBatch(CmdHandle, QueueType, bool signal) override;
+
+    TimestampReadback beginTimestamps(uint32_t count, uint64_t tag) override;
+    void cmdWriteTimestamp(CmdHandle, QueueType, uint32_t query) override;
+
+    CmdHandle beginSecondary(CmdHandle primary, bool continueRenderPass) override;
+    void endSecondary(CmdHandle) override;
+    void cmdExecuteSecondaries(CmdHandle primary, std::span<const CmdHandle> secondaries) override;
+
     /* --- thin immediate helpers (implementation in .cpp) --- */
-    void cmdBeginRenderPass(gfx::CmdHandle, void* pipeVoid, uint32_t fbIdx);
+    void cmdBeginRenderPass(gfx::CmdHandle, void* pipeVoid, uint32_t fbIdx, bool secondaryContents,
+                            const RenderPassOps& ops) override;
     void cmdEndRenderPass(gfx::CmdHandle);
     void cmdBindPipeline(gfx::CmdHandle, void* pipePtr);
     void cmdBindDescriptorSets(gfx::CmdHandle, void* layoutPtr, void* set0Ptr, void* set1Ptr);
@@ -67,6 +93,8 @@ class VulkanBackend final : public IRenderBackend {
         return m_device.GetGraphicsQueue();
     }
 
+    void cmdBarriers(gfx::CmdHandle, std::span<const ResourceBarrier> barriers) override;
+
     void transition(gfx::CmdHandle cmd, gfx::TextureHandle tex, int oldLayout, int newLayout, int srcAccess,
                     int dstAccess, int srcStage, int dstStage) override;
 
@@ -75,6 +103,12 @@ class VulkanBackend final : public IRenderBackend {
     /* simple maps; replace with pool later */
     std::unordered_map<uint32_t, VkImage> m_images;
     std::unordered_map<uint32_t, VkBuffer> m_buffers;
+    struct Heap {
+        VkDeviceMemory memory;
+        VkDeviceSize size;
+        uint32_t typeIndex;
+    };
+    std::unordered_map<uint32_t, Heap> m_heaps;
 
     VulkanAllocator m_allocator{};
     VkCommandPool m_cmdPool{};
@@ -99,6 +133,47 @@ class VulkanBackend final : public IRenderBackend {
     uint32_t m_currentImg{0};
     std::vector<VkImageLayout> m_imgLayout; // init after swapchain create
 
+    /* secondaries: one pool per frame in flight × recording thread, so
+       workers never share a pool and a frame's pools reset together */
+    struct WorkerPool {
+        VkCommandPool pool{VK_NULL_HANDLE};
+        std::vector<VkCommandBuffer> buffers;
+        std::size_t used{0};
+    };
+    std::vector<std::vector<WorkerPool>> m_workerPools; // [frame in flight][JobSystem::workerIndex()]
+    VkRenderPass m_activeRenderPass{VK_NULL_HANDLE};    // inherited by continueRenderPass secondaries
+    VkFramebuffer m_activeFramebuffer{VK_NULL_HANDLE};
+
+    /* pipeline render pass × load/store ops → compatible variant, built on first use */
+    std::map<std::pair<VkRenderPass, uint32_t>, VkRenderPass> m_renderPassVariants;
+    std::mutex m_renderPassVariantsMutex; // passes begin on JobSystem workers when recording in parallel
+    VkRenderPass renderPassFor(const backend::VulkanPipeline&, const RenderPassOps&);
+    void prepareFramePools();
+    VkCommandBuffer nextBuffer(WorkerPool&, uint32_t family, VkCommandBufferLevel);
+
+    /* queue batches beyond the frame's own cmd; a SyncPoint indexes semaphores */
+    struct FrameBatches {
+        WorkerPool graphics, compute;
+        std::vector<VkSemaphore> semaphores;
+        std::size_t usedSemaphores{0};
+        bool acquireWaited{false}; // imageAvailable went with an earlier graphics submission
+    };
+    std::vector<FrameBatches> m_frameBatches; // per frame in flight
+    std::unordered_map<VkCommandBuffer, std::vector<VkSemaphore>> m_batchWaits;
+    uint32_t queueFamily(QueueType q) const {
+        return q == QueueType::AsyncCompute ? m_device.computeFamily() : m_device.graphicsFamily();
+    }
+    void submit(VkQueue, VkCommandBuffer, bool acquire, VkSemaphore signal, VkFence);
+
+    /* pass timing: a query pool per frame in flight, reset from the host */
+    struct TimestampPool {
+        VkQueryPool pool{VK_NULL_HANDLE};
+        uint32_t capacity{0};
+        uint32_t count{0}; // queries cleared for the frame recording into it
+        uint64_t tag{0};
+    };
+    std::vector<TimestampPool> m_timestampPools; // per frame in flight
+
     VkExtent2D extent;
 };
 
@@ -1,6 +1,7 @@
 #include "VulkanBuffer.h"
 #include "VulkanUtils.h"
-#include <iostream>
+#include "core/util/Logger.h"
+#include <cstdlib>
 
 namespace backend {
 
@@ -108,7 +109,7 @@ uint32_t VulkanBuffer::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags
         }
     }
 
-    std::cerr << "[VulkanBuffer] Failed to find suitable memory type.\n";
+    core::util::Logger::error("[VulkanBuffer] Failed to find suitable memory type.");
     std::exit(EXIT_FAILURE);
 }
 
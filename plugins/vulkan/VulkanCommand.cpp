@@ -1,6 +1,6 @@
 #include "VulkanCommand.h"
 #include "VulkanUtils.h"
-#include <iostream>
+#include "core/util/Logger.h"
 
 namespace backend {
 
@@ -22,7 +22,7 @@ void VulkanCommand::Create(VkDevice device, uint32_t queueFamilyIndex, uint32_t
     CheckVkResult(vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()),
                   "Failed to allocate command buffers");
 
-    std::cout << "[VulkanCommand] Allocated " << count << " command buffers.\n";
+    core::util::Logger::info("[VulkanCommand] Allocated {} command buffers.", count);
 }
 
 void VulkanCommand::Destroy(VkDevice device) {
@@ -36,7 +36,7 @@ void VulkanCommand::Destroy(VkDevice device) {
     commandPool = VK_NULL_HANDLE;
     commandBuffers.clear();
 
-    std::cout << "[VulkanCommand] Command pool and buffers destroyed.\n";
+    core::util::Logger::info("[VulkanCommand] Command pool and buffers destroyed.");
 }
 
 VkCommandBuffer VulkanCommand::Get(uint32_t index) const {
@@ -43,13 +43,13 @@ void VulkanDescriptor::Create(VkDevice device) {
     // Create descriptor pool
     std::array<VkDescriptorPoolSize, 2> poolSizes{};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSizes[0].descriptorCount = 1;
+    poolSizes[0].descriptorCount = 2; // set 0 and its spare
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     poolSizes[1].descriptorCount = 1;
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.maxSets = 2;
+    poolInfo.maxSets = 3;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
 
@@ -57,12 +57,13 @@ void VulkanDescriptor::Create(VkDevice device) {
 }
 
 void VulkanDescriptor::Allocate(VkDevice device) {
+    const VkDescriptorSetLayout layouts0[2] = {layout0, layout0};
     VkDescriptorSetAllocateInfo allocInfo0{};
     allocInfo0.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
     allocInfo0.descriptorPool = pool;
-    allocInfo0.descriptorSetCount = 1;
-    allocInfo0.pSetLayouts = &layout0;
-    CheckVkResult(vkAllocateDescriptorSets(device, &allocInfo0, &set0), "Failed to allocate descriptor set 0");
+    allocInfo0.descriptorSetCount = 2;
+    allocInfo0.pSetLayouts = layouts0;
+    CheckVkResult(vkAllocateDescriptorSets(device, &allocInfo0, set0), "Failed to allocate descriptor set 0");
 
     VkDescriptorSetAllocateInfo allocInfo1{};
     allocInfo1.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -73,6 +74,14 @@ void VulkanDescriptor::Allocate(VkDevice device) {
 }
 
 void VulkanDescriptor::Update(VkDevice device, VkImageView imageView, VkSampler sampler) {
+    WriteImage(device, set0[current], imageView, sampler);
+}
+
+void VulkanDescriptor::UpdateSpare(VkDevice device, VkImageView imageView, VkSampler sampler) {
+    WriteImage(device, set0[current ^ 1], imageView, sampler);
+}
+
+void VulkanDescriptor::WriteImage(VkDevice device, VkDescriptorSet set, VkImageView imageView, VkSampler sampler) {
     VkDescriptorImageInfo imageInfo{};
     imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     imageInfo.imageView = imageView;
@@ -80,7 +89,7 @@ void VulkanDescriptor::Update(VkDevice device, VkImageView imageView, VkSampler
 
     VkWriteDescriptorSet write{};
     write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    write.dstSet = set0;
+    write.dstSet = set;
     write.dstBinding = 0;
     write.descriptorCount = 1;
     write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
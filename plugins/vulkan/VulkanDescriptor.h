@@ -7,6 +7,14 @@ class VulkanDescriptor {
     void Create(VkDevice device);
     void Allocate(VkDevice device);
     void Update(VkDevice device, VkImageView imageView, VkSampler sampler);
+    /* Set 0 (the texture) is double-buffered for swaps while frames are in
+       flight: write the spare, then Flip() so GetSet0() returns it.  The
+       set flipped away from stays bound by recorded frames – don't write it
+       again before they finished */
+    void UpdateSpare(VkDevice device, VkImageView imageView, VkSampler sampler);
+    void Flip() {
+        current ^= 1;
+    }
     void Update(VkDevice device, const VkDescriptorBufferInfo& bufferInfo);
 
     void Destroy(VkDevice device);
@@ -18,17 +26,20 @@ class VulkanDescriptor {
         return layout1;
     }
     VkDescriptorSet GetSet0() const {
-        return set0;
+        return set0[current];
     }
     VkDescriptorSet GetSet1() const {
         return set1;
     }
 
   private:
+    void WriteImage(VkDevice device, VkDescriptorSet set, VkImageView imageView, VkSampler sampler);
+
     VkDescriptorSetLayout layout0 = VK_NULL_HANDLE;
     VkDescriptorSetLayout layout1 = VK_NULL_HANDLE;
     VkDescriptorPool pool = VK_NULL_HANDLE;
-    VkDescriptorSet set0 = VK_NULL_HANDLE;
+    VkDescriptorSet set0[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    uint32_t current = 0; // into set0
     VkDescriptorSet set1 = VK_NULL_HANDLE;
 };
 } // namespace backend
@@ -1,7 +1,8 @@
 #include "VulkanDevice.h"
 #include "VulkanUtils.h"
+#include "core/util/Logger.h"
+#include <cstdlib>
 #include <cstring> // for strcmp
-#include <iostream>
 #include <set>
 #include <vector>
 
@@ -10,19 +11,19 @@ const std::vector<const char*> requiredExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_
 namespace backend {
 
 void VulkanDevice::Create(VkInstance instance, VkSurfaceKHR surface) {
-    std::cout << "[VulkanDevice] Enumerating physical devices...\n";
+    core::util::Logger::info("[VulkanDevice] Enumerating physical devices...");
 
     uint32_t deviceCount = 0;
     vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
     if (deviceCount == 0) {
-        std::cerr << "[VulkanDevice] No Vulkan-compatible GPUs found!\n";
+        core::util::Logger::error("[VulkanDevice] No Vulkan-compatible GPUs found!");
         std::exit(EXIT_FAILURE);
     }
 
     std::vector<VkPhysicalDevice> devices(deviceCount);
     vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
-    std::cout << "[VulkanDevice] Found " << deviceCount << " GPU(s)\n";
+    core::util::Logger::info("[VulkanDevice] Found {} GPU(s)", deviceCount);
 
     // Pick first discrete GPU (fallback: first available)
     for (const auto& dev : devices) {
@@ -31,7 +32,7 @@ void VulkanDevice::Create(VkInstance instance, VkSurfaceKHR surface) {
 
         if (props.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
             m_physicalDevice = dev;
-            std::cout << "[VulkanDevice] Selected discrete GPU: " << props.deviceName << "\n";
+            core::util::Logger::info("[VulkanDevice] Selected discrete GPU: {}", props.deviceName);
             break;
         }
     }
@@ -40,7 +41,7 @@ void VulkanDevice::Create(VkInstance instance, VkSurfaceKHR surface) {
         m_physicalDevice = devices[0];
         VkPhysicalDeviceProperties props;
         vkGetPhysicalDeviceProperties(m_physicalDevice, &props);
-        std::cout << "[VulkanDevice] Fallback GPU selected: " << props.deviceName << "\n";
+        core::util::Logger::info("[VulkanDevice] Fallback GPU selected: {}", props.deviceName);
     }
 
     // Find queue family index with graphics support
@@ -58,25 +59,45 @@ void VulkanDevice::Create(VkInstance instance, VkSurfaceKHR surface) {
     }
 
     if (graphicsQueueFamily == -1) {
-        std::cerr << "[VulkanDevice] Failed to find graphics queue family!\n";
+        core::util::Logger::error("[VulkanDevice] Failed to find graphics queue family!");
         std::exit(EXIT_FAILURE);
     }
 
-    // Device Queue
+    // Dedicated compute (no graphics) and transfer (neither) families run alongside graphics
+    auto findDedicated = [&](VkQueueFlags want, VkQueueFlags avoid) {
+        for (uint32_t i = 0; i < queueFamilyCount; ++i)
+            if ((queueFamilies[i].queueFlags & want) == want && !(queueFamilies[i].queueFlags & avoid))
+                return i;
+        return graphicsQueueFamily;
+    };
+    const uint32_t computeQueueFamily = findDedicated(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+    uint32_t transferQueueFamily = findDedicated(VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    if (transferQueueFamily == graphicsQueueFamily)
+        transferQueueFamily = computeQueueFamily; // compute queues can always transfer
+
+    // Device Queues, one per distinct family
     float queuePriority = 1.0f;
-    VkDeviceQueueCreateInfo queueInfo{};
-    queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueInfo.queueFamilyIndex = graphicsQueueFamily;
-    queueInfo.queueCount = 1;
-    queueInfo.pQueuePriorities = &queuePriority;
+    std::vector<VkDeviceQueueCreateInfo> queueInfos;
+    for (uint32_t family : std::set<uint32_t>{graphicsQueueFamily, computeQueueFamily, transferQueueFamily}) {
+        VkDeviceQueueCreateInfo queueInfo{};
+        queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueInfo.queueFamilyIndex = family;
+        queueInfo.queueCount = 1;
+        queueInfo.pQueuePriorities = &queuePriority;
+        queueInfos.push_back(queueInfo);
+    }
 
-    // Device Features
+    // Device Features (hostQueryReset is core and required since 1.2 – pass timing resets its queries from the CPU)
     VkPhysicalDeviceFeatures deviceFeatures{};
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.hostQueryReset = VK_TRUE;
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    createInfo.queueCreateInfoCount = 1;
-    createInfo.pQueueCreateInfos = &queueInfo;
+    createInfo.pNext = &features12;
+    createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
+    createInfo.pQueueCreateInfos = queueInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
     createInfo.enabledExtensionCount = static_cast<uint32_t>(requiredExtensions.size());
     createInfo.ppEnabledExtensionNames = requiredExtensions.data();
@@ -84,10 +105,22 @@ void VulkanDevice::Create(VkInstance instance, VkSurfaceKHR surface) {
     VkResult result = vkCreateDevice(m_physicalDevice, &createInfo, nullptr, &m_device);
     m_graphicsFamily = graphicsQueueFamily;
     volkLoadDevice(m_device);
-    vkGetDeviceQueue(m_device, graphicsQueueFamily, 0, &m_graphicsQueue);
     backend::CheckVkResult(result, "Failed to create logical m_device");
-
-    std::cout << "[VulkanDevice] Logical m_device created.\n";
+    vkGetDeviceQueue(m_device, graphicsQueueFamily, 0, &m_graphicsQueue);
+    m_computeFamily = computeQueueFamily;
+    vkGetDeviceQueue(m_device, computeQueueFamily, 0, &m_computeQueue);
+    m_transferFamily = transferQueueFamily;
+    vkGetDeviceQueue(m_device, transferQueueFamily, 0, &m_transferQueue);
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(m_physicalDevice, &props);
+    m_timestampPeriod = props.limits.timestampPeriod;
+    m_graphicsTimestamps = queueFamilies[graphicsQueueFamily].timestampValidBits != 0;
+    m_computeTimestamps = queueFamilies[computeQueueFamily].timestampValidBits != 0;
+
+    core::util::Logger::info("[VulkanDevice] Logical m_device created (queue families: graphics {}, compute {}, "
+                             "transfer {}).",
+                             graphicsQueueFamily, computeQueueFamily, transferQueueFamily);
 }
 
 void VulkanDevice::Destroy() {
@@ -26,6 +26,34 @@ class VulkanDevice {
     }
     // VkQueue  graphicsQueue()    const noexcept { return m_graphicsQueue; }
 
+    /* Dedicated queues when the GPU has such families, the graphics queue otherwise */
+    VkQueue GetComputeQueue() const {
+        return m_computeQueue;
+    }
+    uint32_t computeFamily() const noexcept {
+        return m_computeFamily;
+    }
+    bool hasAsyncCompute() const noexcept {
+        return m_computeFamily != m_graphicsFamily;
+    }
+    VkQueue GetTransferQueue() const {
+        return m_transferQueue;
+    }
+    uint32_t transferFamily() const noexcept {
+        return m_transferFamily;
+    }
+
+    /* Timestamp queries: nanoseconds per tick, and which queues can write them */
+    float timestampPeriod() const noexcept {
+        return m_timestampPeriod;
+    }
+    bool graphicsTimestamps() const noexcept {
+        return m_graphicsTimestamps;
+    }
+    bool computeTimestamps() const noexcept {
+        return m_computeTimestamps;
+    }
+
   private:
     VkInstance m_instance;
     VkSurfaceKHR m_surface;
@@ -34,5 +62,12 @@ class VulkanDevice {
     // VkQueue graphicsQueue = VK_NULL_HANDLE;
     uint32_t m_graphicsFamily = 0;
     VkQueue m_graphicsQueue = VK_NULL_HANDLE;
+    uint32_t m_computeFamily = 0;
+    VkQueue m_computeQueue = VK_NULL_HANDLE;
+    uint32_t m_transferFamily = 0;
+    VkQueue m_transferQueue = VK_NULL_HANDLE;
+    float m_timestampPeriod = 1.f;
+    bool m_graphicsTimestamps = false;
+    bool m_computeTimestamps = false;
 };
 } // namespace backend
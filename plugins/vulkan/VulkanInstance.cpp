@@ -5,8 +5,8 @@
 #include "VulkanUtils.h"
 #include "core/util/Logger.h"
 #include <GLFW/glfw3.h>
+#include <cstdlib>
 #include <cstring>
-#include <iostream>
 #include <vector>
 
 const std::vector<const char*> validationLayers = {"VK_LAYER_KHRONOS_validation"};
@@ -15,16 +15,16 @@ const std::vector<const char*> validationLayers = {"VK_LAYER_KHRONOS_validation"
 namespace backend {
 void backend::VulkanInstance::Create(bool enableValidation) {
 
-    std::cout << "[VulkanInstance] Creating Vulkan instance...\n";
+    core::util::Logger::info("[VulkanInstance] Creating Vulkan instance...");
 
     // ✅ Initialize Volk loader BEFORE any Vulkan function is called
     if (volkInitialize() != VK_SUCCESS) {
-        std::cerr << "[VulkanInstance] volkInitialize() failed!\n";
+        core::util::Logger::error("[VulkanInstance] volkInitialize() failed!");
         std::exit(EXIT_FAILURE);
     }
 
     if (enableValidation && !CheckValidationSupport()) {
-        std::cerr << "[VulkanInstance] Validation layers requested but not available!\n";
+        core::util::Logger::error("[VulkanInstance] Validation layers requested but not available!");
         std::exit(EXIT_FAILURE);
     }
 
@@ -44,7 +44,6 @@ void backend::VulkanInstance::Create(bool enableValidation) {
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data();
 
-    // std::cout << "[VulkanInstance] Enabled extensions count: " << createInfo.enabledExtensionCount << "\n";
     if (enableValidation) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
         createInfo.ppEnabledLayerNames = validationLayers.data();
@@ -54,10 +53,10 @@ void backend::VulkanInstance::Create(bool enableValidation) {
 
     VkResult result = vkCreateInstance(&createInfo, nullptr, &instance);
     if (result != VK_SUCCESS) {
-        std::cerr << "[VulkanInstance] vkCreateInstance FAILED! Code: " << result << "\n";
+        core::util::Logger::error("[VulkanInstance] vkCreateInstance FAILED! Code: {}", static_cast<int>(result));
         std::exit(EXIT_FAILURE);
     } else {
-        std::cout << "[VulkanInstance] vkCreateInstance succeeded.\n";
+        core::util::Logger::info("[VulkanInstance] vkCreateInstance succeeded.");
     }
     backend::CheckVkResult(result, "Failed to create Vulkan instance");
 
@@ -66,7 +65,7 @@ void backend::VulkanInstance::Create(bool enableValidation) {
     if (enableValidation)
         SetupDebugMessenger();
 
-    std::cout << "[VulkanInstance] Vulkan instance created.\n";
+    core::util::Logger::info("[VulkanInstance] Vulkan instance created.");
 }
 
 void backend::VulkanInstance::Destroy() {
@@ -84,7 +83,7 @@ void backend::VulkanInstance::Destroy() {
         instance = VK_NULL_HANDLE;
     }
 
-    std::cout << "[VulkanInstance] Destroyed Vulkan instance.\n";
+    core::util::Logger::info("[VulkanInstance] Destroyed Vulkan instance.");
 }
 
 void backend::VulkanInstance::SetupDebugMessenger() {
@@ -100,7 +99,7 @@ void backend::VulkanInstance::SetupDebugMessenger() {
 
     createInfo.pfnUserCallback = [](VkDebugUtilsMessageSeverityFlagBitsEXT, VkDebugUtilsMessageTypeFlagsEXT,
                                     const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void*) -> VkBool32 {
-        std::cerr << "[Validation] " << pCallbackData->pMessage << "\n";
+        core::util::Logger::warn("[Validation] {}", pCallbackData->pMessage);
         return VK_FALSE;
     };
 
@@ -109,9 +108,9 @@ void backend::VulkanInstance::SetupDebugMessenger() {
 
     if (createDebugUtilsMessengerEXT &&
         createDebugUtilsMessengerEXT(instance, &createInfo, nullptr, &debugMessenger) == VK_SUCCESS) {
-        std::cout << "[VulkanInstance] Debug messenger created.\n";
+        core::util::Logger::info("[VulkanInstance] Debug messenger created.");
     } else {
-        std::cerr << "[VulkanInstance] Failed to set up debug messenger.\n";
+        core::util::Logger::warn("[VulkanInstance] Failed to set up debug messenger.");
     }
 }
 
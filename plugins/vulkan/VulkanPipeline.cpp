@@ -1,26 +1,44 @@
 #include "VulkanPipeline.h"
 #include "Vertex.h"
 #include "VulkanUtils.h"
-#include <iostream>
+#include "core/util/Logger.h"
+#include <stdexcept>
+#include <string>
 
 namespace backend {
 
-void VulkanPipeline::CreateRenderPass(VkDevice device, VkFormat swapchainFormat, VkFormat depthFormat) {
+void VulkanPipeline::CreateRenderPass(VkDevice device, VkFormat swapchainFormat, VkFormat depthFmt) {
+    colorFormat = swapchainFormat;
+    depthFormat = depthFmt;
+    renderPass = BuildRenderPass(device, VK_ATTACHMENT_LOAD_OP_LOAD, VK_ATTACHMENT_STORE_OP_STORE, // keep content
+                                 VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_STORE_OP_DONT_CARE);
+    core::util::Logger::info("[VulkanPipeline] Render pass created.");
+}
+
+VkRenderPass VulkanPipeline::CreateCompatibleRenderPass(VkDevice device, VkAttachmentLoadOp colorLoad,
+                                                        VkAttachmentStoreOp colorStore, VkAttachmentLoadOp depthLoad,
+                                                        VkAttachmentStoreOp depthStore) const {
+    return BuildRenderPass(device, colorLoad, colorStore, depthLoad, depthStore);
+}
+
+VkRenderPass VulkanPipeline::BuildRenderPass(VkDevice device, VkAttachmentLoadOp colorLoad,
+                                             VkAttachmentStoreOp colorStore, VkAttachmentLoadOp depthLoad,
+                                             VkAttachmentStoreOp depthStore) const {
     VkAttachmentDescription colorAttachment{};
-    colorAttachment.format = swapchainFormat;
+    colorAttachment.format = colorFormat;
     colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD; // Load existing content
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.loadOp = colorLoad;
+    colorAttachment.storeOp = colorStore;
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; // RenderGraph transitions to present
 
     VkAttachmentDescription depthAttachment{};
     depthAttachment.format = depthFormat;
     depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.loadOp = depthLoad;
+    depthAttachment.storeOp = depthStore;
     depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -49,8 +67,9 @@ void VulkanPipeline::CreateRenderPass(VkDevice device, VkFormat swapchainFormat,
     info.subpassCount = 1;
     info.pSubpasses = &subpass;
 
-    CheckVkResult(vkCreateRenderPass(device, &info, nullptr, &renderPass), "Failed to create render pass");
-    std::cout << "[VulkanPipeline] Render pass created.\n";
+    VkRenderPass pass = VK_NULL_HANDLE;
+    CheckVkResult(vkCreateRenderPass(device, &info, nullptr, &pass), "Failed to create render pass");
+    return pass;
 }
 
 void VulkanPipeline::CreateFramebuffers(VkDevice device, VkExtent2D extent,
@@ -76,7 +95,7 @@ void VulkanPipeline::CreateFramebuffers(VkDevice device, VkExtent2D extent,
         framebuffers.push_back(framebuffer);
     }
 
-    std::cout << "[VulkanPipeline] " << framebuffers.size() << " framebuffers created.\n";
+    core::util::Logger::info("[VulkanPipeline] {} framebuffers created.", framebuffers.size());
 }
 
 void VulkanPipeline::Destroy(VkDevice device) {
@@ -100,12 +119,25 @@ void VulkanPipeline::Destroy(VkDevice device) {
         layout = VK_NULL_HANDLE;
     }
 
-    std::cout << "[VulkanPipeline] Render pass and framebuffers destroyed.\n";
+    core::util::Logger::info("[VulkanPipeline] Render pass and framebuffers destroyed.");
 }
 
 void VulkanPipeline::CreateGraphicsPipeline(VkDevice device, VkExtent2D extent, VkRenderPass renderPass,
                                             VkShaderModule vertShader, VkShaderModule fragShader,
-                                            VkDescriptorSetLayout layout0, VkDescriptorSetLayout layout1) {
+                                            VkDescriptorSetLayout layout0, VkDescriptorSetLayout layout1,
+                                            const VertexLayout& vertexLayout) {
+    VkResult result = BuildGraphicsPipeline(device, extent, renderPass, vertShader, fragShader, layout0, layout1,
+                                            vertexLayout, pipeline, layout);
+    CheckVkResult(result, "Failed to create graphics pipeline");
+
+    core::util::Logger::info("[VulkanPipeline] Graphics pipeline created.");
+}
+
+VkResult VulkanPipeline::BuildGraphicsPipeline(VkDevice device, VkExtent2D extent, VkRenderPass renderPass,
+                                               VkShaderModule vertShader, VkShaderModule fragShader,
+                                               VkDescriptorSetLayout layout0, VkDescriptorSetLayout layout1,
+                                               const VertexLayout& vertexLayout, VkPipeline& outPipeline,
+                                               VkPipelineLayout& outLayout) const {
     // Shader stages
     VkPipelineShaderStageCreateInfo vertStage{};
     vertStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -122,15 +154,12 @@ void VulkanPipeline::CreateGraphicsPipeline(VkDevice device, VkExtent2D extent,
     VkPipelineShaderStageCreateInfo stages[] = {vertStage, fragStage};
 
     // Vertex input state
-    auto bindingDescription = Vertex::GetBindingDescription();
-    auto attributeDescriptions = Vertex::GetAttributeDescriptions();
-
     VkPipelineVertexInputStateCreateInfo vertexInput{};
     vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     vertexInput.vertexBindingDescriptionCount = 1;
-    vertexInput.pVertexBindingDescriptions = &bindingDescription;
-    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInput.pVertexAttributeDescriptions = attributeDescriptions.data();
+    vertexInput.pVertexBindingDescriptions = &vertexLayout.binding;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexLayout.attributes.size());
+    vertexInput.pVertexAttributeDescriptions = vertexLayout.attributes.data();
 
     VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
     inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -195,7 +224,10 @@ void VulkanPipeline::CreateGraphicsPipeline(VkDevice device, VkExtent2D extent,
     layoutInfo.pushConstantRangeCount = 1;
     layoutInfo.pPushConstantRanges = &pushRange;
 
-    CheckVkResult(vkCreatePipelineLayout(device, &layoutInfo, nullptr, &layout), "Failed to create pipeline layout");
+    VkPipelineLayout newLayout = VK_NULL_HANDLE;
+    VkResult result = vkCreatePipelineLayout(device, &layoutInfo, nullptr, &newLayout);
+    if (result != VK_SUCCESS)
+        return result;
 
     VkGraphicsPipelineCreateInfo pipelineInfo{};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
@@ -208,14 +240,38 @@ void VulkanPipeline::CreateGraphicsPipeline(VkDevice device, VkExtent2D extent,
     pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.pMultisampleState = &multisample;
     pipelineInfo.pColorBlendState = &colorBlend;
-    pipelineInfo.layout = layout;
+    pipelineInfo.layout = newLayout;
     pipelineInfo.renderPass = renderPass;
     pipelineInfo.subpass = 0;
 
-    VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
-    CheckVkResult(result, "Failed to create graphics pipeline");
+    VkPipeline newPipeline = VK_NULL_HANDLE;
+    result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &newPipeline);
+    if (result != VK_SUCCESS) {
+        vkDestroyPipelineLayout(device, newLayout, nullptr);
+        return result;
+    }
+    outPipeline = newPipeline;
+    outLayout = newLayout;
+    return VK_SUCCESS;
+}
 
-    std::cout << "[VulkanPipeline] Graphics pipeline created.\n";
+VulkanPipeline::Retired VulkanPipeline::RebuildGraphicsPipeline(VkDevice device, VkExtent2D extent,
+                                                                VkShaderModule vertShader, VkShaderModule fragShader,
+                                                                VkDescriptorSetLayout layout0,
+                                                                VkDescriptorSetLayout layout1,
+                                                                const VertexLayout& vertexLayout) {
+    VkPipeline newPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout newLayout = VK_NULL_HANDLE;
+    const VkResult result = BuildGraphicsPipeline(device, extent, renderPass, vertShader, fragShader, layout0, layout1,
+                                                  vertexLayout, newPipeline, newLayout);
+    if (result != VK_SUCCESS)
+        throw std::runtime_error("Failed to rebuild graphics pipeline (code: " +
+                                 std::to_string(static_cast<int>(result)) + ")");
+
+    const Retired old{pipeline, layout};
+    pipeline = newPipeline;
+    layout = newLayout;
+    return old;
 }
 
 } // namespace backend
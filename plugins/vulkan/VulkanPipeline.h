@@ -1,4 +1,5 @@
 #pragma once
+#include "Vertex.h"
 #include "VulkanDescriptor.h"
 #include <vector>
 #include <volk.h>
@@ -14,13 +15,29 @@ class VulkanPipeline {
     VkRenderPass GetRenderPass() const {
         return renderPass;
     }
+    /* Same attachments and subpass as GetRenderPass() but other load/store
+       ops – compatible with its framebuffers and pipelines.  Caller owns it. */
+    VkRenderPass CreateCompatibleRenderPass(VkDevice device, VkAttachmentLoadOp colorLoad,
+                                            VkAttachmentStoreOp colorStore, VkAttachmentLoadOp depthLoad,
+                                            VkAttachmentStoreOp depthStore) const;
     const std::vector<VkFramebuffer>& GetFramebuffers() const {
         return framebuffers;
     }
 
     void CreateGraphicsPipeline(VkDevice device, VkExtent2D extent, VkRenderPass renderPass, VkShaderModule vertShader,
-                                VkShaderModule fragShader, VkDescriptorSetLayout layout0,
-                                VkDescriptorSetLayout layout1);
+                                VkShaderModule fragShader, VkDescriptorSetLayout layout0, VkDescriptorSetLayout layout1,
+                                const VertexLayout& vertexLayout = VertexLayout::Of<Vertex>());
+    /* Swaps in a pipeline built from new shaders, same render pass and
+       layouts.  The old pipeline + layout are handed back, not destroyed:
+       frames still in flight may be using them.  Throws std::runtime_error
+       if the new one can't be created; the current pipeline stays bound. */
+    struct Retired {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+    };
+    Retired RebuildGraphicsPipeline(VkDevice device, VkExtent2D extent, VkShaderModule vertShader,
+                                    VkShaderModule fragShader, VkDescriptorSetLayout layout0,
+                                    VkDescriptorSetLayout layout1, const VertexLayout& vertexLayout);
     VkPipeline GetPipeline() const {
         return pipeline;
     }
@@ -29,7 +46,17 @@ class VulkanPipeline {
     }
 
   private:
+    VkRenderPass BuildRenderPass(VkDevice device, VkAttachmentLoadOp colorLoad, VkAttachmentStoreOp colorStore,
+                                 VkAttachmentLoadOp depthLoad, VkAttachmentStoreOp depthStore) const;
+    /* Creates layout + pipeline into the out-params only if both succeed */
+    VkResult BuildGraphicsPipeline(VkDevice device, VkExtent2D extent, VkRenderPass renderPass,
+                                   VkShaderModule vertShader, VkShaderModule fragShader, VkDescriptorSetLayout layout0,
+                                   VkDescriptorSetLayout layout1, const VertexLayout& vertexLayout,
+                                   VkPipeline& outPipeline, VkPipelineLayout& outLayout) const;
+
     VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
     std::vector<VkFramebuffer> framebuffers;
     VkPipeline pipeline = VK_NULL_HANDLE;
     VkPipelineLayout layout = VK_NULL_HANDLE;
@@ -1,33 +1,49 @@
 #include "VulkanShader.h"
 #include "VulkanUtils.h"
-#include <fstream>
-#include <iostream>
+#include "core/util/FileSystem.h"
+#include "core/util/Logger.h"
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <vector>
 
 namespace backend {
 
 bool VulkanShader::LoadFromFile(VkDevice device, const std::string& path) {
-    std::ifstream file(path, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        std::cerr << "[VulkanShader] Failed to open shader file: " << path << "\n";
+    core::util::MappedFile file;
+    try {
+        file = core::util::FileSystem::map(path);
+    } catch (const std::exception& e) {
+        core::util::Logger::error("[VulkanShader] Failed to open shader file: {}", e.what());
         return false;
     }
+    return LoadFromMemory(device, file.bytes(), path);
+}
 
-    size_t fileSize = static_cast<size_t>(file.tellg());
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
+bool VulkanShader::LoadFromMemory(VkDevice device, std::span<const std::byte> spirv, std::string_view name) {
+    if (spirv.empty() || spirv.size() % sizeof(uint32_t) != 0) {
+        core::util::Logger::error("[VulkanShader] Not a SPIR-V binary: {}", name);
+        return false;
+    }
+
+    // mappings and heap buffers are suitably aligned already; copy only if a caller hands us an odd offset
+    std::vector<uint32_t> aligned;
+    const auto* code = reinterpret_cast<const uint32_t*>(spirv.data());
+    if (reinterpret_cast<std::uintptr_t>(code) % alignof(uint32_t) != 0) {
+        aligned.resize(spirv.size() / sizeof(uint32_t));
+        std::memcpy(aligned.data(), spirv.data(), spirv.size());
+        code = aligned.data();
+    }
 
     VkShaderModuleCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = buffer.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(buffer.data());
+    createInfo.codeSize = spirv.size();
+    createInfo.pCode = code;
 
     VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule);
     CheckVkResult(result, "Failed to create shader module");
 
-    std::cout << "[VulkanShader] Shader loaded: " << path << "\n";
+    core::util::Logger::info("[VulkanShader] Shader loaded: {}", name);
     return true;
 }
 
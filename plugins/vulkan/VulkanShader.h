@@ -1,11 +1,16 @@
 #pragma once
+#include <cstddef>
+#include <span>
 #include <string>
+#include <string_view>
 #include <volk.h>
 
 namespace backend {
 class VulkanShader {
   public:
     bool LoadFromFile(VkDevice device, const std::string& path);
+    /* SPIR-V already in memory (e.g. an AsyncIO result); name is only for the log */
+    bool LoadFromMemory(VkDevice device, std::span<const std::byte> spirv, std::string_view name = "<memory>");
     void Destroy(VkDevice device);
 
     VkShaderModule Get() const {
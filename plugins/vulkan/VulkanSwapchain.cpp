@@ -1,12 +1,12 @@
 #include "VulkanSwapchain.h"
 #include "VulkanUtils.h"
-#include <iostream>
+#include "core/util/Logger.h"
 
 namespace backend {
 
 void VulkanSwapchain::Create(VkPhysicalDevice physicalDevice, VkDevice device, VkSurfaceKHR surface, VkExtent2D size,
                              VkCommandPool commandPool, VkQueue graphicsQueue) {
-    std::cout << "[VulkanSwapchain] Creating swapchain...\n";
+    core::util::Logger::info("[VulkanSwapchain] Creating swapchain...");
     deviceRef = device;
     physicalDeviceRef = physicalDevice;
 
@@ -83,7 +83,7 @@ void VulkanSwapchain::Create(VkPhysicalDevice physicalDevice, VkDevice device, V
     depthFormat = FindDepthFormat(physicalDeviceRef);
     CreateDepthResources(device, physicalDevice, extent, commandPool, graphicsQueue);
 
-    std::cout << "[VulkanSwapchain] Swapchain created with " << imageViews.size() << " image views.\n";
+    core::util::Logger::info("[VulkanSwapchain] Swapchain created with {} image views.", imageViews.size());
 }
 
 VkFormat VulkanSwapchain::FindDepthFormat(VkPhysicalDevice physical) {
@@ -172,7 +172,7 @@ void VulkanSwapchain::Destroy() {
         swapchain = VK_NULL_HANDLE;
     }
 
-    std::cout << "[VulkanSwapchain] Swapchain destroyed.\n";
+    core::util::Logger::info("[VulkanSwapchain] Swapchain destroyed.");
 }
 
 // --- Helper functions ---
@@ -1,5 +1,5 @@
 #include "VulkanSync.h"
-#include <iostream>
+#include "core/util/Logger.h"
 
 namespace backend {
 void VulkanSync::Create(VkDevice device) {
@@ -10,7 +10,7 @@ void VulkanSync::Create(VkDevice device) {
     VkFenceCreateInfo fci{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
     fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
     vkCreateFence(device, &fci, nullptr, &inFlight);
-    std::cout << "[VulkanSync] Synchronization objects created.\n";
+    core::util::Logger::info("[VulkanSync] Synchronization objects created.");
 }
 
 void VulkanSync::Destroy(VkDevice device) {
@@ -1,117 +1,167 @@
 #include "VulkanTexture.h"
 #include "VulkanUtils.h"
+#include "core/util/FileSystem.h"
+#include "graphics/resources/CookedTexture.h"
+#include "graphics/resources/MipGenerator.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h" // adjust to your include path
 
-#include <iostream>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
 
 namespace backend {
 
+namespace {
+
+VkFormat ToVkFormat(gfx::TexelFormat f) {
+    switch (f) {
+    case gfx::TexelFormat::RGBA8:
+        return VK_FORMAT_R8G8B8A8_UNORM;
+    case gfx::TexelFormat::RGBA8_sRGB:
+        return VK_FORMAT_R8G8B8A8_SRGB;
+    case gfx::TexelFormat::BC1:
+        return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+    case gfx::TexelFormat::BC1_sRGB:
+        return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+    case gfx::TexelFormat::BC3:
+        return VK_FORMAT_BC3_UNORM_BLOCK;
+    case gfx::TexelFormat::BC3_sRGB:
+        return VK_FORMAT_BC3_SRGB_BLOCK;
+    }
+    throw std::runtime_error("Unknown cooked texel format");
+}
+
+} // namespace
+
 void VulkanTexture::LoadFromFile(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
                                  const std::string& path) {
-    deviceRef = device;
-    physicalRef = physicalDevice;
+    // decode straight out of the page cache instead of stdio reads
+    const auto file = core::util::FileSystem::map(path);
+    LoadFromMemory(device, physicalDevice, cmdPool, queue, file.bytes());
+}
+
+VulkanTexture::Pixels VulkanTexture::Decode(std::span<const std::byte> encoded) {
+    Pixels out;
+    auto addRegion = [&](uint64_t offset, uint32_t width, uint32_t height) {
+        VkBufferImageCopy& r = out.regions.emplace_back();
+        r = {};
+        r.bufferOffset = offset;
+        r.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        r.imageSubresource.mipLevel = static_cast<uint32_t>(out.regions.size() - 1);
+        r.imageSubresource.layerCount = 1;
+        r.imageExtent = {width, height, 1};
+    };
+
+    if (gfx::isCookedTexture(encoded)) {
+        const gfx::CookedTextureView tex = gfx::parseCookedTexture(encoded);
+        out.format = ToVkFormat(tex.header->format);
+        out.width = tex.header->width;
+        out.height = tex.header->height;
+        out.payload.assign(tex.payload.begin(), tex.payload.end());
+        for (const gfx::CookedMip& m : tex.mips)
+            addRegion(m.offset - tex.header->payloadOffset, m.width, m.height);
+        return out;
+    }
 
     int texWidth, texHeight, texChannels;
-    stbi_uc* pixels = stbi_load(path.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()),
+                                            static_cast<int>(encoded.size()), &texWidth, &texHeight, &texChannels,
+                                            STBI_rgb_alpha);
     if (!pixels) {
         throw std::runtime_error("Failed to load texture image!");
     }
 
-    VkDeviceSize imageSize = texWidth * texHeight * 4;
-
-    // Create staging buffer
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingMemory;
-
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = imageSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    vkCreateBuffer(device, &bufferInfo, nullptr, &stagingBuffer);
+    /* not pre-cooked: build the mip chain here so minification doesn't thrash the cache */
+    const gfx::MipChain chain = gfx::generateMips(pixels, texWidth, texHeight);
+    stbi_image_free(pixels);
 
-    VkMemoryRequirements memReqs;
-    vkGetBufferMemoryRequirements(device, stagingBuffer, &memReqs);
+    out.format = VK_FORMAT_R8G8B8A8_SRGB;
+    out.width = static_cast<uint32_t>(texWidth);
+    out.height = static_cast<uint32_t>(texHeight);
+    const auto rgba = std::as_bytes(std::span{chain.rgba});
+    out.payload.assign(rgba.begin(), rgba.end());
+    for (const gfx::CookedMip& m : chain.levels)
+        addRegion(m.offset, m.width, m.height);
+    return out;
+}
 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReqs.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+void VulkanTexture::LoadFromMemory(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool,
+                                   VkQueue queue, std::span<const std::byte> encoded) {
+    if (gfx::isCookedTexture(encoded)) {
+        LoadCooked(device, physicalDevice, cmdPool, queue, encoded);
+        return;
+    }
 
-    vkAllocateMemory(device, &allocInfo, nullptr, &stagingMemory);
-    vkBindBufferMemory(device, stagingBuffer, stagingMemory, 0);
+    deviceRef = device;
+    physicalRef = physicalDevice;
 
-    void* data;
-    vkMapMemory(device, stagingMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(device, stagingMemory);
-    stbi_image_free(pixels);
+    const Pixels pixels = Decode(encoded);
+    const auto mipLevels = static_cast<uint32_t>(pixels.regions.size());
+    CreateImage(pixels.format, pixels.width, pixels.height, mipLevels);
+    Upload(cmdPool, queue, pixels.payload, pixels.regions, mipLevels);
+    CreateViewAndSampler(pixels.format, mipLevels);
+}
 
-    // Create image
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent = {(uint32_t)texWidth, (uint32_t)texHeight, 1};
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+void VulkanTexture::LoadCooked(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
+                               std::span<const std::byte> blob) {
+    deviceRef = device;
+    physicalRef = physicalDevice;
 
-    vkCreateImage(device, &imageInfo, nullptr, &image);
+    const gfx::CookedTextureView tex = gfx::parseCookedTexture(blob);
+    const VkFormat format = ToVkFormat(tex.header->format);
+
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &props);
+    if (!(props.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        throw std::runtime_error("Cooked texture format not supported by this GPU");
+
+    const uint32_t mipLevels = tex.header->mipCount;
+    CreateImage(format, tex.header->width, tex.header->height, mipLevels);
+
+    /* payload is already laid out mip after mip – one memcpy, one region per level */
+    std::vector<VkBufferImageCopy> regions(mipLevels);
+    for (uint32_t i = 0; i < mipLevels; ++i) {
+        const gfx::CookedMip& m = tex.mips[i];
+        VkBufferImageCopy& r = regions[i];
+        r = {};
+        r.bufferOffset = m.offset - tex.header->payloadOffset;
+        r.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        r.imageSubresource.mipLevel = i;
+        r.imageSubresource.layerCount = 1;
+        r.imageExtent = {m.width, m.height, 1};
+    }
+    Upload(cmdPool, queue, tex.payload, regions, mipLevels);
 
-    vkGetImageMemoryRequirements(device, image, &memReqs);
-    allocInfo.allocationSize = memReqs.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory);
-    vkBindImageMemory(device, image, imageMemory, 0);
+    CreateViewAndSampler(format, mipLevels);
+}
 
-    // Transition and copy
-    TransitionImageLayout(cmdPool, queue, image, imageInfo.format, VK_IMAGE_LAYOUT_UNDEFINED,
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    CopyBufferToImage(cmdPool, queue, stagingBuffer, image, texWidth, texHeight);
-    TransitionImageLayout(cmdPool, queue, image, imageInfo.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+void VulkanTexture::BeginUpload(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool,
+                                VkQueue queue, const Pixels& pixels, VkFence fence) {
+    deviceRef = device;
+    physicalRef = physicalDevice;
 
-    // Cleanup staging
-    vkDestroyBuffer(device, stagingBuffer, nullptr);
-    vkFreeMemory(device, stagingMemory, nullptr);
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, pixels.format, &props);
+    if (!(props.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+        throw std::runtime_error("Texture format not supported by this GPU");
 
-    // Create image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = imageInfo.format;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-    vkCreateImageView(device, &viewInfo, nullptr, &imageView);
+    const auto mipLevels = static_cast<uint32_t>(pixels.regions.size());
+    CreateImage(pixels.format, pixels.width, pixels.height, mipLevels);
+    Upload(cmdPool, queue, pixels.payload, pixels.regions, mipLevels, fence);
+    CreateViewAndSampler(pixels.format, mipLevels);
+}
 
-    // Create sampler
-    VkSamplerCreateInfo samplerInfo{};
-    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-    samplerInfo.magFilter = VK_FILTER_LINEAR;
-    samplerInfo.minFilter = VK_FILTER_LINEAR;
-    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-    samplerInfo.anisotropyEnable = VK_FALSE;
-    samplerInfo.maxAnisotropy = 1.0f;
-    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
-    samplerInfo.unnormalizedCoordinates = VK_FALSE;
-    samplerInfo.compareEnable = VK_FALSE;
-    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-    vkCreateSampler(device, &samplerInfo, nullptr, &sampler);
+void VulkanTexture::FinishUpload(VkCommandPool cmdPool) {
+    if (pendingCmd)
+        vkFreeCommandBuffers(deviceRef, cmdPool, 1, &pendingCmd);
+    if (pendingStaging)
+        vkDestroyBuffer(deviceRef, pendingStaging, nullptr);
+    if (pendingStagingMemory)
+        vkFreeMemory(deviceRef, pendingStagingMemory, nullptr);
+    pendingCmd = VK_NULL_HANDLE;
+    pendingStaging = VK_NULL_HANDLE;
+    pendingStagingMemory = VK_NULL_HANDLE;
 }
 
 void VulkanTexture::Destroy(VkDevice device) {
@@ -123,6 +173,10 @@ void VulkanTexture::Destroy(VkDevice device) {
         vkDestroyImage(device, image, nullptr);
     if (imageMemory)
         vkFreeMemory(device, imageMemory, nullptr);
+    sampler = VK_NULL_HANDLE;
+    imageView = VK_NULL_HANDLE;
+    image = VK_NULL_HANDLE;
+    imageMemory = VK_NULL_HANDLE;
 }
 
 uint32_t VulkanTexture::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
@@ -136,16 +190,71 @@ uint32_t VulkanTexture::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlag
     throw std::runtime_error("Failed to find suitable memory type!");
 }
 
-void VulkanTexture::TransitionImageLayout(VkCommandPool cmdPool, VkQueue queue, VkImage image, VkFormat format,
-                                          VkImageLayout oldLayout, VkImageLayout newLayout) {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = cmdPool;
-    allocInfo.commandBufferCount = 1;
+void VulkanTexture::CreateImage(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels) {
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = mipLevels;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = format;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    CheckVkResult(vkCreateImage(deviceRef, &imageInfo, nullptr, &image), "Failed to create texture image");
+
+    VkMemoryRequirements memReqs;
+    vkGetImageMemoryRequirements(deviceRef, image, &memReqs);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memReqs.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    CheckVkResult(vkAllocateMemory(deviceRef, &allocInfo, nullptr, &imageMemory), "Failed to allocate texture memory");
+    vkBindImageMemory(deviceRef, image, imageMemory, 0);
+}
+
+void VulkanTexture::Upload(VkCommandPool cmdPool, VkQueue queue, std::span<const std::byte> payload,
+                           std::span<const VkBufferImageCopy> regions, uint32_t mipLevels, VkFence fence) {
+    // Create staging buffer
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingMemory;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = payload.size();
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    vkCreateBuffer(deviceRef, &bufferInfo, nullptr, &stagingBuffer);
+
+    VkMemoryRequirements memReqs;
+    vkGetBufferMemoryRequirements(deviceRef, stagingBuffer, &memReqs);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memReqs.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    vkAllocateMemory(deviceRef, &allocInfo, nullptr, &stagingMemory);
+    vkBindBufferMemory(deviceRef, stagingBuffer, stagingMemory, 0);
+
+    void* data;
+    vkMapMemory(deviceRef, stagingMemory, 0, payload.size(), 0, &data);
+    memcpy(data, payload.data(), payload.size());
+    vkUnmapMemory(deviceRef, stagingMemory);
+
+    // Transition, copy every region, transition – one submit
+    VkCommandBufferAllocateInfo cmdInfo{};
+    cmdInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    cmdInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    cmdInfo.commandPool = cmdPool;
+    cmdInfo.commandBufferCount = 1;
 
     VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(deviceRef, &allocInfo, &cmd);
+    vkAllocateCommandBuffers(deviceRef, &cmdInfo, &cmd);
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -154,72 +263,78 @@ void VulkanTexture::TransitionImageLayout(VkCommandPool cmdPool, VkQueue queue,
 
     VkImageMemoryBarrier barrier{};
     barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     barrier.image = image;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.levelCount = mipLevels;
     barrier.subresourceRange.layerCount = 1;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.baseArrayLayer = 0;
-
     barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = 0;
-
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
     vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
                          nullptr, 1, &barrier);
 
+    vkCmdCopyBufferToImage(cmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(regions.size()), regions.data());
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0,
+                         nullptr, 1, &barrier);
     vkEndCommandBuffer(cmd);
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &cmd;
-
-    vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueSubmit(queue, 1, &submitInfo, fence);
+    if (fence) {
+        pendingStaging = stagingBuffer;
+        pendingStagingMemory = stagingMemory;
+        pendingCmd = cmd;
+        return;
+    }
     vkQueueWaitIdle(queue);
     vkFreeCommandBuffers(deviceRef, cmdPool, 1, &cmd);
-}
-
-void VulkanTexture::CopyBufferToImage(VkCommandPool cmdPool, VkQueue queue, VkBuffer buffer, VkImage image,
-                                      uint32_t width, uint32_t height) {
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = cmdPool;
-    allocInfo.commandBufferCount = 1;
 
-    VkCommandBuffer cmd;
-    vkAllocateCommandBuffers(deviceRef, &allocInfo, &cmd);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    vkBeginCommandBuffer(cmd, &beginInfo);
+    // Cleanup staging
+    vkDestroyBuffer(deviceRef, stagingBuffer, nullptr);
+    vkFreeMemory(deviceRef, stagingMemory, nullptr);
+}
 
-    VkBufferImageCopy copy{};
-    copy.bufferOffset = 0;
-    copy.bufferRowLength = 0;
-    copy.bufferImageHeight = 0;
-    copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copy.imageSubresource.mipLevel = 0;
-    copy.imageSubresource.baseArrayLayer = 0;
-    copy.imageSubresource.layerCount = 1;
-    copy.imageOffset = {0, 0, 0};
-    copy.imageExtent = {width, height, 1};
-
-    vkCmdCopyBufferToImage(cmd, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
-    vkEndCommandBuffer(cmd);
+void VulkanTexture::CreateViewAndSampler(VkFormat format, uint32_t mipLevels) {
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = mipLevels;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+    vkCreateImageView(deviceRef, &viewInfo, nullptr, &imageView);
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmd;
-    vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(queue);
-    vkFreeCommandBuffers(deviceRef, cmdPool, 1, &cmd);
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.anisotropyEnable = VK_FALSE;
+    samplerInfo.maxAnisotropy = 1.0f;
+    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(mipLevels);
+    vkCreateSampler(deviceRef, &samplerInfo, nullptr, &sampler);
 }
 
 } // namespace backend
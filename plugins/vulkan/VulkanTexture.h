@@ -1,12 +1,37 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <vector>
 #include <volk.h>
 
 namespace backend {
 class VulkanTexture {
   public:
+    /* Decoded texels with their mip chain, laid out for one staging copy */
+    struct Pixels {
+        VkFormat format{VK_FORMAT_UNDEFINED};
+        uint32_t width{0}, height{0};
+        std::vector<std::byte> payload;
+        std::vector<VkBufferImageCopy> regions; // one per mip level
+    };
+    /* CPU only (decode, mips or cooked payload copy) – safe on a JobSystem worker */
+    static Pixels Decode(std::span<const std::byte> encoded);
+
     void LoadFromFile(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
                       const std::string& path);
+    /* Encoded image (PNG/JPG/… or a cooked .vtex) already in memory, e.g. an AsyncIO result */
+    void LoadFromMemory(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
+                        std::span<const std::byte> encoded);
+    /* Cooked .vtex (tools/texture_cooker): mips and BC blocks go straight into staging */
+    void LoadCooked(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
+                    std::span<const std::byte> blob);
+    /* Non-blocking: submits the copy with `fence` signalled on completion; the
+       texture may be sampled, and FinishUpload() frees the staging, after that */
+    void BeginUpload(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool cmdPool, VkQueue queue,
+                     const Pixels& pixels, VkFence fence);
+    void FinishUpload(VkCommandPool cmdPool);
     void Destroy(VkDevice device);
 
     VkImageView GetImageView() const {
@@ -25,10 +50,17 @@ class VulkanTexture {
     VkDevice deviceRef = VK_NULL_HANDLE;
     VkPhysicalDevice physicalRef = VK_NULL_HANDLE;
 
-    void TransitionImageLayout(VkCommandPool cmdPool, VkQueue queue, VkImage image, VkFormat format,
-                               VkImageLayout oldLayout, VkImageLayout newLayout);
-    void CopyBufferToImage(VkCommandPool cmdPool, VkQueue queue, VkBuffer buffer, VkImage image, uint32_t width,
-                           uint32_t height);
+    /* staging of a BeginUpload() until FinishUpload() */
+    VkBuffer pendingStaging = VK_NULL_HANDLE;
+    VkDeviceMemory pendingStagingMemory = VK_NULL_HANDLE;
+    VkCommandBuffer pendingCmd = VK_NULL_HANDLE;
+
+    void CreateImage(VkFormat format, uint32_t width, uint32_t height, uint32_t mipLevels);
+    /* staging copy of payload → image via regions, left in SHADER_READ_ONLY_OPTIMAL.
+       Without a fence it waits for the queue; with one the staging is kept for FinishUpload() */
+    void Upload(VkCommandPool cmdPool, VkQueue queue, std::span<const std::byte> payload,
+                std::span<const VkBufferImageCopy> regions, uint32_t mipLevels, VkFence fence = VK_NULL_HANDLE);
+    void CreateViewAndSampler(VkFormat format, uint32_t mipLevels);
     uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 };
 } // namespace backend
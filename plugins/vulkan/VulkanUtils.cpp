@@ -1,10 +1,11 @@
 #include "VulkanUtils.h"
-#include <iostream>
+#include "core/util/Logger.h"
+#include <cstdlib>
 
 namespace backend {
 void CheckVkResult(VkResult result, const std::string& message) {
     if (result != VK_SUCCESS) {
-        std::cerr << "[Vulkan Error] " << message << " (code: " << result << ")\n";
+        core::util::Logger::error("[Vulkan Error] {} (code: {})", message, static_cast<int>(result));
         std::exit(EXIT_FAILURE);
     }
 }
@@ -1,16 +1,28 @@
 #version 450
-layout(location=0) in vec3 inPos;
-layout(location=1) in vec3 inNormal;
-layout(location=2) in vec2 inUV;
-layout(location=3) in vec3 inColor;
+// PackedVertex (plugins/vulkan/Vertex.h): the fetch formats already
+// turn position into unorm [0,1], uv into float and colour into unorm;
+// mvp carries the mesh-bounds dequantization.
+layout(location=0) in vec4 inPos;     // R16G16B16A16_UNORM
+layout(location=1) in vec2 inNormal;  // R16G16_SNORM, octahedral
+layout(location=2) in vec2 inUV;      // R16G16_SFLOAT
+layout(location=3) in vec4 inColor;   // R8G8B8A8_UNORM
 
 layout(push_constant) uniform Push { mat4 mvp; };
 
 layout(location=0) out vec2 vUV;
 layout(location=1) out vec3 vCol;
+layout(location=2) out vec3 vNormal;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
 
 void main() {
-    vUV  = inUV;
-    vCol = inColor;
-    gl_Position = mvp * vec4(inPos,1.0);
+    vUV     = inUV;
+    vCol    = inColor.rgb;
+    vNormal = octDecode(inNormal);
+    gl_Position = mvp * vec4(inPos.xyz, 1.0);
 }
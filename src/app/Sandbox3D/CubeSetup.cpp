@@ -1,22 +1,83 @@
 #include "CubeSetup.hpp"
+#include "core/util/AsyncIO.h"
+#include "core/util/Logger.h"
 #include "graphics/data/CubeVerts.hpp"
-#include <iostream>
+#include "graphics/resources/CookedMesh.h"
+#include "graphics/resources/MeshletBuilder.h"
+#include <stdexcept>
 
 CubeResources cube;
 
+namespace {
+
+/* kCubeVerts/kCubeIdx run through the cooker's packing, for when no cooked mesh is on disk */
+std::vector<std::byte> packBuiltInCube() {
+    gfx::SourceSubmesh sm;
+    for (const Vertex& v : kCubeVerts) {
+        gfx::SourceVertex s;
+        s.position = {v.position.x, v.position.y, v.position.z};
+        s.normal = {v.normal.x, v.normal.y, v.normal.z};
+        s.uv = {v.uv.x, v.uv.y};
+        s.color = {v.color.r, v.color.g, v.color.b, 1.f};
+        sm.vertices.push_back(s);
+    }
+    sm.indices.assign(std::begin(kCubeIdx), std::end(kCubeIdx));
+    gfx::generateMeshlets(sm);
+    return gfx::buildCookedMesh({&sm, 1});
+}
+
+} // namespace
+
 bool InitCube(const backend::VulkanDevice& dev, VkCommandPool pool, VkQueue q, const backend::VulkanSwapchain& sw) {
 
-    const VkMemoryPropertyFlags cpuVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    using core::util::AsyncIO;
+    using core::util::IoResult;
+
+    /* kick off every file read as one batch */
+    IoResult texFile, vsFile, fsFile, meshFile;
+    auto into = [](IoResult& dst) { return [&dst](IoResult& r) { dst = std::move(r); }; };
+    AsyncIO::read("assets/meshes/cube.vmesh", into(meshFile));
+    AsyncIO::read("assets/textures/checker.png", into(texFile));
+    AsyncIO::read("shaders/cube.vert.spv", into(vsFile));
+    AsyncIO::read("shaders/cube.frag.spv", into(fsFile));
+    AsyncIO::submit();
+    AsyncIO::wait();
+    for (const IoResult* f : {&texFile, &vsFile, &fsFile}) {
+        if (!f->ok()) {
+            core::util::Logger::error("[CubeSetup] Failed to read {}: {}", f->path.string(), f->message());
+            return false;
+        }
+    }
 
-    std::cout << "pool" << pool << " q " << q << std::endl;
-    /* buffers */
-    cube.vb.Create(dev.logical(), dev.physical(), sizeof(kCubeVerts), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, cpuVisible);
-    cube.ib.Create(dev.logical(), dev.physical(), sizeof(kCubeIdx), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, cpuVisible);
-    cube.vb.Upload(kCubeVerts, sizeof(kCubeVerts), pool, dev.GetGraphicsQueue());
-    cube.ib.Upload(kCubeIdx, sizeof(kCubeIdx), pool, dev.GetGraphicsQueue());
+    /* mesh: cooked file if there is one, else the built-in cube –
+       either way packed vertices, spans straight to upload */
+    std::vector<std::byte> builtIn;
+    gfx::CookedMeshView mesh;
+    try {
+        if (!meshFile.ok())
+            throw std::runtime_error(meshFile.message());
+        mesh = gfx::parseCookedMesh(meshFile.bytes());
+    } catch (const std::exception& e) {
+        core::util::Logger::warn("[CubeSetup] No cooked cube ({}), using the built-in one", e.what());
+        builtIn = packBuiltInCube();
+        mesh = gfx::parseCookedMesh(builtIn);
+    }
+    cube.bounds = mesh.header->bounds;
+    cube.dequantize = PackedVertex::dequantizeMatrix(mesh.header->bounds);
+    cube.indexType = mesh.header->indexType == gfx::IndexType::U16 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    cube.submeshes.assign(mesh.submeshes.begin(), mesh.submeshes.end());
+    cube.lods.assign(mesh.lods.begin(), mesh.lods.end());
+    cube.meshlets.assign(mesh.meshlets.begin(), mesh.meshlets.end());
+
+    const VkMemoryPropertyFlags cpuVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    const auto vertices = mesh.vertexBytes();
+    cube.vb.Create(dev.logical(), dev.physical(), vertices.size(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, cpuVisible);
+    cube.ib.Create(dev.logical(), dev.physical(), mesh.indices.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT, cpuVisible);
+    cube.vb.Upload(vertices.data(), vertices.size(), pool, dev.GetGraphicsQueue());
+    cube.ib.Upload(mesh.indices.data(), mesh.indices.size(), pool, dev.GetGraphicsQueue());
 
     /* texture */
-    cube.tex.LoadFromFile(dev.logical(), dev.physical(), pool, q, "assets/textures/checker.png");
+    cube.tex.LoadFromMemory(dev.logical(), dev.physical(), pool, q, texFile.bytes());
 
     /* descriptor + UBO */
     cube.desc.Create(dev.logical());
@@ -28,16 +89,19 @@ bool InitCube(const backend::VulkanDevice& dev, VkCommandPool pool, VkQueue q, c
 
     /* shaders & pipeline */
     backend::VulkanShader vs, fs;
-    vs.LoadFromFile(dev.logical(), "shaders/cube.vert.spv");
-    fs.LoadFromFile(dev.logical(), "shaders/cube.frag.spv");
+    vs.LoadFromMemory(dev.logical(), vsFile.bytes(), "cube.vert.spv");
+    fs.LoadFromMemory(dev.logical(), fsFile.bytes(), "cube.frag.spv");
 
     cube.pipe.CreateRenderPass(dev.logical(), sw.GetFormat(), sw.GetDepthFormat());
     cube.pipe.CreateFramebuffers(dev.logical(), sw.GetExtent(), sw.GetImageViews(), sw.GetDepthImageView());
     cube.pipe.CreateGraphicsPipeline(dev.logical(), sw.GetExtent(), cube.pipe.GetRenderPass(), vs.Get(), fs.Get(),
-                                     cube.desc.GetLayout0(), cube.desc.GetLayout1());
+                                     cube.desc.GetLayout0(), cube.desc.GetLayout1(),
+                                     VertexLayout::Of<PackedVertex>());
 
     vs.Destroy(dev.logical());
     fs.Destroy(dev.logical());
+    cube.vertSpirv.assign(vsFile.bytes().begin(), vsFile.bytes().end());
+    cube.fragSpirv.assign(fsFile.bytes().begin(), fsFile.bytes().end());
     return true;
 }
 
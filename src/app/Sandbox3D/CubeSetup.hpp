@@ -1,4 +1,5 @@
 #pragma once
+#include "graphics/scene/ClusterCuller.h"
 #include "plugins/vulkan/VulkanBuffer.h"
 #include "plugins/vulkan/VulkanDescriptor.h"
 #include "plugins/vulkan/VulkanDevice.h"
@@ -7,6 +8,8 @@
 #include "plugins/vulkan/VulkanSwapchain.h"
 #include "plugins/vulkan/VulkanTexture.h"
 #include "plugins/vulkan/VulkanUniformBuffer.h"
+#include <cstddef>
+#include <vector>
 
 struct CubeResources {
     backend::VulkanBuffer vb, ib;
@@ -15,6 +18,24 @@ struct CubeResources {
     backend::VulkanUniformBuffer ubo;
     backend::VulkanPipeline pipe;
     glm::mat4 mvp;
+    std::vector<std::byte> vertSpirv, fragSpirv; // current shaders, kept for pipeline rebuilds on hot reload
+
+    /* mesh layout, copied out of the cooked blob */
+    glm::mat4 dequantize{1.f}; // PackedVertex position → object space; post-multiply the model matrix
+    gfx::MeshBounds bounds{};
+    VkIndexType indexType{VK_INDEX_TYPE_UINT16};
+    std::vector<gfx::CookedSubmesh> submeshes;
+    std::vector<gfx::CookedLod> lods;
+    std::vector<gfx::CookedMeshlet> meshlets;
+    float screenSize{0.f}; // projected bounding sphere this frame, picks the LOD
+
+    /* rebuilt every frame: selected LODs, LOD 0 split into the meshlet ranges that survived culling */
+    struct Draw {
+        uint32_t firstIndex, indexCount;
+        int32_t vertexOffset;
+    };
+    std::vector<Draw> draws;
+    std::vector<gfx::IndexRange> visible; // scratch for cullClusters
 }; // forward
 extern CubeResources cube; // global for demo
 
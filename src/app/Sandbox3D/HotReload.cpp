@@ -0,0 +1,269 @@
+#include "HotReload.hpp"
+#include "CubeSetup.hpp"
+#include "core/jobs/JobSystem.h"
+#include "core/util/FileSystem.h"
+#include "core/util/FileWatcher.h"
+#include "core/util/Logger.h"
+#include "graphics/resources/ShaderCompiler.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using core::util::Logger;
+
+enum class Asset { VertexShader, FragmentShader, Texture, Count };
+constexpr size_t kAssetCount = static_cast<size_t>(Asset::Count);
+
+/* What a background job hands back: file contents, SPIR-V or decoded texels, or why not */
+struct Loaded {
+    std::vector<std::byte> bytes;
+    std::string error;
+    backend::VulkanTexture::Pixels pixels; // Asset::Texture
+};
+
+struct Job {
+    Asset asset;
+    uint64_t generation; // newer changes to the same asset win, whatever order jobs finish in
+    std::filesystem::path path;
+    std::future<Loaded> result;
+};
+
+struct Retiree {
+    uint64_t frame; // last frame that may still use it
+    std::function<void(VkDevice)> destroy;
+};
+
+struct HotReloadState {
+    const backend::VulkanDevice* dev{nullptr};
+    VkCommandPool pool{VK_NULL_HANDLE};
+    VkQueue queue{VK_NULL_HANDLE};
+    const backend::VulkanSwapchain* swap{nullptr};
+    uint32_t framesInFlight{2};
+    uint64_t frame{0};
+
+    std::unique_ptr<core::util::FileWatcher> watcher;
+    std::vector<Job> jobs;
+    uint64_t submitted[kAssetCount]{};
+    uint64_t applied[kAssetCount]{};
+    std::deque<Retiree> retired;
+
+    /* texture copy in flight; swapped in once its fence signalled */
+    struct Upload {
+        backend::VulkanTexture tex;
+        VkFence fence{VK_NULL_HANDLE};
+        std::filesystem::path path;
+    } upload;
+    uint64_t spareSetFreeAt{0}; // first frame the spare texture set is no longer bound
+};
+HotReloadState s_reload;
+
+void submit(Asset asset, const std::filesystem::path& path, std::function<Loaded()> work) {
+    const uint64_t generation = ++s_reload.submitted[static_cast<size_t>(asset)];
+    s_reload.jobs.push_back({asset, generation, path, core::jobs::JobSystem::submit(std::move(work))});
+}
+
+void compileLater(Asset asset, const std::filesystem::path& source) {
+    submit(asset, source, [source] {
+        gfx::ShaderCompileResult r = gfx::compileShader(source);
+        return Loaded{std::move(r.spirv), r.ok() ? std::string{} : std::move(r.log)};
+    });
+}
+
+void readLater(Asset asset, const std::filesystem::path& path) {
+    submit(asset, path, [asset, path] {
+        Loaded out;
+        try {
+            const std::vector<char> chars = core::util::FileSystem::readBinary(path);
+            out.bytes.resize(chars.size());
+            std::copy(chars.begin(), chars.end(), reinterpret_cast<char*>(out.bytes.data()));
+            if (asset == Asset::VertexShader || asset == Asset::FragmentShader) {
+                if (!gfx::isSpirv(out.bytes))
+                    out = {{}, "not SPIR-V"};
+            }
+        } catch (const std::exception& e) {
+            out = {{}, e.what()};
+        }
+        return out;
+    });
+}
+
+void decodeLater(const std::filesystem::path& path) {
+    submit(Asset::Texture, path, [path] {
+        Loaded out;
+        try {
+            const auto file = core::util::FileSystem::map(path);
+            out.pixels = backend::VulkanTexture::Decode(file.bytes());
+        } catch (const std::exception& e) {
+            out.error = e.what();
+        }
+        return out;
+    });
+}
+
+void retire(std::function<void(VkDevice)> destroy) {
+    s_reload.retired.push_back({s_reload.frame, std::move(destroy)});
+}
+
+/* False keeps the current pipeline: bad SPIR-V or a pipeline the driver refused */
+bool rebuildPipeline() {
+    const VkDevice device = s_reload.dev->logical();
+    backend::VulkanShader vs, fs;
+    bool ok = vs.LoadFromMemory(device, cube.vertSpirv, "cube.vert (reload)") &&
+              fs.LoadFromMemory(device, cube.fragSpirv, "cube.frag (reload)");
+    if (ok) {
+        try {
+            const auto old = cube.pipe.RebuildGraphicsPipeline(device, s_reload.swap->GetExtent(), vs.Get(), fs.Get(),
+                                                               cube.desc.GetLayout0(), cube.desc.GetLayout1(),
+                                                               VertexLayout::Of<PackedVertex>());
+            retire([old](VkDevice d) {
+                vkDestroyPipeline(d, old.pipeline, nullptr);
+                vkDestroyPipelineLayout(d, old.layout, nullptr);
+            });
+        } catch (const std::exception& e) {
+            Logger::error("[HotReload] {}", e.what());
+            ok = false;
+        }
+    }
+    vs.Destroy(device); // modules are only needed while the pipeline is created
+    fs.Destroy(device);
+    return ok;
+}
+
+void beginTextureUpload(const backend::VulkanTexture::Pixels& pixels, const std::filesystem::path& path) {
+    const backend::VulkanDevice& dev = *s_reload.dev;
+    VkFenceCreateInfo fci{};
+    fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence = VK_NULL_HANDLE;
+    if (vkCreateFence(dev.logical(), &fci, nullptr, &fence) != VK_SUCCESS)
+        throw std::runtime_error("Failed to create upload fence");
+    backend::VulkanTexture fresh;
+    try {
+        fresh.BeginUpload(dev.logical(), dev.physical(), s_reload.pool, s_reload.queue, pixels, fence);
+    } catch (...) {
+        fresh.Destroy(dev.logical());
+        vkDestroyFence(dev.logical(), fence, nullptr);
+        throw;
+    }
+    s_reload.upload = {fresh, fence, path};
+}
+
+/* The copy is done and no recorded frame binds the spare set any more:
+   point the spare at the new texture and make it the one drawn with */
+void finishTextureUpload() {
+    auto& up = s_reload.upload;
+    const VkDevice device = s_reload.dev->logical();
+    if (!up.fence || vkGetFenceStatus(device, up.fence) != VK_SUCCESS || s_reload.frame < s_reload.spareSetFreeAt)
+        return;
+    up.tex.FinishUpload(s_reload.pool);
+    vkDestroyFence(device, up.fence, nullptr);
+    up.fence = VK_NULL_HANDLE;
+
+    cube.desc.UpdateSpare(device, up.tex.GetImageView(), up.tex.GetSampler());
+    cube.desc.Flip();
+    s_reload.spareSetFreeAt = s_reload.frame + s_reload.framesInFlight;
+    retire([old = cube.tex](VkDevice d) mutable { old.Destroy(d); });
+    cube.tex = up.tex;
+    Logger::info("[HotReload] Reloaded {}", up.path.string());
+}
+
+} // namespace
+
+void InitHotReload(const backend::VulkanDevice& dev, VkCommandPool pool, VkQueue graphicsQ,
+                   const backend::VulkanSwapchain& swap, uint32_t framesInFlight) {
+    s_reload.dev = &dev;
+    s_reload.pool = pool;
+    s_reload.queue = graphicsQ;
+    s_reload.swap = &swap;
+    s_reload.framesInFlight = framesInFlight;
+    s_reload.watcher = std::make_unique<core::util::FileWatcher>();
+
+    auto& w = *s_reload.watcher;
+    w.watch("shaders/cube.vert", [](const auto& p) { compileLater(Asset::VertexShader, p); });
+    w.watch("shaders/cube.frag", [](const auto& p) { compileLater(Asset::FragmentShader, p); });
+    w.watch("shaders/cube.vert.spv", [](const auto& p) { readLater(Asset::VertexShader, p); });
+    w.watch("shaders/cube.frag.spv", [](const auto& p) { readLater(Asset::FragmentShader, p); });
+    w.watch("assets/textures/checker.png", [](const auto& p) { decodeLater(p); });
+    Logger::info("[HotReload] Watching shaders and textures ({})",
+                 w.backend() == core::util::FileWatcher::Backend::Inotify ? "inotify" : "polling");
+}
+
+void UpdateHotReload(uint64_t frame) {
+    if (!s_reload.watcher)
+        return;
+    s_reload.frame = frame;
+    s_reload.watcher->poll();
+
+    while (!s_reload.retired.empty() && s_reload.retired.front().frame + s_reload.framesInFlight <= frame) {
+        s_reload.retired.front().destroy(s_reload.dev->logical());
+        s_reload.retired.pop_front();
+    }
+    finishTextureUpload();
+
+    bool shadersChanged = false;
+    for (auto it = s_reload.jobs.begin(); it != s_reload.jobs.end();) {
+        const bool uploading = it->asset == Asset::Texture && s_reload.upload.fence;
+        if (uploading || it->result.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            ++it; // a newer texture waits for the one still uploading
+            continue;
+        }
+        Job job = std::move(*it);
+        it = s_reload.jobs.erase(it);
+        Loaded loaded = job.result.get();
+        uint64_t& applied = s_reload.applied[static_cast<size_t>(job.asset)];
+        if (job.generation < applied)
+            continue; // a newer version already went in
+        if (!loaded.error.empty()) {
+            Logger::warn("[HotReload] {} not reloaded: {}", job.path.string(), loaded.error);
+            continue;
+        }
+        applied = job.generation;
+        switch (job.asset) {
+        case Asset::VertexShader:
+            cube.vertSpirv = std::move(loaded.bytes);
+            shadersChanged = true;
+            break;
+        case Asset::FragmentShader:
+            cube.fragSpirv = std::move(loaded.bytes);
+            shadersChanged = true;
+            break;
+        case Asset::Texture:
+            try {
+                beginTextureUpload(loaded.pixels, job.path);
+            } catch (const std::exception& e) {
+                Logger::warn("[HotReload] {} not reloaded: {}", job.path.string(), e.what());
+            }
+            continue; // logged once it is swapped in
+        case Asset::Count:
+            break;
+        }
+        Logger::info("[HotReload] Reloaded {}", job.path.string());
+    }
+    if (shadersChanged && !rebuildPipeline())
+        Logger::warn("[HotReload] Shader reload failed, keeping the old pipeline");
+}
+
+void ShutdownHotReload(const backend::VulkanDevice& dev) {
+    s_reload.watcher.reset();
+    for (Job& job : s_reload.jobs)
+        job.result.wait();
+    s_reload.jobs.clear();
+    if (auto& up = s_reload.upload; up.fence) {
+        up.tex.FinishUpload(s_reload.pool);
+        up.tex.Destroy(dev.logical());
+        vkDestroyFence(dev.logical(), up.fence, nullptr);
+        up.fence = VK_NULL_HANDLE;
+    }
+    for (Retiree& r : s_reload.retired)
+        r.destroy(dev.logical());
+    s_reload.retired.clear();
+}
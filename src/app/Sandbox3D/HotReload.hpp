@@ -0,0 +1,22 @@
+#pragma once
+#include "plugins/vulkan/VulkanDevice.h"
+#include "plugins/vulkan/VulkanSwapchain.h"
+#include <cstdint>
+
+/* ---------------------------------------------------------------
+   Hot reload for the cube demo
+   * FileWatcher on shaders/cube.{vert,frag} (recompiled with glslc),
+     their .spv outputs and the cube texture
+   * Compiles, file reads and texture decodes (mips included) run as
+     JobSystem jobs; the render loop only picks up finished results
+   * UpdateHotReload() is the frame boundary: it swaps in the new
+     pipeline/texture and retires the old ones, destroying them once
+     every frame that could still reference them has finished – no
+     device wait.  A texture is copied under a fence and swapped in
+     through the spare descriptor set once that has signalled, so no
+     set a recorded frame binds is ever written
+-----------------------------------------------------------------*/
+void InitHotReload(const backend::VulkanDevice& dev, VkCommandPool pool, VkQueue graphicsQ,
+                   const backend::VulkanSwapchain& swap, uint32_t framesInFlight);
+void UpdateHotReload(uint64_t frame); // call before beginFrame
+void ShutdownHotReload(const backend::VulkanDevice& dev); // device must be idle
@@ -1,16 +1,28 @@
 #include "CubeSetup.hpp"
+#include "HotReload.hpp"
 #include "backend/RenderDevice.h"
+#include "core/jobs/JobSystem.h"
+#include "core/util/AsyncIO.h"
+#include "core/util/FileSystem.h"
 #include "core/util/core.hpp"
 #include "graphics/render/RenderGraph.h"
 #include "platform/Window.h"
+#include <cstring>
+#include <fstream>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 
 int main() {
     using core::util::Logger;
     core::platform::Window win{1280, 720, "Sandbox"};
     Logger::init("Sandbox3D");
+    core::util::AsyncIO::init();
+    /* `asset_packer assets.vepk assets`: loaders read from it, loose files fill the gaps */
+    if (core::util::FileSystem::exists("assets.vepk"))
+        core::util::AsyncIO::mount("assets.vepk", "assets");
+    core::jobs::JobSystem::start();
 
     if (!gfx::RenderDevice::init(&win, "vulkan")) {
         Logger::error("RenderDevice init failed"); //  see console
@@ -18,81 +30,136 @@ int main() {
             win.pollEvents();
             std::this_thread::sleep_for(std::chrono::milliseconds(16));
         }
+        Logger::shutdown();
         return -1;
     }
 
     /* ----------------- Build graph once ---------------------- */
     gfx::RenderGraph graph;
-    graph.addTexture("color", {1280, 720});
-    graph.addPass("clear", gfx::PassType::Graphics, std::array<std::string, 1>{}, std::array<std::string, 1>{"color"},
-                  [](const gfx::RenderPass::ExecCtx& ctx) {
+    using gfx::ResourceUsage;
+    const gfx::ResourceId color = graph.importTexture("color", {1280, 720}, gfx::BackbufferTexture,
+                                                      ResourceUsage::Undefined, ResourceUsage::Present);
+    graph.addPass("clear", gfx::PassType::Copy, {}, {{color, ResourceUsage::TransferDst}},
+                  [color](const gfx::RenderPass::ExecCtx& ctx) {
                       static const float mag[4]{1.f, 0.f, 0.f, 1.f};
-                      auto& res = ctx.graph->resource("color");
-                      ctx.device->clearColor(ctx.cmd, std::get<gfx::TextureHandle>(res.handle), mag);
-
-                      ctx.device->transition(ctx.cmd, std::get<gfx::TextureHandle>(res.handle),
-                                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                             VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT,
-                                             VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                             VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+                      ctx.device->clearColor(ctx.cmd, ctx.graph->texture(color), mag);
                   });
 
-    graph.addPass("cube", gfx::PassType::Graphics, std::array<std::string, 1>{"color"},
-                  std::array<std::string, 1>{"color"}, [](const gfx::RenderPass::ExecCtx& ctx) {
-                      auto cmd = ctx.cmd;
-                      auto& P = cube.pipe;
-
-                      ctx.device->cmdBeginRenderPass(cmd, &P, ctx.frame % P.GetFramebuffers().size());
-
-                      ctx.device->cmdBindPipeline(cmd, P.GetPipeline());
-                      ctx.device->cmdBindDescriptorSets(cmd, P.GetPipelineLayout(), cube.desc.GetSet0(),
-                                                        cube.desc.GetSet1());
-                      ctx.device->cmdBindVertexBuffer(cmd, cube.vb.Get());
-                      ctx.device->cmdBindIndexBuffer(cmd, cube.ib.Get(), VK_INDEX_TYPE_UINT16);
-                      ctx.device->cmdPushConstants(cmd, P.GetPipelineLayout(), cube.mvp);
-                      ctx.device->cmdDrawIndexed(cmd, 36, 1, 0, 0, 0);
-
-                      ctx.device->cmdEndRenderPass(cmd);
-                  });
+    /* the render pass loads the cleared image, so colour is read as well as written;
+       it is begun on the primary and its draws are recorded in parallel chunks */
+    const gfx::PassId cubePass = graph.addPass(
+        "cube", gfx::PassType::Graphics, {{color, ResourceUsage::ColorAttachment}},
+        {{color, ResourceUsage::ColorAttachment}}, [](const gfx::RenderPass::ExecCtx& ctx) {
+            auto& P = cube.pipe;
+            ctx.beginRenderPass(&P, ctx.frame % P.GetFramebuffers().size());
+        });
+    gfx::RenderPass& cubeRp = graph.pass(cubePass);
+    cubeRp.chunkCount = 4;
+    cubeRp.onChunk = [chunks = cubeRp.chunkCount](const gfx::RenderPass::ExecCtx& ctx, uint32_t chunk) {
+        /* a secondary inherits no bound state, so every chunk binds its own */
+        auto cmd = ctx.cmd;
+        auto& P = cube.pipe;
+        ctx.device->cmdBindPipeline(cmd, P.GetPipeline());
+        ctx.device->cmdBindDescriptorSets(cmd, P.GetPipelineLayout(), cube.desc.GetSet0(), cube.desc.GetSet1());
+        ctx.device->cmdBindVertexBuffer(cmd, cube.vb.Get());
+        ctx.device->cmdBindIndexBuffer(cmd, cube.ib.Get(), cube.indexType);
+        ctx.device->cmdPushConstants(cmd, P.GetPipelineLayout(), cube.mvp);
+        const std::size_t first = cube.draws.size() * chunk / chunks;
+        const std::size_t last = cube.draws.size() * (chunk + 1) / chunks;
+        for (std::size_t i = first; i < last; ++i) {
+            const CubeResources::Draw& d = cube.draws[i];
+            ctx.device->cmdDrawIndexed(cmd, d.indexCount, 1, d.firstIndex, d.vertexOffset, 0);
+        }
+    };
+    cubeRp.onFinish = [](const gfx::RenderPass::ExecCtx& ctx) { ctx.endRenderPass(); };
+    graph.setParallelRecording(true);
 
     auto* vkBackend = static_cast<gfx::VulkanBackend*>(gfx::RenderDevice::backend());
 
     InitCube(vkBackend->device(), vkBackend->commands().GetPool(), vkBackend->graphicsQ(), vkBackend->swapchain());
+    InitHotReload(vkBackend->device(), vkBackend->commands().GetPool(), vkBackend->graphicsQ(), vkBackend->swapchain(),
+                  static_cast<uint32_t>(vkBackend->GetSyncObjects().size()));
 
+    graph.setFramesInFlight(static_cast<uint32_t>(vkBackend->GetSyncObjects().size()));
+    graph.markOutput(color);
     graph.compile();
 
     /* ----------------- Frame loop (one frame for now) -------- */
     uint64_t frame = 0;
     static float angle = 0.f;
+    using core::util::Time;
+    Time::init();
+    double nextReport = 5.0;
 
     while (!win.shouldClose()) {
         // while (frame < 3) {  // just 4 frames for demo
         // std::cout << "Frame: " << frame << std::endl;
         win.pollEvents();
+        UpdateHotReload(frame); // swaps reloaded shaders/textures before this frame records
 
         auto cmd = gfx::RenderDevice::beginFrame(); // returns gfx::CmdHandle
 
-        // core::util::Time::tick();
-        // angle += glm::radians(45.f) * core::util::Time::delta();
-        angle += glm::radians(0.1f); // 5 ° per frame – very visible in 3 frames
+        Time::tick();
+        angle += glm::radians(45.f) * static_cast<float>(Time::delta());
+        if (Time::total() >= nextReport) {
+            const auto st = Time::stats().summary();
+            Logger::info("frame ms: mean {:.2f} p50 {:.2f} p95 {:.2f} p99 {:.2f} max {:.2f} | hitches {}",
+                         st.mean * 1e3, st.p50 * 1e3, st.p95 * 1e3, st.p99 * 1e3, st.max * 1e3, st.hitches);
+            nextReport += 5.0;
+        }
 
+        const glm::vec3 eye(0, 0, 5);
         glm::mat4 model = glm::rotate(glm::mat4(1.f), angle, glm::vec3(0, 1, 0));
-        glm::mat4 view = glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0), glm::vec3(0, 1, 0));
+        glm::mat4 view = glm::lookAt(eye, glm::vec3(0), glm::vec3(0, 1, 0));
         glm::mat4 proj = glm::perspective(glm::radians(60.f), (float)win.width() / (float)win.height(), 0.1f, 100.f);
+        const auto& c = cube.bounds.center;
+        const glm::vec3 center{model * glm::vec4(c[0], c[1], c[2], 1.f)};
+        cube.screenSize = gfx::projectedSphereSize({center.x, center.y, center.z}, cube.bounds.radius,
+                                                   {eye.x, eye.y, eye.z}, proj[1][1]);
         proj[1][1] *= -1.f;
-        cube.mvp = proj * view * model;
+        cube.mvp = proj * view * model * cube.dequantize;
+
+        /* LOD per submesh; at full detail, only the meshlets in view and facing the camera */
+        core::math::Mat4 objectToClip;
+        std::memcpy(objectToClip.m.data(), glm::value_ptr(proj * view * model), sizeof(objectToClip.m));
+        const gfx::Frustum frustum = gfx::Frustum::fromMatrix(objectToClip);
+        const glm::vec3 localEye{glm::inverse(model) * glm::vec4(eye, 1.f)};
+        cube.draws.clear();
+        for (const gfx::CookedSubmesh& sm : cube.submeshes) {
+            const std::span<const gfx::CookedLod> lods{cube.lods.data() + sm.firstLod, sm.lodCount};
+            const std::uint32_t level = gfx::selectLod(lods, cube.screenSize);
+            const auto vertexOffset = static_cast<int32_t>(sm.firstVertex);
+            if (level > 0 || sm.meshletCount == 0) {
+                cube.draws.push_back({lods[level].firstIndex, lods[level].indexCount, vertexOffset});
+                continue;
+            }
+            cube.visible.clear();
+            gfx::cullClusters({cube.meshlets.data() + sm.firstMeshlet, sm.meshletCount}, frustum,
+                              {localEye.x, localEye.y, localEye.z}, cube.visible);
+            for (const gfx::IndexRange& r : cube.visible)
+                cube.draws.push_back({r.firstIndex, r.indexCount, vertexOffset});
+        }
 
         /* write to per-frame UBO slot */
         uint32_t frameIdx = frame % cube.ubo.InstanceCount();
         cube.ubo.Update(vkBackend->device().logical(), frameIdx, &cube.mvp, sizeof(cube.mvp));
         cube.desc.Update(vkBackend->device().logical(), cube.ubo.GetDescriptorInfo(frameIdx));
 
-        graph.execute(frame++, cmd); // pass both args
+        cmd = graph.execute(frame++, cmd); // may come back as a later graphics batch
         gfx::RenderDevice::endFrame(cmd);
     }
+    /* graph + last per-pass costs for `dot -Tsvg rendergraph.dot` or tooling */
+    std::ofstream("rendergraph.dot") << graph.exportDot();
+    std::ofstream("rendergraph.json") << graph.exportJson();
+
     gfx::RenderDevice::preShutdown(); // optional, before shutdown()
+    graph.releaseMemory();            // device is idle now
 
+    ShutdownHotReload(vkBackend->device());
     DestroyCube(vkBackend->device());
 
     gfx::RenderDevice::shutdown();
+    core::util::AsyncIO::shutdown();
+    core::jobs::JobSystem::stop();
+    Logger::shutdown();
 }
@@ -31,7 +31,7 @@ bool RenderDevice::init(void* native, const char* backendName) {
         return false;
     if (!s_backend->init(native))
         return false;
-    core::util::Logger::info("RenderDevice: %s backend initialised", backendName);
+    core::util::Logger::info("RenderDevice: {} backend initialised", backendName);
     return true;
 }
 
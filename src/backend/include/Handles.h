@@ -11,7 +11,19 @@ struct TextureHandle {
 struct BufferHandle {
     uint32_t id{0};
 };
+struct HeapHandle {
+    uint32_t id{0};
+};
+
+/* A queue submission's completion within the current frame (see IRenderBackend::submitBatch) */
+struct SyncPoint {
+    uint32_t id{0};
+};
 
 constexpr TextureHandle InvalidTexture{0};
 constexpr BufferHandle InvalidBuffer{0};
+constexpr HeapHandle InvalidHeap{0};
+
+/* The swapchain image being rendered this frame, resolved at record time */
+constexpr TextureHandle BackbufferTexture{~0u};
 } // namespace gfx
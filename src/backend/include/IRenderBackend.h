@@ -3,6 +3,8 @@
 #include "glm/glm.hpp"                      // for glm::mat4
 #include "graphics/render/RenderResource.h" // TextureDesc / BufferDesc
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace gfx {
 
@@ -19,6 +21,28 @@ class IRenderBackend {
     virtual gfx::CmdHandle beginFrame() = 0; // returns cmd
     virtual void endFrame(gfx::CmdHandle) = 0;
 
+    /* queue batches: a frame may be split into several submissions on the
+       graphics and async-compute queues.  beginFrame()'s cmd is the first
+       graphics batch, endFrame() submits the last one begun ------------------ */
+    virtual bool hasAsyncCompute() const = 0; // a compute queue separate from graphics
+    virtual CmdHandle beginBatch(QueueType) = 0;
+    virtual void batchWait(CmdHandle, SyncPoint) = 0; // cmd's submission waits for the point
+    /* ends + submits cmd; with `signal` the point must be waited on exactly once this frame */
+    virtual SyncPoint submitBatch(CmdHandle, QueueType, bool signal) = 0;
+
+    /* GPU timestamps, one query set per frame in flight.  beginTimestamps
+       hands back what this frame in flight wrote last time (its fence has
+       signalled by now) under the tag it was begun with, in seconds – NaN
+       where nothing was written – then clears `count` queries for this
+       frame.  seconds stays empty on first use or when the device can't
+       time.  cmdWriteTimestamp may be called on secondaries ------------------ */
+    struct TimestampReadback {
+        uint64_t tag{0};
+        std::vector<double> seconds;
+    };
+    virtual TimestampReadback beginTimestamps(uint32_t count, uint64_t tag) = 0;
+    virtual void cmdWriteTimestamp(CmdHandle, QueueType, uint32_t query) = 0;
+
     /* immediate-mode helpers (non-virtual if you prefer) -------------------- */
     virtual void clearColor(gfx::CmdHandle, TextureHandle, const float rgba[4]) = 0;
     /* … drawMesh(), dispatchCompute(), etc. will arrive later … */
@@ -29,7 +53,23 @@ class IRenderBackend {
     virtual void destroyTexture(TextureHandle) = 0;
     virtual void destroyBuffer(BufferHandle) = 0;
 
-    virtual void cmdBeginRenderPass(CmdHandle, void* pipeline, uint32_t fbIdx) = 0;
+    /* transient memory: resources placed in one heap may alias ---------------- */
+    virtual MemoryRequirements memoryRequirements(const TextureDesc&) = 0;
+    virtual MemoryRequirements memoryRequirements(const BufferDesc&) = 0;
+    virtual HeapHandle createHeap(const HeapDesc&) = 0;
+    virtual void destroyHeap(HeapHandle) = 0;
+    virtual TextureHandle createPlacedTexture(const TextureDesc&, HeapHandle, uint64_t offset) = 0;
+    virtual BufferHandle createPlacedBuffer(const BufferDesc&, HeapHandle, uint64_t offset) = 0;
+
+    /* secondary command buffers: recorded on any thread (one per thread at a
+       time), executed on the primary in the order given ---------------------- */
+    virtual CmdHandle beginSecondary(CmdHandle primary, bool continueRenderPass) = 0;
+    virtual void endSecondary(CmdHandle) = 0;
+    virtual void cmdExecuteSecondaries(CmdHandle primary, std::span<const CmdHandle> secondaries) = 0;
+
+    /* secondaryContents: the pass body comes from continueRenderPass secondaries */
+    virtual void cmdBeginRenderPass(CmdHandle, void* pipeline, uint32_t fbIdx, bool secondaryContents,
+                                    const RenderPassOps& ops) = 0;
     virtual void cmdEndRenderPass(CmdHandle) = 0;
     virtual void cmdBindPipeline(CmdHandle, void* pipeline) = 0;
     virtual void cmdBindDescriptorSets(CmdHandle, void* layout, void* set0, void* set1) = 0;
@@ -39,6 +79,9 @@ class IRenderBackend {
     virtual void cmdDrawIndexed(CmdHandle, uint32_t idxCnt, uint32_t instCnt, uint32_t firstIdx, int32_t vtxOffset,
                                 uint32_t firstInst) = 0;
 
+    /* Every barrier of one RenderGraph pass boundary, issued as one batch */
+    virtual void cmdBarriers(CmdHandle, std::span<const ResourceBarrier> barriers) = 0;
+
     virtual void transition(gfx::CmdHandle cmd, gfx::TextureHandle tex, int oldLayout, int newLayout, int srcAccess,
                             int dstAccess, int srcStage, int dstStage) = 0;
 };
@@ -1,5 +1,6 @@
 #include "core/jobs/JobSystem.h"
 #include "core/util/Logger.h"
+#include <algorithm>
 #include <random>
 
 namespace core::jobs {
@@ -12,31 +13,22 @@ void JobSystem::start(std::size_t workerCount) {
     if (workerCount == 0)
         workerCount = std::max(1u, std::thread::hardware_concurrency() - 1);
 
-    s_queues.resize(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i)
+        s_queues.push_back(std::make_unique<WorkQueue>());
     s_threads.reserve(workerCount);
+    s_workerCount.store(workerCount, std::memory_order_release);
 
     for (std::size_t i = 0; i < workerCount; ++i) {
         s_threads.emplace_back([i] {
+            s_workerIndex = i + 1;
             std::mt19937 rng{static_cast<unsigned>(i)};
             std::uniform_int_distribution<std::size_t> dist(0, s_queues.size() - 1);
 
             while (s_running.load(std::memory_order_relaxed)) {
                 Task t;
 
-                /* try own deque first */
-                if (!s_queues[i].empty()) {
-                    t = std::move(s_queues[i].front());
-                    s_queues[i].pop_front();
-                } else {
-                    /* steal from random victim */
-                    std::size_t victim = dist(rng);
-                    if (victim != i && !s_queues[victim].empty()) {
-                        t = std::move(s_queues[victim].back());
-                        s_queues[victim].pop_back();
-                    }
-                }
-
-                if (t) {
+                /* try own deque first, then steal from a random victim */
+                if (popTask(i, false, t) || popTask(dist(rng), true, t)) {
                     t();
                 } else {
                     /* sleep until new work arrives */
@@ -47,7 +39,7 @@ void JobSystem::start(std::size_t workerCount) {
         });
     }
 
-    core::util::Logger::info("JobSystem started with %zu workers", workerCount);
+    core::util::Logger::info("JobSystem started with {} workers", workerCount);
 }
 
 void JobSystem::stop() {
@@ -59,14 +51,32 @@ void JobSystem::stop() {
             th.join();
     s_threads.clear();
     s_queues.clear();
+    s_workerCount.store(0, std::memory_order_release);
 }
 
 void JobSystem::enqueue(Task&& t) {
-    /* push onto the smallest queue – trivial load balancing */
-    auto it = std::min_element(s_queues.begin(), s_queues.end(), [](auto& a, auto& b) { return a.size() < b.size(); });
-
-    it->push_back(std::move(t));
+    /* round-robin – idle workers steal to even things out */
+    WorkQueue& q = *s_queues[s_nextQueue.fetch_add(1, std::memory_order_relaxed) % s_queues.size()];
+    {
+        std::lock_guard lk{q.mutex};
+        q.tasks.push_back(std::move(t));
+    }
     s_cv.notify_one();
 }
 
+bool JobSystem::popTask(std::size_t queueIdx, bool steal, Task& out) {
+    WorkQueue& q = *s_queues[queueIdx];
+    std::lock_guard lk{q.mutex};
+    if (q.tasks.empty())
+        return false;
+    if (steal) {
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+    } else {
+        out = std::move(q.tasks.front());
+        q.tasks.pop_front();
+    }
+    return true;
+}
+
 } // namespace core::jobs
@@ -2,7 +2,10 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -13,6 +16,7 @@ namespace core::jobs {
    * start()  – spin up N threads (defaults: hwConcurrency-1)
    * stop()   – join all threads (auto-called on exit)
    * submit(fn, args…) → std::future<R>
+   * parallelFor(n, grain, fn(begin, end)) – blocking fork/join
 -----------------------------------------------------------------*/
 class JobSystem {
   public:
@@ -33,16 +37,56 @@ class JobSystem {
         return fut;
     }
 
+    /* Splits [0, count) into `grain`-sized ranges spread over the workers; the
+       calling thread runs the first range itself.  Runs inline when the system
+       isn't started, and inside a job – a worker blocking on queued ranges could
+       leave none to run them. */
+    template <typename Fn> static void parallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+        grain = grain ? grain : 1;
+        if (!running() || workerIndex() != 0 || count <= grain) {
+            fn(std::size_t{0}, count);
+            return;
+        }
+        std::vector<std::future<void>> rest;
+        rest.reserve(count / grain);
+        for (std::size_t b = grain; b < count; b += grain)
+            rest.push_back(submit([&fn, b, e = std::min(b + grain, count)] { fn(b, e); }));
+        fn(std::size_t{0}, grain);
+        for (auto& f : rest)
+            f.get(); // rethrows the first failure
+    }
+
+    static bool running() noexcept {
+        return s_running.load(std::memory_order_acquire);
+    }
+
+    /* 0 on threads outside the pool, 1…workerCount() on its workers – for
+       per-thread scratch (command pools, arenas) indexed without locks */
+    static std::size_t workerIndex() noexcept {
+        return s_workerIndex;
+    }
+    static std::size_t workerCount() noexcept {
+        return s_workerCount.load(std::memory_order_acquire);
+    }
+
   private:
     /* Internal -------------------------------------------------- */
     static void enqueue(Task&& t);
-    static Task stealTask(std::size_t thiefIdx);
+    static bool popTask(std::size_t queueIdx, bool steal, Task& out);
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
 
     static inline std::vector<std::thread> s_threads{};
-    static inline std::vector<std::deque<Task>> s_queues{};
+    static inline std::vector<std::unique_ptr<WorkQueue>> s_queues{};
+    static inline std::atomic<std::size_t> s_nextQueue{0};
     static inline std::condition_variable s_cv{};
     static inline std::mutex s_cvMutex{};
     static inline std::atomic<bool> s_running{false};
+    static inline std::atomic<std::size_t> s_workerCount{0};
+    static inline thread_local std::size_t s_workerIndex{0};
 };
 
 } // namespace core::jobs
@@ -5,6 +5,10 @@
 #include <cmath>
 #include <cstddef>
 
+#if defined(__SSE2__)
+#include <immintrin.h> // inverseFast
+#endif
+
 namespace core::math {
 
 /* --------------------------------------------------------------------------
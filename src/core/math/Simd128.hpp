@@ -1,4 +1,5 @@
 #pragma once
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -17,6 +18,8 @@ struct Float4 {
 
     Float4() : v(_mm_setzero_ps()) {
     }
+    Float4(pack p) : v(p) {
+    }
     explicit Float4(float f) : v(_mm_set1_ps(f)) {
     }
     Float4(float x, float y, float z, float w) : v(_mm_set_ps(w, z, y, x)) {
@@ -44,7 +47,7 @@ struct Float4 {
     }
 
     float sum() const {
-        __m128 shuf = _mm_movehdup_ps(v);
+        __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); // SSE2 only – no movehdup
         __m128 sums = _mm_add_ps(v, shuf);
         shuf = _mm_movehl_ps(shuf, sums);
         sums = _mm_add_ss(sums, shuf);
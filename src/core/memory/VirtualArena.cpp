@@ -0,0 +1,124 @@
+#include "core/memory/VirtualArena.hpp"
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace core::memory {
+
+namespace {
+
+std::size_t roundUp(std::size_t v, std::size_t to) {
+    return (v + to - 1) / to * to;
+}
+
+#if defined(_WIN32)
+void* osReserve(std::size_t bytes) {
+    return VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+}
+bool osCommit(void* p, std::size_t bytes) {
+    return VirtualAlloc(p, bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+void osDecommit(void* p, std::size_t bytes) {
+    VirtualFree(p, bytes, MEM_DECOMMIT);
+}
+void osRelease(void* p, std::size_t) {
+    VirtualFree(p, 0, MEM_RELEASE);
+}
+#else
+void* osReserve(std::size_t bytes) {
+    void* p = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+bool osCommit(void* p, std::size_t bytes) {
+    return mprotect(p, bytes, PROT_READ | PROT_WRITE) == 0;
+}
+void osDecommit(void* p, std::size_t bytes) {
+    /* drop the physical pages first, then make the range fault again */
+    madvise(p, bytes, MADV_DONTNEED);
+    mprotect(p, bytes, PROT_NONE);
+}
+void osRelease(void* p, std::size_t bytes) {
+    munmap(p, bytes);
+}
+#endif
+
+} // namespace
+
+std::size_t VirtualArena::pageSize() noexcept {
+#if defined(_WIN32)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwPageSize;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+VirtualArena::VirtualArena(std::size_t reserveBytes, std::size_t commitStep) {
+    const std::size_t page = pageSize();
+    m_reserved = roundUp(reserveBytes, page);
+    m_commitStep = roundUp(commitStep ? commitStep : page, page);
+    m_base = static_cast<std::byte*>(osReserve(m_reserved));
+    if (!m_base)
+        throw std::bad_alloc();
+}
+
+VirtualArena::~VirtualArena() {
+    release();
+}
+
+VirtualArena::VirtualArena(VirtualArena&& o) noexcept
+    : m_base(std::exchange(o.m_base, nullptr)), m_reserved(std::exchange(o.m_reserved, 0)),
+      m_committed(std::exchange(o.m_committed, 0)), m_offset(std::exchange(o.m_offset, 0)),
+      m_commitStep(o.m_commitStep) {
+}
+
+VirtualArena& VirtualArena::operator=(VirtualArena&& o) noexcept {
+    if (this != &o) {
+        release();
+        m_base = std::exchange(o.m_base, nullptr);
+        m_reserved = std::exchange(o.m_reserved, 0);
+        m_committed = std::exchange(o.m_committed, 0);
+        m_offset = std::exchange(o.m_offset, 0);
+        m_commitStep = o.m_commitStep;
+    }
+    return *this;
+}
+
+bool VirtualArena::commit(std::size_t bytes) noexcept {
+    if (bytes > m_reserved)
+        return false;
+    /* grow in whole steps to keep syscalls off the hot path */
+    std::size_t target = roundUp(bytes, m_commitStep);
+    if (target > m_reserved)
+        target = m_reserved;
+    if (!osCommit(m_base + m_committed, target - m_committed))
+        return false;
+    m_committed = target;
+    return true;
+}
+
+void VirtualArena::reset(std::size_t keepBytes) noexcept {
+    m_offset = 0;
+    const std::size_t keep = roundUp(keepBytes, pageSize());
+    if (keep >= m_committed)
+        return;
+    osDecommit(m_base + keep, m_committed - keep);
+    m_committed = keep;
+}
+
+void VirtualArena::release() noexcept {
+    if (m_base)
+        osRelease(m_base, m_reserved);
+    m_base = nullptr;
+    m_reserved = m_committed = m_offset = 0;
+}
+
+} // namespace core::memory
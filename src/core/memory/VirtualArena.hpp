@@ -0,0 +1,80 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace core::memory {
+
+/* ---------------------------------------------------------------
+   Growable bump arena backed by a reserved virtual range
+   * ctor     – reserves address space only (PROT_NONE / MEM_RESERVE)
+   * alloc()  – commits pages on demand; pointers never move
+   * clear()  – rewinds, keeps committed pages for the next level/frame
+   * reset()  – rewinds and hands pages beyond keepBytes back to the OS
+-----------------------------------------------------------------*/
+class VirtualArena {
+  public:
+    static constexpr std::size_t kDefaultCommitStep = 64 * 1024;
+
+    VirtualArena() = default;
+    explicit VirtualArena(std::size_t reserveBytes, std::size_t commitStep = kDefaultCommitStep);
+    ~VirtualArena();
+
+    VirtualArena(const VirtualArena&) = delete;
+    VirtualArena& operator=(const VirtualArena&) = delete;
+    VirtualArena(VirtualArena&& o) noexcept;
+    VirtualArena& operator=(VirtualArena&& o) noexcept;
+
+    /* nullptr once the reservation is exhausted (asserts in debug) */
+    void* alloc(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) noexcept {
+        const std::size_t aligned = (m_offset + align - 1) & ~(align - 1);
+        const std::size_t newOff = aligned + bytes;
+        if (newOff > m_committed && !commit(newOff)) {
+            assert(false && "VirtualArena reservation exhausted");
+            return nullptr;
+        }
+        m_offset = newOff;
+        return m_base + aligned;
+    }
+
+    template <typename T> T* allocArray(std::size_t count) noexcept {
+        return static_cast<T*>(alloc(sizeof(T) * count, alignof(T)));
+    }
+
+    /* Scoped rollback: everything allocated after marker() is dropped by rewind(). */
+    std::size_t marker() const noexcept {
+        return m_offset;
+    }
+    void rewind(std::size_t marker) noexcept {
+        assert(marker <= m_offset);
+        m_offset = marker;
+    }
+
+    void clear() noexcept {
+        m_offset = 0;
+    }
+    void reset(std::size_t keepBytes = 0) noexcept;
+
+    std::size_t used() const noexcept {
+        return m_offset;
+    }
+    std::size_t committed() const noexcept {
+        return m_committed;
+    }
+    std::size_t reserved() const noexcept {
+        return m_reserved;
+    }
+    static std::size_t pageSize() noexcept;
+
+  private:
+    bool commit(std::size_t bytes) noexcept;
+    void release() noexcept;
+
+    std::byte* m_base{nullptr};
+    std::size_t m_reserved{0};
+    std::size_t m_committed{0};
+    std::size_t m_offset{0};
+    std::size_t m_commitStep{kDefaultCommitStep};
+};
+
+} // namespace core::memory
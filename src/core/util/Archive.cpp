@@ -0,0 +1,213 @@
+#include "core/util/Archive.h"
+#include "core/util/Lz4.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace core::util {
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t v, std::uint64_t a) noexcept {
+    return (v + a - 1) & ~(a - 1);
+}
+
+/* [offset, offset + size) ⊆ [0, limit) without the sum wrapping */
+bool within(std::uint64_t offset, std::uint64_t size, std::uint64_t limit) noexcept {
+    return offset <= limit && size <= limit - offset;
+}
+
+} // namespace
+
+/* ---------------------------------------------------------------- Archive */
+Archive::Archive(const std::filesystem::path& path) : m_file(path, MappedFile::Access::Random) {
+    const auto fail = [&](const char* why) {
+        throw std::runtime_error("Invalid archive " + path.string() + ": " + why);
+    };
+    if (m_file.size() < sizeof(ArchiveHeader))
+        fail("truncated header");
+
+    const ArchiveHeader& h = header();
+    if (h.magic != ArchiveHeader::kMagic)
+        fail("bad magic");
+    if (h.version != ArchiveHeader::kVersion)
+        fail("unsupported version");
+    if (h.fileSize != m_file.size())
+        fail("size mismatch");
+    if (!std::has_single_bit(h.tableSize) || h.entryCount >= h.tableSize)
+        fail("bad table size");
+    if (sizeof(ArchiveHeader) + std::uint64_t{h.tableSize} * sizeof(ArchiveEntry) > h.namesOffset ||
+        !within(h.namesOffset, h.namesSize, h.fileSize))
+        fail("bad layout");
+
+    /* every range is checked here once, so lookups and reads can trust the table */
+    std::uint32_t entries = 0;
+    for (const ArchiveEntry& e : table()) {
+        if (!e.hash)
+            continue;
+        if (!within(e.offset, e.storedSize, h.fileSize) || !within(e.nameOffset, e.nameLength, h.namesSize))
+            fail("entry out of bounds");
+        ++entries;
+    }
+    if (entries != h.entryCount)
+        fail("entry count mismatch");
+}
+
+const ArchiveEntry* Archive::find(std::string_view name) const noexcept {
+    const auto slots = table();
+    const std::uint64_t hash = archiveHash(name);
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t i = hash & mask, probes = 0; probes < slots.size(); i = (i + 1) & mask, ++probes) {
+        const ArchiveEntry& e = slots[i];
+        if (!e.hash)
+            return nullptr;
+        if (e.hash == hash && this->name(e) == name)
+            return &e;
+    }
+    return nullptr;
+}
+
+std::string_view Archive::name(const ArchiveEntry& e) const noexcept {
+    const ArchiveHeader& h = header();
+    return {reinterpret_cast<const char*>(m_file.data() + h.namesOffset + e.nameOffset), e.nameLength};
+}
+
+std::span<const std::byte> Archive::view(std::string_view name) const noexcept {
+    const ArchiveEntry* e = find(name);
+    if (!e || e->compression != Compression::None)
+        return {};
+    return stored(*e);
+}
+
+std::vector<std::byte> Archive::read(std::string_view name) const {
+    const ArchiveEntry* e = find(name);
+    if (!e)
+        throw std::runtime_error("Archive entry not found: " + std::string{name});
+    std::vector<std::byte> out(e->size);
+    read(*e, out);
+    return out;
+}
+
+void Archive::read(const ArchiveEntry& e, std::span<std::byte> dst) const {
+    if (dst.size() != e.size)
+        throw std::runtime_error("Archive read: destination size mismatch");
+
+    const auto src = stored(e);
+    switch (e.compression) {
+    case Compression::None:
+        if (src.size() != dst.size())
+            break;
+        if (!src.empty())
+            std::memcpy(dst.data(), src.data(), src.size());
+        return;
+    case Compression::LZ4:
+        if (lz4::decompress(src, dst))
+            return;
+        break;
+    default:
+        throw std::runtime_error("Archive entry uses an unsupported codec: " + std::string{name(e)});
+    }
+    throw std::runtime_error("Archive entry is corrupt: " + std::string{name(e)});
+}
+
+/* ---------------------------------------------------------------- ArchiveWriter */
+ArchiveWriter::ArchiveWriter(std::uint32_t alignment) : m_alignment(alignment) {
+    if (!std::has_single_bit(alignment))
+        throw std::invalid_argument("Archive alignment must be a power of two");
+}
+
+void ArchiveWriter::add(std::string name, std::span<const std::byte> data, Compression c) {
+    if (name.size() > 0xFFFF)
+        throw std::invalid_argument("Archive entry name too long: " + name);
+
+    Pending p{std::move(name), {}, data.size(), Compression::None};
+    if (c == Compression::LZ4 && !data.empty()) {
+        p.blob.resize(lz4::compressBound(data.size()));
+        const std::size_t n = lz4::compress(data, p.blob);
+        if (n && n < data.size() - data.size() / 20) {
+            p.blob.resize(n);
+            p.compression = Compression::LZ4;
+        }
+    } else if (c == Compression::Zstd) {
+        throw std::invalid_argument("Zstd compression is not available in this build");
+    }
+    if (p.compression == Compression::None)
+        p.blob.assign(data.begin(), data.end());
+    m_entries.push_back(std::move(p));
+}
+
+std::uint64_t ArchiveWriter::storedBytes() const noexcept {
+    std::uint64_t total = 0;
+    for (const Pending& p : m_entries)
+        total += p.blob.size();
+    return total;
+}
+
+void ArchiveWriter::write(const std::filesystem::path& path) const {
+    const auto tableSize = static_cast<std::uint32_t>(std::bit_ceil(std::max<std::size_t>(m_entries.size() * 2, 2)));
+    std::vector<ArchiveEntry> table(tableSize, ArchiveEntry{});
+    std::string names;
+
+    ArchiveHeader h{};
+    h.magic = ArchiveHeader::kMagic;
+    h.version = ArchiveHeader::kVersion;
+    h.entryCount = static_cast<std::uint32_t>(m_entries.size());
+    h.tableSize = tableSize;
+    h.alignment = m_alignment;
+    h.namesOffset = sizeof(ArchiveHeader) + std::uint64_t{tableSize} * sizeof(ArchiveEntry);
+    for (const Pending& p : m_entries)
+        h.namesSize += p.name.size();
+
+    /* place blobs and insert into the hash table */
+    std::uint64_t cursor = alignUp(h.namesOffset + h.namesSize, m_alignment);
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(m_entries.size());
+    for (const Pending& p : m_entries) {
+        ArchiveEntry e{};
+        e.hash = archiveHash(p.name);
+        e.offset = cursor;
+        e.storedSize = p.blob.size();
+        e.size = p.size;
+        e.nameOffset = static_cast<std::uint32_t>(names.size());
+        e.nameLength = static_cast<std::uint16_t>(p.name.size());
+        e.compression = p.compression;
+        names += p.name;
+        offsets.push_back(cursor);
+        cursor = alignUp(cursor + p.blob.size(), m_alignment);
+
+        for (std::size_t i = e.hash & (tableSize - 1);; i = (i + 1) & (tableSize - 1)) {
+            ArchiveEntry& slot = table[i];
+            if (!slot.hash) {
+                slot = e;
+                break;
+            }
+            if (slot.hash == e.hash && std::string_view{names}.substr(slot.nameOffset, slot.nameLength) == p.name)
+                throw std::invalid_argument("Duplicate archive entry: " + p.name);
+        }
+    }
+    h.fileSize = m_entries.empty() ? h.namesOffset + h.namesSize : cursor;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Failed to create archive: " + path.string());
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(ArchiveEntry)));
+    out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+    std::uint64_t pos = h.namesOffset + h.namesSize;
+    const std::vector<char> zeros(m_alignment, 0);
+    for (std::size_t i = 0; i < m_entries.size(); ++i) {
+        out.write(zeros.data(), static_cast<std::streamsize>(offsets[i] - pos));
+        const auto& blob = m_entries[i].blob;
+        out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        pos = offsets[i] + blob.size();
+    }
+    out.write(zeros.data(), static_cast<std::streamsize>(h.fileSize - pos));
+    if (!out)
+        throw std::runtime_error("Failed to write archive: " + path.string());
+}
+
+} // namespace core::util
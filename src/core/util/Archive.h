@@ -0,0 +1,140 @@
+#pragma once
+#include "core/util/FileSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core::util {
+
+/* ---------------------------------------------------------------
+   Packed asset archive (.vepk)
+   [ArchiveHeader][TOC: tableSize × ArchiveEntry][names][blobs…]
+   * TOC is an open-addressing hash table (FNV-1a 64 of the entry
+     name, linear probing, ≤ 50 % load) – lookup is one or two probes
+     straight into the mapping; open only bounds-checks the entries
+   * Blobs start on `alignment` boundaries so uncompressed entries
+     can be consumed in place (SPIR-V, cooked GPU data …)
+   * Names are '/'-separated paths relative to the packed root
+-----------------------------------------------------------------*/
+enum class Compression : std::uint8_t {
+    None = 0,
+    LZ4 = 1,
+    Zstd = 2, // reserved – no codec in this build, rejected on read and write
+};
+
+struct ArchiveHeader {
+    static constexpr std::uint32_t kMagic = 0x4B504556; // "VEPK"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t tableSize; // power of two
+    std::uint32_t alignment; // of every blob
+    std::uint32_t reserved;
+    std::uint64_t namesOffset;
+    std::uint64_t namesSize;
+    std::uint64_t fileSize;
+};
+static_assert(sizeof(ArchiveHeader) == 48);
+
+struct ArchiveEntry {
+    std::uint64_t hash;       // 0 = empty slot
+    std::uint64_t offset;     // of the stored blob, from file start
+    std::uint64_t storedSize; // bytes in the archive
+    std::uint64_t size;       // bytes after decompression
+    std::uint32_t nameOffset; // into the names block
+    std::uint16_t nameLength;
+    Compression compression;
+    std::uint8_t reserved;
+};
+static_assert(sizeof(ArchiveEntry) == 40);
+
+/* FNV-1a 64; never returns 0 (reserved for empty TOC slots) */
+constexpr std::uint64_t archiveHash(std::string_view name) noexcept {
+    std::uint64_t h = 14695981039346656037ull;
+    for (char c : name) {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 1099511628211ull;
+    }
+    return h ? h : 1;
+}
+
+/* Read side: one open + mmap, O(1) lookups.  Throws std::runtime_error
+   on a missing or malformed file, including any entry whose blob or
+   name lies outside the file. */
+class Archive {
+  public:
+    explicit Archive(const std::filesystem::path& path);
+
+    const ArchiveEntry* find(std::string_view name) const noexcept;
+    bool contains(std::string_view name) const noexcept {
+        return find(name) != nullptr;
+    }
+
+    /* Stored bytes of an entry – zero-copy, compressed if the entry is.
+       e must come from this archive (in range by construction). */
+    std::span<const std::byte> stored(const ArchiveEntry& e) const noexcept {
+        return m_file.bytes().subspan(e.offset, e.storedSize);
+    }
+    /* In-place view of an uncompressed entry; empty if missing or compressed */
+    std::span<const std::byte> view(std::string_view name) const noexcept;
+
+    /* Decompressed copy.  Throws if the entry is missing or corrupt. */
+    std::vector<std::byte> read(std::string_view name) const;
+    void read(const ArchiveEntry& e, std::span<std::byte> dst) const; // dst.size() == e.size
+
+    std::string_view name(const ArchiveEntry& e) const noexcept;
+    std::size_t size() const noexcept {
+        return header().entryCount;
+    }
+
+    /* fn(const ArchiveEntry&) for every entry, in table order */
+    template <typename Fn> void forEach(Fn&& fn) const {
+        for (const ArchiveEntry& e : table())
+            if (e.hash)
+                fn(e);
+    }
+
+  private:
+    const ArchiveHeader& header() const noexcept {
+        return *reinterpret_cast<const ArchiveHeader*>(m_file.data());
+    }
+    std::span<const ArchiveEntry> table() const noexcept {
+        return {reinterpret_cast<const ArchiveEntry*>(m_file.data() + sizeof(ArchiveHeader)), header().tableSize};
+    }
+
+    MappedFile m_file;
+};
+
+/* Write side, used by the asset_packer tool */
+class ArchiveWriter {
+  public:
+    explicit ArchiveWriter(std::uint32_t alignment = 64);
+
+    /* Compression is dropped for entries it doesn't shrink by at least ~5 % */
+    void add(std::string name, std::span<const std::byte> data, Compression c = Compression::None);
+    void write(const std::filesystem::path& path) const; // throws on I/O failure
+
+    std::size_t size() const noexcept {
+        return m_entries.size();
+    }
+    std::uint64_t storedBytes() const noexcept; // payload total after compression
+
+  private:
+    struct Pending {
+        std::string name;
+        std::vector<std::byte> blob;
+        std::uint64_t size;
+        Compression compression;
+    };
+
+    std::uint32_t m_alignment;
+    std::vector<Pending> m_entries;
+};
+
+} // namespace core::util
@@ -0,0 +1,577 @@
+#include "core/util/AsyncIO.h"
+#include "core/util/Archive.h"
+#include "core/util/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <atomic>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define VE_HAS_IO_URING 1
+#else
+#define VE_HAS_IO_URING 0
+#endif
+
+namespace core::util {
+
+std::string IoResult::message() const {
+    return error ? std::generic_category().message(error) : std::string{"ok"};
+}
+
+namespace {
+
+struct Request {
+    IoCallback cb;
+    IoResult result;
+    std::size_t done{0}; // bytes read so far
+    const Archive* archive{nullptr}; // set when a mount holds the path
+    const ArchiveEntry* entry{nullptr};
+#if VE_HAS_IO_URING
+    int fd{-1};
+#endif
+};
+using RequestPtr = std::unique_ptr<Request>;
+
+/* Portable blocking read – fallback pool and the odd io_uring retry */
+void readBlocking(Request& r) {
+    IoResult& res = r.result;
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(res.path, ec);
+    if (ec) {
+        res.error = ec.value() ? ec.value() : ENOENT;
+        return;
+    }
+    std::FILE* f = std::fopen(res.path.string().c_str(), "rb");
+    if (!f) {
+        res.error = errno ? errno : EIO;
+        return;
+    }
+    res.size = static_cast<std::size_t>(size);
+    res.data = std::make_unique_for_overwrite<std::byte[]>(res.size);
+    r.done = std::fread(res.data.get(), 1, res.size, f);
+    if (r.done != res.size)
+        res.error = std::ferror(f) ? EIO : 0;
+    res.size = r.done; // a file that shrank under us just comes back shorter
+    std::fclose(f);
+}
+
+/* Copies or decompresses a mounted entry – runs on an I/O thread like readBlocking */
+void readArchived(Request& r) {
+    IoResult& res = r.result;
+    res.size = static_cast<std::size_t>(r.entry->size);
+    res.data = std::make_unique_for_overwrite<std::byte[]>(res.size);
+    try {
+        r.archive->read(*r.entry, {res.data.get(), res.size});
+    } catch (const std::exception&) {
+        res.size = 0;
+        res.error = EIO; // corrupt entry – don't mask it with a loose file
+    }
+}
+
+#if VE_HAS_IO_URING
+/* Minimal io_uring: one SQ/CQ pair, IORING_OP_READ only */
+class Uring {
+  public:
+    bool setup(unsigned depth) {
+        io_uring_params p{};
+        m_fd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &p));
+        if (m_fd < 0)
+            return false;
+
+        m_sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        m_cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single)
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+        m_sqRing = mapRing(m_sqRingSize, IORING_OFF_SQ_RING);
+        m_cqRing = single ? m_sqRing : mapRing(m_cqRingSize, IORING_OFF_CQ_RING);
+        m_sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mapRing(m_sqesSize, IORING_OFF_SQES);
+        if (!m_sqRing || !m_cqRing || !sqes) {
+            if (sqes)
+                munmap(sqes, m_sqesSize);
+            destroy();
+            return false;
+        }
+
+        auto* sq = static_cast<char*>(m_sqRing);
+        auto* cq = static_cast<char*>(m_cqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        m_sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+        m_capacity = p.sq_entries;
+        return true;
+    }
+
+    void destroy() {
+        if (m_sqes)
+            munmap(m_sqes, m_sqesSize);
+        if (m_cqRing && m_cqRing != m_sqRing)
+            munmap(m_cqRing, m_cqRingSize);
+        if (m_sqRing)
+            munmap(m_sqRing, m_sqRingSize);
+        if (m_fd >= 0)
+            close(m_fd);
+        m_sqes = nullptr;
+        m_sqRing = m_cqRing = nullptr;
+        m_fd = -1;
+        m_capacity = m_inKernel = m_unsubmitted = 0;
+    }
+
+    bool full() const noexcept {
+        return m_inKernel + m_unsubmitted >= m_capacity;
+    }
+    unsigned inFlight() const noexcept {
+        return m_inKernel + m_unsubmitted;
+    }
+
+    /* Queues a read of the next chunk; caller checked full() */
+    void pushRead(Request& r) {
+        constexpr std::size_t kMaxChunk = 1u << 30; // sqe len is 32 bits
+        const unsigned tail = *m_sqTail; // we are the only producer
+        const unsigned idx = tail & m_sqMask;
+        io_uring_sqe& sqe = m_sqes[idx];
+        sqe = {};
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = r.fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(r.result.data.get() + r.done);
+        sqe.len = static_cast<unsigned>(std::min(r.result.size - r.done, kMaxChunk));
+        sqe.off = r.done;
+        sqe.user_data = reinterpret_cast<std::uint64_t>(&r);
+        m_sqArray[idx] = idx;
+        std::atomic_ref<unsigned>{*m_sqTail}.store(tail + 1, std::memory_order_release);
+        ++m_unsubmitted;
+    }
+
+    /* Submits queued sqes; optionally blocks until one completion is posted.
+       Returns 0, or the errno of a failure that retrying won't clear. */
+    int enter(bool waitForOne) {
+        if (!m_unsubmitted && !waitForOne)
+            return 0;
+        const unsigned flags = waitForOne ? IORING_ENTER_GETEVENTS : 0u;
+        const long n = syscall(__NR_io_uring_enter, m_fd, m_unsubmitted, waitForOne ? 1u : 0u, flags, nullptr, 0);
+        if (n > 0) {
+            m_unsubmitted -= static_cast<unsigned>(n);
+            m_inKernel += static_cast<unsigned>(n);
+        } else if (n < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            const int err = errno;
+            Logger::error("[AsyncIO] io_uring_enter failed: {}", std::generic_category().message(err));
+            return err;
+        }
+        return 0;
+    }
+
+    /* fn(Request&, int res) for every posted completion */
+    template <typename Fn> void reap(Fn&& fn) {
+        unsigned head = *m_cqHead;
+        const unsigned tail = std::atomic_ref<unsigned>{*m_cqTail}.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+            auto* r = reinterpret_cast<Request*>(cqe.user_data);
+            const int res = cqe.res;
+            std::atomic_ref<unsigned>{*m_cqHead}.store(head + 1, std::memory_order_release);
+            --m_inKernel;
+            fn(*r, res);
+        }
+    }
+
+  private:
+    void* mapRing(std::size_t bytes, std::uint64_t offset) {
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    int m_fd{-1};
+    void* m_sqRing{nullptr};
+    void* m_cqRing{nullptr};
+    std::size_t m_sqRingSize{0}, m_cqRingSize{0}, m_sqesSize{0};
+    unsigned *m_sqHead{}, *m_sqTail{}, *m_sqArray{};
+    unsigned *m_cqHead{}, *m_cqTail{};
+    unsigned m_sqMask{0}, m_cqMask{0};
+    io_uring_sqe* m_sqes{nullptr};
+    io_uring_cqe* m_cqes{nullptr};
+    unsigned m_capacity{0};
+    unsigned m_inKernel{0};    // submitted, completion not reaped yet
+    unsigned m_unsubmitted{0}; // in the SQ, kernel hasn't consumed them yet
+};
+#endif
+
+struct IoState {
+    bool initialised{false};
+    AsyncIO::Backend backend{AsyncIO::Backend::ThreadPool};
+    std::deque<RequestPtr> queued; // read() → not handed to a backend yet
+    std::deque<RequestPtr> ready;  // finished, callback not run yet
+    std::size_t outstanding{0};
+
+    struct Mount {
+        std::filesystem::path prefix;
+        std::unique_ptr<Archive> archive;
+    };
+    std::vector<Mount> mounts; // searched last to first
+
+#if VE_HAS_IO_URING
+    Uring ring;
+    std::vector<RequestPtr> inRing; // owned while the kernel may touch the buffer
+    std::vector<std::unique_ptr<std::byte[]>> parked; // buffers of reads failed by abandonRing()
+#endif
+
+    /* thread-pool fallback; also decodes mounted entries under io_uring */
+    std::vector<std::thread> threads;
+    unsigned poolThreads{1};
+    std::mutex mutex;
+    std::condition_variable workCv;
+    std::condition_variable doneCv;
+    std::deque<RequestPtr> work;
+    std::vector<RequestPtr> finished;
+    bool stopping{false};
+
+    ~IoState();
+};
+
+IoState& state() {
+    static IoState s;
+    return s;
+}
+
+void poolWorker(IoState& s) {
+    for (;;) {
+        RequestPtr r;
+        {
+            std::unique_lock lk{s.mutex};
+            s.workCv.wait(lk, [&] { return s.stopping || !s.work.empty(); });
+            if (s.stopping)
+                return;
+            r = std::move(s.work.front());
+            s.work.pop_front();
+        }
+        if (r->entry)
+            readArchived(*r);
+        else
+            readBlocking(*r);
+        {
+            std::lock_guard lk{s.mutex};
+            s.finished.push_back(std::move(r));
+        }
+        s.doneCv.notify_one();
+    }
+}
+
+#if VE_HAS_IO_URING
+void finishRing(IoState& s, Request& r) {
+    if (r.fd >= 0)
+        close(r.fd);
+    r.fd = -1;
+    auto it = std::find_if(s.inRing.begin(), s.inRing.end(), [&](const RequestPtr& p) { return p.get() == &r; });
+    s.ready.push_back(std::move(*it));
+    *it = std::move(s.inRing.back());
+    s.inRing.pop_back();
+}
+
+/* Opens the file and sizes the buffer; false when the request already finished */
+bool openForRing(Request& r) {
+    IoResult& res = r.result;
+    r.fd = open(res.path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat st {};
+    if (r.fd < 0 || fstat(r.fd, &st) != 0) {
+        res.error = errno ? errno : EIO;
+        return false;
+    }
+    res.size = static_cast<std::size_t>(st.st_size);
+    res.data = std::make_unique_for_overwrite<std::byte[]>(res.size);
+    return res.size != 0;
+}
+
+void completeRing(IoState& s, Request& r, int res) {
+    if (res == -EINTR || res == -EAGAIN) {
+        s.ring.pushRead(r); // retry the same chunk; the slot it used was just freed
+        return;
+    }
+    if (res == -EINVAL || res == -EOPNOTSUPP) {
+        /* kernel without IORING_OP_READ (< 5.6): finish this one the slow way */
+        close(r.fd);
+        r.fd = -1;
+        r.done = 0;
+        readBlocking(r);
+    } else if (res < 0) {
+        r.result.error = -res;
+    } else if (res == 0) {
+        r.result.size = r.done; // file shrank while we were reading it
+    } else {
+        r.done += static_cast<std::size_t>(res);
+        if (r.done < r.result.size) {
+            s.ring.pushRead(r); // short read – continue where it stopped
+            return;
+        }
+    }
+    finishRing(s, r);
+}
+
+/* io_uring_enter failed for good: fail what the ring held with that errno and
+   go on with I/O threads.  The kernel may still write into those buffers, so
+   they stay parked until stop(). */
+void abandonRing(IoState& s, int err) {
+    for (RequestPtr& r : s.inRing) {
+        if (r->fd >= 0)
+            close(r->fd);
+        r->fd = -1;
+        s.parked.push_back(std::move(r->result.data));
+        r->result.size = 0;
+        r->result.error = err;
+        s.ready.push_back(std::move(r));
+    }
+    s.inRing.clear();
+    s.ring.destroy();
+    s.backend = AsyncIO::Backend::ThreadPool;
+    if (!s.initialised)
+        return; // stop() is tearing down anyway
+    while (s.threads.size() < s.poolThreads)
+        s.threads.emplace_back(poolWorker, std::ref(s));
+    Logger::warn("[AsyncIO] io_uring disabled, continuing on {} I/O threads", s.threads.size());
+}
+#endif
+
+void submitQueued(IoState& s) {
+#if VE_HAS_IO_URING
+    if (s.backend == AsyncIO::Backend::IoUring) {
+        bool decoding = false;
+        while (!s.queued.empty() && !s.ring.full()) {
+            RequestPtr r = std::move(s.queued.front());
+            s.queued.pop_front();
+            if (r->entry) {
+                std::lock_guard lk{s.mutex};
+                s.work.push_back(std::move(r));
+                decoding = true;
+                continue;
+            }
+            const bool needsRead = openForRing(*r);
+            if (!needsRead) {
+                if (r->fd >= 0)
+                    close(r->fd);
+                s.ready.push_back(std::move(r));
+                continue;
+            }
+            s.ring.pushRead(*r);
+            s.inRing.push_back(std::move(r));
+        }
+        if (decoding)
+            s.workCv.notify_all();
+        if (const int err = s.ring.enter(false))
+            abandonRing(s, err);
+        return;
+    }
+#endif
+    if (s.queued.empty())
+        return;
+    {
+        std::lock_guard lk{s.mutex};
+        for (auto& r : s.queued)
+            s.work.push_back(std::move(r));
+    }
+    s.queued.clear();
+    s.workCv.notify_all();
+}
+
+void collect(IoState& s) {
+#if VE_HAS_IO_URING
+    if (s.backend == AsyncIO::Backend::IoUring)
+        s.ring.reap([&](Request& r, int res) { completeRing(s, r, res); });
+#endif
+    std::lock_guard lk{s.mutex};
+    for (auto& r : s.finished)
+        s.ready.push_back(std::move(r));
+    s.finished.clear();
+}
+
+/* Points r at the newest mount holding its path; false if none does */
+bool findMounted(IoState& s, Request& r) {
+    const std::filesystem::path& path = r.result.path;
+    for (auto m = s.mounts.rbegin(); m != s.mounts.rend(); ++m) {
+        const std::filesystem::path rel = m->prefix.empty() ? path : path.lexically_relative(m->prefix);
+        if (rel.empty() || *rel.begin() == "..")
+            continue;
+        if (const ArchiveEntry* e = m->archive->find(rel.generic_string())) {
+            r.archive = m->archive.get();
+            r.entry = e;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t runCallbacks(IoState& s) {
+    std::size_t n = 0;
+    while (!s.ready.empty()) {
+        RequestPtr r = std::move(s.ready.front());
+        s.ready.pop_front();
+        --s.outstanding;
+        ++n;
+        if (r->cb)
+            r->cb(r->result); // may queue further reads
+    }
+    return n;
+}
+
+void stop(IoState& s) {
+    if (!s.initialised)
+        return;
+    s.initialised = false;
+
+#if VE_HAS_IO_URING
+    if (s.backend == AsyncIO::Backend::IoUring) {
+        /* the kernel may still write into our buffers – let it finish */
+        while (s.ring.inFlight()) {
+            if (const int err = s.ring.enter(true)) {
+                abandonRing(s, err);
+                break;
+            }
+            s.ring.reap([&](Request& r, int) { finishRing(s, r); });
+        }
+        s.ring.destroy();
+        s.parked.clear();
+    }
+#endif
+    {
+        std::lock_guard lk{s.mutex};
+        s.stopping = true;
+    }
+    s.workCv.notify_all();
+    for (auto& th : s.threads)
+        th.join();
+    s.threads.clear();
+    s.work.clear();
+    s.finished.clear();
+    s.queued.clear();
+    s.ready.clear();
+    s.outstanding = 0;
+    s.mounts.clear();
+}
+
+/* Runs from the static's own destructor too, so it must not go through state() */
+IoState::~IoState() {
+    stop(*this);
+}
+
+} // namespace
+
+void AsyncIO::init(unsigned queueDepth, unsigned threads, bool allowIoUring) {
+    auto& s = state();
+    if (s.initialised)
+        return;
+    s.initialised = true;
+    s.stopping = false;
+    s.poolThreads = std::max(threads, 1u);
+
+#if VE_HAS_IO_URING
+    if (allowIoUring && s.ring.setup(std::max(queueDepth, 1u))) {
+        s.backend = Backend::IoUring;
+        Logger::info("[AsyncIO] io_uring backend, queue depth {}", queueDepth);
+        return;
+    }
+    if (allowIoUring)
+        Logger::warn("[AsyncIO] io_uring unavailable ({}), using I/O threads", std::generic_category().message(errno));
+#else
+    (void)queueDepth;
+    (void)allowIoUring;
+#endif
+    s.backend = Backend::ThreadPool;
+    for (unsigned i = 0; i < s.poolThreads; ++i)
+        s.threads.emplace_back(poolWorker, std::ref(s));
+    Logger::info("[AsyncIO] thread-pool backend, {} threads", s.poolThreads);
+}
+
+void AsyncIO::shutdown() {
+    stop(state());
+}
+
+AsyncIO::Backend AsyncIO::backend() noexcept {
+    return state().backend;
+}
+
+void AsyncIO::mount(const std::filesystem::path& archive, const std::filesystem::path& prefix) {
+    auto& s = state();
+    if (!s.initialised)
+        init();
+    std::filesystem::path root = prefix.lexically_normal();
+    if (!root.empty() && !root.has_filename())
+        root = root.parent_path(); // "assets/" → "assets"
+    s.mounts.push_back({root, std::make_unique<Archive>(archive)});
+    if (s.threads.empty())
+        s.threads.emplace_back(poolWorker, std::ref(s)); // io_uring can't decompress: one thread for the entries
+    Logger::info("[AsyncIO] mounted {} ({} entries) at '{}'", archive.string(), s.mounts.back().archive->size(),
+                 prefix.string());
+}
+
+void AsyncIO::read(std::filesystem::path path, IoCallback cb) {
+    auto& s = state();
+    if (!s.initialised)
+        init();
+    auto r = std::make_unique<Request>();
+    r->cb = std::move(cb);
+    r->result.path = std::move(path);
+    ++s.outstanding;
+    findMounted(s, *r); // decoded later on an I/O thread, not here
+    s.queued.push_back(std::move(r));
+}
+
+void AsyncIO::submit() {
+    auto& s = state();
+    if (s.initialised)
+        submitQueued(s);
+}
+
+std::size_t AsyncIO::poll() {
+    auto& s = state();
+    if (!s.initialised)
+        return 0;
+    submitQueued(s);
+    collect(s);
+    submitQueued(s); // completions freed ring slots
+    return runCallbacks(s);
+}
+
+void AsyncIO::wait() {
+    auto& s = state();
+    while (s.initialised && s.outstanding) {
+        poll();
+        if (!s.outstanding)
+            break;
+        submitQueued(s); // reads queued by the callbacks that just ran
+        if (!s.ready.empty())
+            continue;
+#if VE_HAS_IO_URING
+        if (s.backend == Backend::IoUring && s.ring.inFlight()) {
+            if (const int err = s.ring.enter(true))
+                abandonRing(s, err); // in-flight reads fail with err, later ones go to the I/O threads
+            continue;
+        }
+#endif
+        std::unique_lock lk{s.mutex};
+        s.doneCv.wait(lk, [&] { return !s.finished.empty(); });
+    }
+}
+
+std::size_t AsyncIO::pending() noexcept {
+    return state().outstanding;
+}
+
+} // namespace core::util
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace core::util {
+
+/* Outcome of one AsyncIO::read – owns the file contents */
+struct IoResult {
+    std::filesystem::path path;
+    std::unique_ptr<std::byte[]> data; // uninitialised allocation, filled by the read
+    std::size_t size{0};
+    int error{0}; // errno-style code, 0 on success
+
+    bool ok() const noexcept {
+        return error == 0;
+    }
+    std::span<const std::byte> bytes() const noexcept {
+        return {data.get(), size};
+    }
+    std::string message() const;
+};
+
+using IoCallback = std::function<void(IoResult&)>;
+
+/* ---------------------------------------------------------------
+   Asynchronous whole-file reads
+   * Linux: io_uring (raw syscalls, no liburing).  Reads queued with
+     read() are handed to the kernel as one batch by submit()/poll(),
+     so hundreds of requests cost a single io_uring_enter
+   * Elsewhere, or when io_uring is unavailable (old kernel, seccomp),
+     a small pool of dedicated I/O threads does blocking reads –
+     JobSystem workers are never tied up waiting on disk
+   * Callbacks run on the thread that calls poll()/wait(), normally
+     the main loop.  read/submit/poll/wait are not thread-safe; drive
+     them from one thread
+   * Mounted .vepk archives shadow the directory they were packed
+     from: a read they hold is copied or decompressed out of the
+     mapping on an I/O thread (one is started for the io_uring backend
+     at the first mount), every other read goes to the loose file
+-----------------------------------------------------------------*/
+class AsyncIO {
+  public:
+    enum class Backend { IoUring, ThreadPool };
+
+    /* queueDepth: max requests the kernel sees at once (rest wait in a queue).
+       threads: size of the fallback pool. */
+    static void init(unsigned queueDepth = 256, unsigned threads = 2, bool allowIoUring = true);
+    static void shutdown(); // waits for in-flight reads, drops their callbacks and mounts
+    static Backend backend() noexcept;
+
+    /* Serve reads of paths under `prefix` from the archive when it has the
+       entry (named relative to prefix, as asset_packer does), from disk
+       otherwise.  Later mounts are looked at first.  Throws if the archive
+       can't be opened. */
+    static void mount(const std::filesystem::path& archive, const std::filesystem::path& prefix = {});
+
+    /* Queues a read of the entire file; cb runs from a later poll()/wait().
+       Nothing is submitted until submit(), poll() or wait(). */
+    static void read(std::filesystem::path path, IoCallback cb);
+
+    static void submit();        // hands every queued read to the backend
+    static std::size_t poll();   // submit() + run callbacks of finished reads; never blocks
+    static void wait();          // blocks until every read issued so far has called back
+    static std::size_t pending() noexcept; // reads issued whose callback hasn't run yet
+};
+
+} // namespace core::util
@@ -1,2 +1,117 @@
 #include "core/util/FileSystem.h"
-// header-only; nothing here yet
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::util {
+
+#if defined(_WIN32)
+MappedFile::MappedFile(const std::filesystem::path& p, Access hint) {
+    const DWORD flags = hint == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+    HANDLE file = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Failed to open file: " + p.string());
+
+    LARGE_INTEGER size{};
+    GetFileSizeEx(file, &size);
+    m_file = file;
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    m_open = true;
+    if (m_size == 0)
+        return; // nothing to map; bytes() is an empty span
+
+    m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_data = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!m_data) {
+        close();
+        throw std::runtime_error("Failed to map file: " + p.string());
+    }
+}
+
+void MappedFile::close() noexcept {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file)
+        CloseHandle(m_file);
+    m_data = m_mapping = m_file = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+#else
+MappedFile::MappedFile(const std::filesystem::path& p, Access hint) {
+    const int fd = ::open(p.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("Failed to open file: " + p.string());
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat file: " + p.string());
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    m_open = true;
+    if (m_size == 0) {
+        ::close(fd);
+        return; // nothing to map; bytes() is an empty span
+    }
+
+    void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps its own reference
+    if (addr == MAP_FAILED) {
+        m_size = 0;
+        m_open = false;
+        throw std::runtime_error("Failed to map file: " + p.string());
+    }
+    m_data = addr;
+
+    if (hint == Access::Sequential) {
+        madvise(m_data, m_size, MADV_SEQUENTIAL);
+        madvise(m_data, m_size, MADV_WILLNEED);
+    } else {
+        madvise(m_data, m_size, MADV_RANDOM);
+    }
+}
+
+void MappedFile::close() noexcept {
+    if (m_data)
+        munmap(m_data, m_size);
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& o) noexcept {
+    *this = std::move(o);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& o) noexcept {
+    if (this != &o) {
+        close();
+        m_data = std::exchange(o.m_data, nullptr);
+        m_size = std::exchange(o.m_size, 0);
+        m_open = std::exchange(o.m_open, false);
+#if defined(_WIN32)
+        m_file = std::exchange(o.m_file, nullptr);
+        m_mapping = std::exchange(o.m_mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+} // namespace core::util
@@ -1,25 +1,71 @@
 #pragma once
+#include <cstddef>
 #include <filesystem>
-#include <fstream>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace core::util {
 
+/* ---------------------------------------------------------------
+   Read-only memory map of a whole file (RAII, move-only)
+   * bytes() views the page cache directly – no copy, no zero-fill
+   * Sequential hints MADV_SEQUENTIAL + MADV_WILLNEED (readahead),
+     Random hints MADV_RANDOM for TOC-style lookups
+   * Throws std::runtime_error when the file can't be opened/mapped
+-----------------------------------------------------------------*/
+class MappedFile {
+  public:
+    enum class Access { Sequential, Random };
+
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& p, Access hint = Access::Sequential);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& o) noexcept;
+    MappedFile& operator=(MappedFile&& o) noexcept;
+
+    std::span<const std::byte> bytes() const noexcept {
+        return {static_cast<const std::byte*>(m_data), m_size};
+    }
+    const std::byte* data() const noexcept {
+        return static_cast<const std::byte*>(m_data);
+    }
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+    bool isOpen() const noexcept {
+        return m_open;
+    }
+
+  private:
+    void close() noexcept;
+
+    void* m_data{nullptr};
+    std::size_t m_size{0};
+    bool m_open{false};
+#if defined(_WIN32)
+    void* m_file{nullptr};
+    void* m_mapping{nullptr};
+#endif
+};
+
 /* Minimal static helpers – grow as needed */
 class FileSystem {
   public:
-    /* Entire file → std::vector<char>.  Throws on failure. */
+    /* Entire file → std::vector<char>.  Throws on failure.
+       Prefer map() for large files – this copies. */
     static std::vector<char> readBinary(const std::filesystem::path& p) {
-        std::ifstream file(p, std::ios::binary | std::ios::ate);
-        if (!file)
-            throw std::runtime_error("Failed to open file: " + p.string());
-
-        const std::size_t size = static_cast<std::size_t>(file.tellg());
-        std::vector<char> data(size);
-        file.seekg(0);
-        file.read(data.data(), size);
-        return data;
+        const MappedFile file{p};
+        const auto* first = reinterpret_cast<const char*>(file.data());
+        return std::vector<char>(first, first + file.size());
+    }
+
+    /* Zero-copy view of the entire file.  Throws on failure. */
+    static MappedFile map(const std::filesystem::path& p, MappedFile::Access hint = MappedFile::Access::Sequential) {
+        return MappedFile{p, hint};
     }
 
     static bool exists(const std::filesystem::path& p) noexcept {
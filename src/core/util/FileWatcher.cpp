@@ -0,0 +1,196 @@
+#include "core/util/FileWatcher.h"
+#include "core/util/Logger.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define VE_HAS_INOTIFY 1
+#else
+#define VE_HAS_INOTIFY 0
+#endif
+
+namespace core::util {
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Watched {
+    FileWatcher::Callback cb;
+    fs::file_time_type mtime{};
+    std::uintmax_t size{0};
+    bool exists{false};
+};
+
+fs::path normalize(const fs::path& p) {
+    std::error_code ec;
+    const fs::path abs = fs::absolute(p, ec);
+    return (ec ? p : abs).lexically_normal();
+}
+
+/* Stat a watched file; true if it differs from what we saw last */
+bool refresh(const fs::path& p, Watched& w) {
+    std::error_code ec;
+    const auto mtime = fs::last_write_time(p, ec);
+    const bool exists = !ec;
+    const auto size = exists ? fs::file_size(p, ec) : 0;
+    const bool changed = exists != w.exists || (exists && (mtime != w.mtime || size != w.size));
+    w.exists = exists;
+    w.mtime = exists ? mtime : fs::file_time_type{};
+    w.size = exists && !ec ? size : 0;
+    return changed;
+}
+
+} // namespace
+
+struct FileWatcher::State {
+    std::chrono::milliseconds debounce;
+    std::chrono::milliseconds pollInterval;
+    Backend backend{Backend::Polling};
+
+    std::mutex mutex;
+    std::condition_variable wake; // polling backend: stop requests
+    std::map<fs::path, Watched> files;
+    std::map<fs::path, Clock::time_point> pending; // last change seen per file
+    std::atomic<bool> running{true};
+    std::thread thread;
+
+#if VE_HAS_INOTIFY
+    int fd{-1};
+    std::unordered_map<int, fs::path> dirs; // watch descriptor → directory
+
+    void inotifyLoop() {
+        alignas(inotify_event) char buf[16 * 1024];
+        while (running.load(std::memory_order_acquire)) {
+            pollfd pfd{fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 100) <= 0)
+                continue; // timeout (re-check running) or EINTR
+            const ssize_t n = ::read(fd, buf, sizeof(buf));
+            if (n <= 0)
+                continue;
+            const auto now = Clock::now();
+            std::lock_guard lock(mutex);
+            for (ssize_t off = 0; off < n;) {
+                const auto* ev = reinterpret_cast<const inotify_event*>(buf + off);
+                off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+                if (ev->mask & IN_Q_OVERFLOW) { // lost events: assume everything changed
+                    for (const auto& [path, w] : files)
+                        pending[path] = now;
+                    continue;
+                }
+                const auto dir = dirs.find(ev->wd);
+                if (dir == dirs.end() || ev->len == 0)
+                    continue;
+                const fs::path path = dir->second / ev->name;
+                if (files.contains(path))
+                    pending[path] = now;
+            }
+        }
+    }
+#endif
+
+    void pollingLoop() {
+        std::unique_lock lock(mutex);
+        while (running.load(std::memory_order_acquire)) {
+            wake.wait_for(lock, pollInterval);
+            const auto now = Clock::now();
+            for (auto& [path, w] : files)
+                if (refresh(path, w))
+                    pending[path] = now;
+        }
+    }
+};
+
+FileWatcher::FileWatcher(std::chrono::milliseconds debounce, bool allowInotify, std::chrono::milliseconds pollInterval)
+    : m_state(std::make_unique<State>()) {
+    State& s = *m_state;
+    s.debounce = debounce;
+    s.pollInterval = pollInterval;
+#if VE_HAS_INOTIFY
+    if (allowInotify) {
+        s.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (s.fd >= 0)
+            s.backend = Backend::Inotify;
+        else
+            Logger::warn("[FileWatcher] inotify unavailable ({}), polling instead",
+                         std::generic_category().message(errno));
+    }
+    if (s.backend == Backend::Inotify) {
+        s.thread = std::thread([&s] { s.inotifyLoop(); });
+        return;
+    }
+#else
+    (void)allowInotify;
+#endif
+    s.thread = std::thread([&s] { s.pollingLoop(); });
+}
+
+FileWatcher::~FileWatcher() {
+    {
+        std::lock_guard lock(m_state->mutex);
+        m_state->running.store(false, std::memory_order_release);
+    }
+    m_state->wake.notify_all();
+    m_state->thread.join();
+#if VE_HAS_INOTIFY
+    if (m_state->fd >= 0)
+        ::close(m_state->fd);
+#endif
+}
+
+void FileWatcher::watch(const fs::path& file, Callback cb) {
+    State& s = *m_state;
+    const fs::path path = normalize(file);
+    std::lock_guard lock(s.mutex);
+    Watched& w = s.files[path];
+    w.cb = std::move(cb);
+    refresh(path, w);
+#if VE_HAS_INOTIFY
+    if (s.backend != Backend::Inotify)
+        return;
+    const fs::path dir = path.parent_path();
+    const int wd = inotify_add_watch(s.fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0)
+        Logger::warn("[FileWatcher] Cannot watch {}: {}", dir.string(), std::generic_category().message(errno));
+    else
+        s.dirs[wd] = dir; // same directory twice yields the same descriptor
+#endif
+}
+
+std::size_t FileWatcher::poll() {
+    State& s = *m_state;
+    std::vector<std::pair<fs::path, Callback>> ready;
+    {
+        const auto now = Clock::now();
+        std::lock_guard lock(s.mutex);
+        for (auto it = s.pending.begin(); it != s.pending.end();) {
+            if (now - it->second < s.debounce) {
+                ++it;
+                continue;
+            }
+            ready.emplace_back(it->first, s.files.at(it->first).cb);
+            it = s.pending.erase(it);
+        }
+    }
+    for (const auto& [path, cb] : ready) // outside the lock: callbacks may watch() more files
+        cb(path);
+    return ready.size();
+}
+
+FileWatcher::Backend FileWatcher::backend() const noexcept {
+    return m_state->backend;
+}
+
+} // namespace core::util
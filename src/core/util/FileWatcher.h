@@ -0,0 +1,49 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+namespace core::util {
+
+/* ---------------------------------------------------------------
+   Background file watcher for hot reload
+   * Linux: inotify on the parent directory of every watched file
+     (IN_CLOSE_WRITE / IN_MOVED_TO), so editors that save through a
+     rename are picked up too
+   * Elsewhere, or when inotify is unavailable, a thread stats the
+     watched files every pollInterval and compares mtime + size
+   * Changes are coalesced: a file fires once it has been quiet for
+     `debounce`, however many writes the save took
+   * Callbacks run on the thread that calls poll(), normally the
+     main loop at a frame boundary – never on the watcher thread.
+     watch() and poll() may be called from any one thread
+-----------------------------------------------------------------*/
+class FileWatcher {
+  public:
+    enum class Backend { Inotify, Polling };
+    using Callback = std::function<void(const std::filesystem::path&)>;
+
+    explicit FileWatcher(std::chrono::milliseconds debounce = std::chrono::milliseconds{100},
+                         bool allowInotify = true,
+                         std::chrono::milliseconds pollInterval = std::chrono::milliseconds{250});
+    ~FileWatcher(); // joins the watcher thread
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /* The file doesn't need to exist yet; its directory does for inotify */
+    void watch(const std::filesystem::path& file, Callback cb);
+
+    /* Runs the callbacks of every settled change; never blocks.  Returns how many ran. */
+    std::size_t poll();
+
+    Backend backend() const noexcept;
+
+  private:
+    struct State;
+    std::unique_ptr<State> m_state;
+};
+
+} // namespace core::util
@@ -0,0 +1,62 @@
+#include "core/util/FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace core::util {
+
+namespace {
+
+/* nearest-rank percentile on an already sorted range */
+double percentile(const std::vector<double>& sorted, double p) {
+    const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // namespace
+
+bool FrameStats::record(double seconds) noexcept {
+    const bool hitch = m_count >= kMedianRefresh && seconds > m_minHitch && seconds > m_median * m_hitchFactor;
+    if (hitch)
+        ++m_hitches;
+
+    m_frames[m_head] = seconds;
+    m_head = (m_head + 1) % kHistory;
+    m_count = std::min(m_count + 1, kHistory);
+
+    if (++m_sinceMedian >= kMedianRefresh) {
+        m_sinceMedian = 0;
+        std::array<double, kHistory> scratch;
+        std::copy_n(m_frames.begin(), m_count, scratch.begin());
+        auto mid = scratch.begin() + m_count / 2;
+        std::nth_element(scratch.begin(), mid, scratch.begin() + m_count);
+        m_median = *mid;
+    }
+    return hitch;
+}
+
+FrameSummary FrameStats::summary() const {
+    FrameSummary s;
+    s.frames = m_count;
+    s.hitches = m_hitches;
+    if (!m_count)
+        return s;
+
+    std::vector<double> sorted(m_frames.begin(), m_frames.begin() + m_count);
+    std::sort(sorted.begin(), sorted.end());
+    s.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(m_count);
+    s.p50 = percentile(sorted, 0.50);
+    s.p95 = percentile(sorted, 0.95);
+    s.p99 = percentile(sorted, 0.99);
+    s.max = sorted.back();
+    return s;
+}
+
+void FrameStats::reset() noexcept {
+    m_head = m_count = m_sinceMedian = 0;
+    m_hitches = 0;
+    m_median = 0;
+}
+
+} // namespace core::util
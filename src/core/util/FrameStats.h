@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace core::util {
+
+/* Rolling summary over the frames currently held in FrameStats */
+struct FrameSummary {
+    std::size_t frames{0};
+    double mean{0}, p50{0}, p95{0}, p99{0}, max{0}; // seconds
+    std::uint64_t hitches{0};                        // since reset()
+};
+
+/* ---------------------------------------------------------------
+   Frame-pacing history
+   * record() is O(1): one ring write + a hitch check
+   * summary() sorts a copy of the ring – call it when reporting,
+     not every frame
+   * A hitch is a frame longer than hitchFactor × the rolling median
+     (and longer than minHitchSeconds, so 1 ms → 2.5 ms isn't one)
+-----------------------------------------------------------------*/
+class FrameStats {
+  public:
+    static constexpr std::size_t kHistory = 512;
+
+    /* Returns true when this frame counts as a hitch. */
+    bool record(double seconds) noexcept;
+    FrameSummary summary() const;
+    void reset() noexcept;
+
+    void setHitchThreshold(double factor, double minSeconds) noexcept {
+        m_hitchFactor = factor;
+        m_minHitch = minSeconds;
+    }
+
+    std::size_t size() const noexcept {
+        return m_count;
+    }
+    double last() const noexcept {
+        return m_count ? m_frames[(m_head + kHistory - 1) % kHistory] : 0.0;
+    }
+
+  private:
+    std::array<double, kHistory> m_frames{};
+    std::size_t m_head{0};
+    std::size_t m_count{0};
+    std::uint64_t m_hitches{0};
+
+    /* median is refreshed every kMedianRefresh frames – cheap and stable enough */
+    static constexpr std::size_t kMedianRefresh = 32;
+    std::size_t m_sinceMedian{0};
+    double m_median{0};
+
+    double m_hitchFactor{2.0};
+    double m_minHitch{0.004};
+};
+
+} // namespace core::util
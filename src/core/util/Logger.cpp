@@ -1,2 +1,437 @@
 #include "core/util/Logger.h"
-// nothing else; all logic is header-only templates
+#include "core/util/MpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core::util {
+
+namespace {
+
+constexpr std::size_t kRingSlots = 4096; // × 320 B cells (record + sequence, line-aligned) ≈ 1.25 MiB
+constexpr std::size_t kMaxBatch = 256;
+constexpr auto kIdleWait = std::chrono::milliseconds(2);
+
+struct LoggerState {
+    MpscRing<LogRecord, kRingSlots> ring;
+
+    std::string tag{"ULT_GFX"};
+    std::atomic<LogLevel> level{LogLevel::Debug};
+
+    std::mutex sinkMutex; // guards sinks; held by whoever is writing
+    std::vector<std::unique_ptr<LogSink>> sinks;
+
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wake;    // producers → worker (errors / flush requests)
+    std::condition_variable drained; // worker → flush()
+
+    std::atomic<int> pushing{0}; // producers between their running check and push
+    std::atomic<std::uint64_t> pushed{0};
+    std::atomic<std::uint64_t> popped{0};
+    std::atomic<std::uint64_t> dropped{0};
+
+    /* state() is already being torn down here – stop through this */
+    ~LoggerState();
+};
+
+LoggerState& state() {
+    static LoggerState s;
+    return s;
+}
+
+std::atomic<std::uint32_t> g_nextThreadId{0};
+
+const char* levelPrefix(LogLevel lvl) {
+    switch (lvl) {
+    case LogLevel::Debug:
+        return "[D]";
+    case LogLevel::Info:
+        return "[I]";
+    case LogLevel::Warn:
+        return "[W]";
+    default:
+        return "[E]";
+    }
+}
+
+std::int64_t nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+/* "HH:MM:SS.uuuuuu [I] tag #tid: " */
+void appendHead(std::string& out, const std::string& tag, std::int64_t timestampNs, std::uint32_t threadId,
+                LogLevel level) {
+    const std::time_t secs = static_cast<std::time_t>(timestampNs / 1'000'000'000);
+    const long micros = static_cast<long>((timestampNs % 1'000'000'000) / 1000);
+    std::tm tm{};
+#if defined(_WIN32)
+    localtime_s(&tm, &secs);
+#else
+    localtime_r(&secs, &tm);
+#endif
+    char head[64];
+    const int n = std::snprintf(head, sizeof(head), "%02d:%02d:%02d.%06ld %s ", tm.tm_hour, tm.tm_min, tm.tm_sec,
+                                micros, levelPrefix(level));
+    out.append(head, static_cast<std::size_t>(n));
+    out.append(tag);
+    out.append(" #");
+    out.append(std::to_string(threadId));
+    out.append(": ");
+}
+
+/* "HH:MM:SS.uuuuuu [I] tag #tid: text\n" */
+void appendLine(std::string& out, const std::string& tag, const LogRecord& r) {
+    appendHead(out, tag, r.timestampNs, r.threadId, r.level);
+    if (r.decode) {
+        try {
+            r.decode(out, std::string_view{r.format, r.formatLength}, r.payload);
+        } catch (...) {
+            out.append("(log formatting failed)");
+        }
+    } else {
+        out.append(reinterpret_cast<const char*>(r.payload), r.length);
+    }
+    out.push_back('\n');
+}
+
+void fillHeader(LogRecord& r, LogLevel lvl) {
+    r.timestampNs = nowNs();
+    r.threadId = Logger::threadId();
+    r.level = lvl;
+}
+
+void fillRecord(LogRecord& r, LogLevel lvl, std::string_view text) {
+    fillHeader(r, lvl);
+    r.format = nullptr;
+    r.decode = nullptr;
+    r.formatLength = 0;
+    if (text.size() <= LogRecord::kPayloadBytes) {
+        r.length = static_cast<std::uint16_t>(text.size());
+        std::memcpy(r.payload, text.data(), r.length);
+        return;
+    }
+    /* callers keep long text out of records; should one slip through, say so */
+    static constexpr std::string_view kCut = "…";
+    std::size_t keep = LogRecord::kPayloadBytes - kCut.size();
+    while (keep > 0 && (static_cast<unsigned char>(text[keep]) & 0xC0) == 0x80)
+        --keep; // don't split a UTF-8 sequence
+    std::memcpy(r.payload, text.data(), keep);
+    std::memcpy(r.payload + keep, kCut.data(), kCut.size());
+    r.length = static_cast<std::uint16_t>(keep + kCut.size());
+}
+
+struct EncodedArgs {
+    std::string_view fmt;
+    LogDecodeFn decode;
+    std::size_t bytes;
+    void* ctx;
+    void (*encode)(std::byte*, void*);
+};
+
+void fillRecord(LogRecord& r, LogLevel lvl, const EncodedArgs& a) {
+    fillHeader(r, lvl);
+    r.format = a.fmt.data();
+    r.formatLength = static_cast<std::uint32_t>(a.fmt.size());
+    r.decode = a.decode;
+    r.length = static_cast<std::uint16_t>(a.bytes);
+    a.encode(r.payload, a.ctx);
+}
+
+void writeToSinks(LoggerState& s, std::string_view batch, bool flushSinks) {
+    std::lock_guard lk{s.sinkMutex};
+    if (s.sinks.empty())
+        s.sinks.push_back(std::make_unique<StderrSink>());
+    for (auto& sink : s.sinks) {
+        sink->write(batch);
+        if (flushSinks)
+            sink->flush();
+    }
+}
+
+/* Synchronous path: early start-up, tools, tests, or a ring that can't drain */
+template <typename Payload> void writeSync(LoggerState& s, LogLevel lvl, const Payload& payload) {
+    std::string line;
+    if constexpr (std::is_same_v<Payload, std::string_view>) {
+        appendHead(line, s.tag, nowNs(), Logger::threadId(), lvl); // text of any length
+        line.append(payload);
+        line.push_back('\n');
+    } else {
+        LogRecord r;
+        fillRecord(r, lvl, payload);
+        appendLine(line, s.tag, r);
+    }
+    writeToSinks(s, line, lvl == LogLevel::Error);
+}
+
+/* Blocks (≤ 1 s) until the worker has written the first `target` records */
+void waitDrained(LoggerState& s, std::uint64_t target) {
+    s.wake.notify_all();
+    std::unique_lock lk{s.wakeMutex};
+    s.drained.wait_for(lk, std::chrono::seconds(1), [&] {
+        return s.popped.load(std::memory_order_acquire) >= target || !s.running.load();
+    });
+}
+
+/* popped only moves under wakeMutex, so waitDrained() can't miss the wake-up */
+void markPopped(LoggerState& s, std::size_t n) {
+    {
+        std::lock_guard lk{s.wakeMutex};
+        s.popped.fetch_add(n, std::memory_order_release);
+    }
+    s.drained.notify_all();
+}
+
+/* Pops up to kMaxBatch records into one string; returns the count. */
+std::size_t drainBatch(LoggerState& s, std::string& batch) {
+    std::size_t n = 0;
+    while (n < kMaxBatch && s.ring.tryPop([&](LogRecord& r) { appendLine(batch, s.tag, r); }))
+        ++n;
+    return n;
+}
+
+void workerLoop(LoggerState& s) {
+    std::string batch;
+    batch.reserve(kMaxBatch * 128);
+    std::uint64_t reportedDrops = 0;
+
+    while (s.running.load(std::memory_order_acquire)) {
+        const std::size_t n = drainBatch(s, batch);
+        if (n) {
+            writeToSinks(s, batch, false);
+            batch.clear();
+            markPopped(s, n);
+            continue;
+        }
+
+        const std::uint64_t drops = s.dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            LogRecord r;
+            char msg[64];
+            std::snprintf(msg, sizeof(msg), "logger dropped %llu records (ring full)",
+                          static_cast<unsigned long long>(drops - reportedDrops));
+            fillRecord(r, LogLevel::Warn, msg);
+            appendLine(batch, s.tag, r);
+            writeToSinks(s, batch, false);
+            batch.clear();
+            reportedDrops = drops;
+        }
+
+        std::unique_lock lk{s.wakeMutex};
+        s.wake.wait_for(lk, kIdleWait);
+    }
+}
+
+void stop(LoggerState& s) {
+    if (!s.running.exchange(false))
+        return;
+    /* producers that saw running == true finish their push first; later
+       ones see false and write synchronously, so nothing lands after the drain */
+    while (s.pushing.load())
+        std::this_thread::yield();
+    s.wake.notify_all();
+    if (s.worker.joinable())
+        s.worker.join();
+
+    /* worker is gone – this thread is now the only consumer */
+    std::string batch;
+    while (std::size_t n = drainBatch(s, batch)) {
+        writeToSinks(s, batch, false);
+        batch.clear();
+        markPopped(s, n);
+    }
+    writeToSinks(s, {}, true);
+    {
+        std::lock_guard lk{s.wakeMutex}; // a waiter between its check and its wait sees running == false
+    }
+    s.drained.notify_all();
+}
+
+LoggerState::~LoggerState() {
+    stop(*this);
+}
+
+} // namespace
+
+/* ---------------------------------------------------------------- Sinks */
+void StderrSink::write(std::string_view batch) {
+    std::fwrite(batch.data(), 1, batch.size(), stderr);
+}
+void StderrSink::flush() {
+    std::fflush(stderr);
+}
+
+RotatingFileSink::RotatingFileSink(std::filesystem::path path, std::size_t maxBytes, unsigned maxFiles)
+    : m_path(std::move(path)), m_maxBytes(maxBytes), m_maxFiles(maxFiles) {
+    m_file = std::fopen(m_path.string().c_str(), "ab");
+    if (!m_file)
+        throw std::runtime_error("Failed to open log file: " + m_path.string());
+    std::error_code ec;
+    m_written = static_cast<std::size_t>(std::filesystem::file_size(m_path, ec));
+}
+
+RotatingFileSink::~RotatingFileSink() {
+    if (m_file)
+        std::fclose(m_file);
+}
+
+void RotatingFileSink::write(std::string_view batch) {
+    if (m_written + batch.size() > m_maxBytes && m_written > 0)
+        rotate();
+    if (!m_file)
+        return;
+    std::fwrite(batch.data(), 1, batch.size(), m_file);
+    m_written += batch.size();
+}
+
+void RotatingFileSink::flush() {
+    if (m_file)
+        std::fflush(m_file);
+}
+
+void RotatingFileSink::rotate() {
+    namespace fs = std::filesystem;
+    auto numbered = [&](unsigned i) {
+        fs::path p = m_path;
+        p.replace_filename(m_path.stem().string() + "." + std::to_string(i) + m_path.extension().string());
+        return p;
+    };
+
+    std::fclose(m_file);
+    std::error_code ec;
+    if (m_maxFiles > 0) {
+        fs::remove(numbered(m_maxFiles), ec);
+        for (unsigned i = m_maxFiles; i > 1; --i)
+            fs::rename(numbered(i - 1), numbered(i), ec);
+        fs::rename(m_path, numbered(1), ec);
+    }
+    m_file = std::fopen(m_path.string().c_str(), "wb");
+    m_written = 0;
+}
+
+/* ---------------------------------------------------------------- Logger */
+void Logger::init(std::string_view tag) {
+    auto& s = state();
+    if (s.running.load())
+        return;
+    s.tag = tag;
+    s.running.store(true, std::memory_order_release);
+    s.worker = std::thread(workerLoop, std::ref(s));
+}
+
+void Logger::shutdown() {
+    stop(state());
+}
+
+void Logger::flush() {
+    auto& s = state();
+    if (!s.running.load(std::memory_order_acquire)) {
+        writeToSinks(s, {}, true);
+        return;
+    }
+    waitDrained(s, s.pushed.load(std::memory_order_acquire));
+    writeToSinks(s, {}, true);
+}
+
+void Logger::addSink(std::unique_ptr<LogSink> sink) {
+    auto& s = state();
+    std::lock_guard lk{s.sinkMutex};
+    s.sinks.push_back(std::move(sink));
+}
+
+void Logger::removeSink(const LogSink* sink) {
+    auto& s = state();
+    std::lock_guard lk{s.sinkMutex};
+    std::erase_if(s.sinks, [&](const auto& p) { return p.get() == sink; });
+}
+
+void Logger::setLevel(LogLevel lvl) noexcept {
+    state().level.store(lvl, std::memory_order_relaxed);
+}
+
+std::uint64_t Logger::droppedCount() noexcept {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+std::uint32_t Logger::threadId() noexcept {
+    thread_local const std::uint32_t id = g_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+bool Logger::enabled(LogLevel lvl) noexcept {
+    return lvl >= state().level.load(std::memory_order_relaxed);
+}
+
+namespace {
+
+template <typename Payload> void push(LoggerState& s, LogLevel lvl, const Payload& payload) noexcept {
+    if constexpr (std::is_same_v<Payload, std::string_view>) {
+        if (payload.size() > LogRecord::kPayloadBytes) {
+            /* too long for a record: write it whole, behind what this thread queued before */
+            if (s.running.load(std::memory_order_acquire))
+                waitDrained(s, s.pushed.load(std::memory_order_acquire));
+            writeSync(s, lvl, payload);
+            return;
+        }
+    }
+
+    struct Pushing {
+        std::atomic<int>& n;
+        explicit Pushing(std::atomic<int>& c) : n(c) {
+            n.fetch_add(1);
+        }
+        ~Pushing() {
+            n.fetch_sub(1);
+        }
+    } guard{s.pushing};
+    if (!s.running.load()) {
+        writeSync(s, lvl, payload);
+        return;
+    }
+
+    auto fill = [&](LogRecord& r) { fillRecord(r, lvl, payload); };
+    if (s.ring.tryPush(fill)) {
+        s.pushed.fetch_add(1, std::memory_order_release);
+    } else if (lvl == LogLevel::Error) {
+        /* never lose errors: wait for the worker to make room */
+        while (!s.ring.tryPush(fill)) {
+            if (!s.running.load(std::memory_order_acquire)) {
+                writeSync(s, lvl, payload);
+                return;
+            }
+            s.wake.notify_one();
+            std::this_thread::yield();
+        }
+        s.pushed.fetch_add(1, std::memory_order_release);
+    } else {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (lvl == LogLevel::Error)
+        s.wake.notify_one();
+}
+
+} // namespace
+
+void Logger::submit(LogLevel lvl, std::string_view text) noexcept {
+    push(state(), lvl, text);
+}
+
+void Logger::submitEncoded(LogLevel lvl, std::string_view fmt, LogDecodeFn decode, std::size_t bytes, void* ctx,
+                           void (*encode)(std::byte*, void*)) noexcept {
+    push(state(), lvl, EncodedArgs{fmt, decode, bytes, ctx, encode});
+}
+
+} // namespace core::util
@@ -1,35 +1,250 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/* Compile-time floor: calls below it compile to nothing.
+   0 = Debug, 1 = Info, 2 = Warn, 3 = Error */
+#ifndef VE_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define VE_LOG_MIN_LEVEL 1
+#else
+#define VE_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+/* 1 = ship raw arguments to the flush thread and format there (default),
+   0 = always format on the calling thread */
+#ifndef VE_LOG_DEFERRED_FORMAT
+#define VE_LOG_DEFERRED_FORMAT 1
+#endif
 
 namespace core::util {
 
-enum class LogLevel { Info, Warn, Error };
+enum class LogLevel : std::uint8_t { Debug, Info, Warn, Error };
 
-class Logger {
+/* Turns a deferred record's raw argument bytes back into text (flush thread) */
+using LogDecodeFn = void (*)(std::string& out, std::string_view fmt, const std::byte* args);
+
+/* Fixed-size slot in the log ring (a 320 B cell with its sequence).
+   decode == nullptr → payload is already-formatted text,
+   otherwise payload holds the encoded arguments for format.  Text
+   longer than the payload bypasses the ring (see Logger::submit). */
+struct LogRecord {
+    static constexpr std::size_t kPayloadBytes = 216;
+
+    std::int64_t timestampNs; // system_clock, since epoch
+    std::uint32_t threadId;   // small sequential id, see Logger::threadId()
+    LogLevel level;
+    std::uint16_t length;       // payload bytes used
+    const char* format;         // static storage – points into the call site's literal
+    LogDecodeFn decode;         // instantiated per argument-type list
+    std::uint32_t formatLength;
+    alignas(8) std::byte payload[kPayloadBytes];
+};
+static_assert(sizeof(LogRecord) == 256, "LogRecord + ring sequence should stay a 320 B cell");
+
+namespace detail {
+
+/* Arguments that can be shipped as raw bytes and formatted later.  Strings are
+   copied (length-prefixed); everything else must be trivially copyable. */
+template <typename T> using LogArgT = std::remove_cvref_t<std::decay_t<T>>;
+
+template <typename T>
+inline constexpr bool kIsLogString = std::is_same_v<LogArgT<T>, const char*> || std::is_same_v<LogArgT<T>, char*> ||
+                                     std::is_same_v<LogArgT<T>, std::string> ||
+                                     std::is_same_v<LogArgT<T>, std::string_view>;
+
+template <typename T>
+inline constexpr bool kIsLogDeferrable = kIsLogString<T> || std::is_arithmetic_v<LogArgT<T>> ||
+                                         std::is_same_v<LogArgT<T>, const void*> ||
+                                         std::is_same_v<LogArgT<T>, void*> ||
+                                         std::is_same_v<LogArgT<T>, std::nullptr_t>;
+
+/* Decoded form handed to std::vformat: strings become views into the payload */
+template <typename T> using LogStoredT = std::conditional_t<kIsLogString<T>, std::string_view, LogArgT<T>>;
+
+template <typename T> std::string_view logStringView(const T& v) noexcept {
+    if constexpr (std::is_array_v<T>)
+        return std::string_view{v};
+    else if constexpr (std::is_pointer_v<T>)
+        return v ? std::string_view{v} : std::string_view{"(null)"};
+    else
+        return std::string_view{v};
+}
+
+template <typename T> std::size_t logEncodedSize(const T& v) noexcept {
+    if constexpr (kIsLogString<T>)
+        return sizeof(std::uint16_t) + logStringView(v).size();
+    else
+        return sizeof(LogArgT<T>);
+}
+
+template <typename T> std::byte* logEncode(std::byte* dst, const T& v) noexcept {
+    if constexpr (kIsLogString<T>) {
+        const std::string_view sv = logStringView(v);
+        const auto len = static_cast<std::uint16_t>(sv.size());
+        std::memcpy(dst, &len, sizeof(len));
+        std::memcpy(dst + sizeof(len), sv.data(), len);
+        return dst + sizeof(len) + len;
+    } else {
+        const LogArgT<T> copy = v;
+        std::memcpy(dst, &copy, sizeof(copy));
+        return dst + sizeof(copy);
+    }
+}
+
+template <typename T> LogStoredT<T> logDecode(const std::byte*& src) noexcept {
+    if constexpr (kIsLogString<T>) {
+        std::uint16_t len;
+        std::memcpy(&len, src, sizeof(len));
+        const auto* chars = reinterpret_cast<const char*>(src + sizeof(len));
+        src += sizeof(len) + len;
+        return std::string_view{chars, len};
+    } else {
+        LogArgT<T> v;
+        std::memcpy(&v, src, sizeof(v));
+        src += sizeof(v);
+        return v;
+    }
+}
+
+template <typename... Args> void logDecodeRecord(std::string& out, std::string_view fmt, const std::byte* src) {
+    /* braced init → arguments are decoded left to right */
+    std::tuple<LogStoredT<Args>...> values{logDecode<Args>(src)...};
+    std::apply([&](auto&... v) { std::vformat_to(std::back_inserter(out), fmt, std::make_format_args(v...)); },
+               values);
+}
+
+} // namespace detail
+
+/* Destination for formatted batches – only ever called from one thread at a time */
+class LogSink {
   public:
-    static void init(std::string_view tag = "ULT_GFX") noexcept {
-        s_tag = tag;
+    virtual ~LogSink() = default;
+    virtual void write(std::string_view batch) = 0;
+    virtual void flush() {
     }
+};
 
-    template <typename... Args> static void info(std::string_view fmt, Args&&... args) noexcept {
-        log(LogLevel::Info, fmt, std::forward<Args>(args)...);
+class StderrSink final : public LogSink {
+  public:
+    void write(std::string_view batch) override;
+    void flush() override;
+};
+
+/* engine.log → engine.1.log → … → engine.<maxFiles>.log */
+class RotatingFileSink final : public LogSink {
+  public:
+    explicit RotatingFileSink(std::filesystem::path path, std::size_t maxBytes = 8u << 20, unsigned maxFiles = 3);
+    ~RotatingFileSink() override;
+
+    void write(std::string_view batch) override;
+    void flush() override;
+
+  private:
+    void rotate();
+
+    std::filesystem::path m_path;
+    std::size_t m_maxBytes;
+    unsigned m_maxFiles;
+    std::size_t m_written{0};
+    std::FILE* m_file{nullptr};
+};
+
+/* ---------------------------------------------------------------
+   Asynchronous logger
+   * Format strings are std::format strings, checked at compile time
+   * Callers push one record into a lock-free MPSC ring – no stdio
+     lock on the calling thread.  When every argument is a number,
+     pointer or string the hot path only copies the format pointer
+     plus raw argument bytes; formatting happens on the flush thread
+   * A background thread drains the ring and hands whole batches to
+     the sinks (stderr by default)
+   * Before init() / after shutdown() logging is synchronous
+-----------------------------------------------------------------*/
+class Logger {
+  public:
+    static constexpr LogLevel kMinLevel = static_cast<LogLevel>(VE_LOG_MIN_LEVEL);
+
+    /* Starts the flush thread.  Sinks added before init() replace the stderr default. */
+    static void init(std::string_view tag = "ULT_GFX");
+    static void shutdown(); // drains the ring and joins the flush thread
+    static void flush();    // blocks until everything logged so far reached the sinks
+
+    static void addSink(std::unique_ptr<LogSink> sink);
+    static void removeSink(const LogSink* sink);
+    static void setLevel(LogLevel lvl) noexcept; // runtime filter on top of kMinLevel
+    static std::uint64_t droppedCount() noexcept;
+    static std::uint32_t threadId() noexcept;
+
+    template <typename... Args> static void debug(std::format_string<Args...> fmt, Args&&... args) noexcept {
+        if constexpr (kMinLevel <= LogLevel::Debug)
+            log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
+    }
+    template <typename... Args> static void info(std::format_string<Args...> fmt, Args&&... args) noexcept {
+        if constexpr (kMinLevel <= LogLevel::Info)
+            log(LogLevel::Info, fmt, std::forward<Args>(args)...);
     }
-    template <typename... Args> static void warn(std::string_view fmt, Args&&... args) noexcept {
-        log(LogLevel::Warn, fmt, std::forward<Args>(args)...);
+    template <typename... Args> static void warn(std::format_string<Args...> fmt, Args&&... args) noexcept {
+        if constexpr (kMinLevel <= LogLevel::Warn)
+            log(LogLevel::Warn, fmt, std::forward<Args>(args)...);
     }
-    template <typename... Args> static void error(std::string_view fmt, Args&&... args) noexcept {
+    template <typename... Args> static void error(std::format_string<Args...> fmt, Args&&... args) noexcept {
         log(LogLevel::Error, fmt, std::forward<Args>(args)...);
     }
 
   private:
-    template <typename... Args> static void log(LogLevel lvl, std::string_view fmt, Args&&... args) noexcept {
-        const char* prefix = (lvl == LogLevel::Info) ? "[I]" : (lvl == LogLevel::Warn) ? "[W]" : "[E]";
-        std::fprintf(stderr, "%s %s: ", prefix, s_tag.data());
-        std::fprintf(stderr, fmt.data(), std::forward<Args>(args)...);
-        std::fputc('\n', stderr);
+    template <typename... Args>
+    static void log(LogLevel lvl, std::format_string<Args...> fmt, Args&&... args) noexcept {
+        if (!enabled(lvl))
+            return;
+
+        if constexpr (VE_LOG_DEFERRED_FORMAT && (detail::kIsLogDeferrable<Args> && ...)) {
+            const std::size_t bytes = (std::size_t{0} + ... + detail::logEncodedSize(args));
+            if (bytes <= LogRecord::kPayloadBytes) {
+                auto encode = [&](std::byte* dst) { ((dst = detail::logEncode(dst, args)), ...); };
+                submitDeferred(lvl, fmt.get(), &detail::logDecodeRecord<Args...>, bytes, encode);
+                return;
+            }
+        }
+
+        char buf[LogRecord::kPayloadBytes];
+        try {
+            const auto res = std::format_to_n(buf, sizeof(buf), fmt, std::forward<Args>(args)...);
+            if (static_cast<std::size_t>(res.size) <= sizeof(buf))
+                submit(lvl, std::string_view{buf, static_cast<std::size_t>(res.size)});
+            else
+                submit(lvl, std::format(fmt, std::forward<Args>(args)...)); // long: never cut off
+        } catch (...) {
+            submit(lvl, "(log formatting failed)");
+        }
     }
-    inline static std::string_view s_tag = "ULT_GFX";
+
+    /* encode(std::byte*) writes exactly `bytes` into the claimed slot */
+    template <typename Encode>
+    static void submitDeferred(LogLevel lvl, std::string_view fmt, LogDecodeFn decode, std::size_t bytes,
+                               Encode& encode) noexcept {
+        submitEncoded(lvl, fmt, decode, bytes, &encode,
+                      [](std::byte* dst, void* ctx) { (*static_cast<Encode*>(ctx))(dst); });
+    }
+
+    static bool enabled(LogLevel lvl) noexcept;
+    /* text too long for a record goes straight to the sinks once the
+       ring has drained what was queued before it */
+    static void submit(LogLevel lvl, std::string_view text) noexcept;
+    static void submitEncoded(LogLevel lvl, std::string_view fmt, LogDecodeFn decode, std::size_t bytes, void* ctx,
+                              void (*encode)(std::byte*, void*)) noexcept;
 };
 
 } // namespace core::util
@@ -0,0 +1,165 @@
+#include "core/util/Lz4.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace core::util::lz4 {
+
+namespace {
+
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kLastLiterals = 5; // block must end with ≥ 5 literals
+constexpr std::size_t kMfLimit = 12;     // no match may start in the last 12 bytes
+constexpr std::size_t kMaxOffset = 65535;
+constexpr unsigned kHashLog = 14;
+
+std::uint32_t read32(const std::byte* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::uint32_t hashSeq(std::uint32_t seq) noexcept {
+    return (seq * 2654435761u) >> (32 - kHashLog);
+}
+
+/* 15 in the token nibble, then 255-runs and a remainder */
+bool writeLength(std::byte*& op, const std::byte* end, std::size_t len) noexcept {
+    for (; len >= 255; len -= 255) {
+        if (op >= end)
+            return false;
+        *op++ = std::byte{255};
+    }
+    if (op >= end)
+        return false;
+    *op++ = static_cast<std::byte>(len);
+    return true;
+}
+
+bool readLength(const std::byte*& ip, const std::byte* end, std::size_t& len) noexcept {
+    std::uint8_t b;
+    do {
+        if (ip >= end)
+            return false;
+        b = std::to_integer<std::uint8_t>(*ip++);
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+bool emitSequence(std::byte*& op, const std::byte* end, const std::byte* lit, std::size_t litLen, std::size_t offset,
+                  std::size_t matchLen) noexcept {
+    if (op >= end)
+        return false;
+    std::byte* token = op++;
+    const std::size_t ml = matchLen ? matchLen - kMinMatch : 0;
+    *token = static_cast<std::byte>(((litLen >= 15 ? 15 : litLen) << 4) | (ml >= 15 ? 15 : ml));
+
+    if (litLen >= 15 && !writeLength(op, end, litLen - 15))
+        return false;
+    if (static_cast<std::size_t>(end - op) < litLen)
+        return false;
+    std::memcpy(op, lit, litLen);
+    op += litLen;
+
+    if (!matchLen)
+        return true; // final literal run
+    if (end - op < 2)
+        return false;
+    *op++ = static_cast<std::byte>(offset & 0xFF);
+    *op++ = static_cast<std::byte>(offset >> 8);
+    return ml < 15 || writeLength(op, end, ml - 15);
+}
+
+} // namespace
+
+std::size_t compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept {
+    const std::byte* const base = src.data();
+    const std::size_t n = src.size();
+    std::byte* op = dst.data();
+    const std::byte* const opEnd = dst.data() + dst.size();
+
+    std::size_t anchor = 0;
+    if (n > kMfLimit) {
+        /* positions are stored +1 so that 0 means "empty" */
+        auto table = std::make_unique<std::uint32_t[]>(std::size_t{1} << kHashLog);
+        const std::size_t matchStartLimit = n - kMfLimit;
+        const std::size_t matchEndLimit = n - kLastLiterals;
+
+        std::size_t ip = 0;
+        while (ip < matchStartLimit) {
+            const std::uint32_t seq = read32(base + ip);
+            std::uint32_t& slot = table[hashSeq(seq)];
+            const std::size_t ref = slot ? slot - 1 : ip;
+            slot = static_cast<std::uint32_t>(ip + 1);
+
+            if (ref >= ip || ip - ref > kMaxOffset || read32(base + ref) != seq) {
+                ip += 1 + ((ip - anchor) >> 6); // skip faster through incompressible data
+                continue;
+            }
+
+            std::size_t len = kMinMatch;
+            while (ip + len < matchEndLimit && base[ref + len] == base[ip + len])
+                ++len;
+
+            if (!emitSequence(op, opEnd, base + anchor, ip - anchor, ip - ref, len))
+                return 0;
+            ip += len;
+            anchor = ip;
+        }
+    }
+
+    if (!emitSequence(op, opEnd, base + anchor, n - anchor, 0, 0))
+        return 0;
+    return static_cast<std::size_t>(op - dst.data());
+}
+
+bool decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept {
+    const std::byte* ip = src.data();
+    const std::byte* const ipEnd = src.data() + src.size();
+    std::byte* op = dst.data();
+    std::byte* const opEnd = dst.data() + dst.size();
+
+    while (ip < ipEnd) {
+        const auto token = std::to_integer<std::uint8_t>(*ip++);
+
+        std::size_t litLen = token >> 4;
+        if (litLen == 15 && !readLength(ip, ipEnd, litLen))
+            return false;
+        if (static_cast<std::size_t>(ipEnd - ip) < litLen || static_cast<std::size_t>(opEnd - op) < litLen)
+            return false;
+        std::memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        if (ip == ipEnd)
+            break; // last sequence carries literals only
+
+        if (ipEnd - ip < 2)
+            return false;
+        const std::size_t offset =
+            std::to_integer<std::size_t>(ip[0]) | (std::to_integer<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - dst.data()))
+            return false;
+
+        std::size_t matchLen = token & 15;
+        if (matchLen == 15 && !readLength(ip, ipEnd, matchLen))
+            return false;
+        matchLen += kMinMatch;
+        if (static_cast<std::size_t>(opEnd - op) < matchLen)
+            return false;
+
+        const std::byte* match = op - offset;
+        if (offset >= matchLen) {
+            std::memcpy(op, match, matchLen);
+            op += matchLen;
+        } else {
+            for (std::size_t i = 0; i < matchLen; ++i) // overlapping run, e.g. RLE
+                *op++ = *match++;
+        }
+    }
+    return op == opEnd;
+}
+
+} // namespace core::util::lz4
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+namespace core::util::lz4 {
+
+/* ---------------------------------------------------------------
+   LZ4 block format (no frame header), compatible with liblz4's
+   LZ4_compress_default / LZ4_decompress_safe
+   * Greedy single-probe matcher – fast, not the best ratio
+   * decompress() bounds-checks every copy; corrupt input → false
+-----------------------------------------------------------------*/
+
+/* Worst-case output size for n input bytes */
+constexpr std::size_t compressBound(std::size_t n) noexcept {
+    return n + n / 255 + 16;
+}
+
+/* Returns bytes written to dst, or 0 when dst is too small */
+std::size_t compress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+
+/* dst.size() must be the exact decompressed size */
+bool decompress(std::span<const std::byte> src, std::span<std::byte> dst) noexcept;
+
+} // namespace core::util::lz4
@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace core::util {
+
+/* ---------------------------------------------------------------
+   Bounded lock-free ring: many producers, one consumer
+   * Per-slot sequence numbers (Vyukov) – no CAS on the consumer side
+   * tryPush/tryPop hand out the slot itself, so records are written
+     and read in place instead of being copied through a temporary
+-----------------------------------------------------------------*/
+template <typename T, std::size_t Capacity> class MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  public:
+    MpscRing() {
+        for (std::size_t i = 0; i < Capacity; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    /* fill(T&) runs on the claimed slot; false when the ring is full */
+    template <typename Fill> bool tryPush(Fill&& fill) noexcept {
+        std::size_t pos = m_head.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& c = m_cells[pos & kMask];
+            const std::size_t seq = c.seq.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (dif == 0) {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    fill(c.value);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false; // full
+            } else {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /* consume(T&) runs on the oldest published slot; single consumer only */
+    template <typename Consume> bool tryPop(Consume&& consume) noexcept {
+        Cell& c = m_cells[m_tail & kMask];
+        if (c.seq.load(std::memory_order_acquire) != m_tail + 1)
+            return false; // empty (or producer still filling)
+        consume(c.value);
+        c.seq.store(m_tail + Capacity, std::memory_order_release);
+        ++m_tail;
+        return true;
+    }
+
+    /* consumer side only */
+    bool empty() const noexcept {
+        return m_cells[m_tail & kMask].seq.load(std::memory_order_acquire) != m_tail + 1;
+    }
+
+    static constexpr std::size_t capacity() noexcept {
+        return Capacity;
+    }
+
+  private:
+    static constexpr std::size_t kMask = Capacity - 1;
+    static constexpr std::size_t kLine = 64;
+
+    struct alignas(kLine) Cell {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    std::array<Cell, Capacity> m_cells;
+    alignas(kLine) std::atomic<std::size_t> m_head{0};
+    alignas(kLine) std::size_t m_tail{0};
+};
+
+} // namespace core::util
@@ -1,8 +1,64 @@
 #pragma once
+#include "core/util/FrameStats.h"
 #include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 namespace core::util {
 
+/* Cheap cycle-counter timestamps (rdtsc / cntvct_el0), calibrated against
+   steady_clock.  Falls back to steady_clock nanoseconds elsewhere. */
+class Tsc {
+  public:
+    static std::uint64_t now() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    /* Spins for `window` measuring ticks against steady_clock.  Time::init() calls it. */
+    static void calibrate(std::chrono::microseconds window = std::chrono::milliseconds(20)) noexcept {
+        using Clock = std::chrono::steady_clock;
+        const auto c0 = Clock::now();
+        const std::uint64_t t0 = now();
+        auto c1 = c0;
+        while ((c1 = Clock::now()) - c0 < window) {
+        }
+        const std::uint64_t t1 = now();
+        const double secs = std::chrono::duration<double>(c1 - c0).count();
+        if (t1 > t0 && secs > 0.0) {
+            s_ticksPerSecond = static_cast<double>(t1 - t0) / secs;
+            s_secondsPerTick = 1.0 / s_ticksPerSecond;
+        }
+    }
+
+    static double ticksPerSecond() noexcept {
+        return s_ticksPerSecond;
+    }
+    static double toSeconds(std::uint64_t ticks) noexcept {
+        return static_cast<double>(ticks) * s_secondsPerTick;
+    }
+
+  private:
+    inline static double s_ticksPerSecond = 1e9; // valid for the steady_clock fallback
+    inline static double s_secondsPerTick = 1e-9;
+};
+
 /* Simple frame timer --------------------------------------------- */
 class Time {
   public:
@@ -11,21 +67,24 @@ class Time {
 
     /* Call once at app start. */
     static void init() noexcept {
+        Tsc::calibrate();
         s_start = Clock::now();
-        s_prev = s_start;
-        s_delta = SecondsF64{0};
+        s_prevTicks = Tsc::now();
+        s_delta = 0.0;
+        s_stats.reset();
     }
 
-    /* Call once per frame (or manually). */
+    /* Call once per frame (or manually).  Feeds stats(). */
     static void tick() noexcept {
-        const auto now = Clock::now();
-        s_delta = now - s_prev;
-        s_prev = now;
+        const std::uint64_t now = Tsc::now();
+        s_delta = Tsc::toSeconds(now - s_prevTicks);
+        s_prevTicks = now;
+        s_lastWasHitch = s_stats.record(s_delta);
     }
 
     /* Seconds since last tick() */
     static double delta() noexcept {
-        return s_delta.count();
+        return s_delta;
     }
 
     /* Seconds since init() */
@@ -33,10 +92,20 @@ class Time {
         return SecondsF64{Clock::now() - s_start}.count();
     }
 
+    /* Frame-time history of the last FrameStats::kHistory ticks */
+    static const FrameStats& stats() noexcept {
+        return s_stats;
+    }
+    static bool lastFrameWasHitch() noexcept {
+        return s_lastWasHitch;
+    }
+
   private:
     inline static Clock::time_point s_start{};
-    inline static Clock::time_point s_prev{};
-    inline static SecondsF64 s_delta{};
+    inline static std::uint64_t s_prevTicks{0};
+    inline static double s_delta{0.0};
+    inline static FrameStats s_stats{};
+    inline static bool s_lastWasHitch{false};
 };
 
 } // namespace core::util
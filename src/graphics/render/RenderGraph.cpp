@@ -1,80 +1,988 @@
 #include "RenderGraph.h"
 #include "backend/RenderDevice.h"
+#include "core/jobs/JobSystem.h"
+#include "core/util/Time.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace gfx {
 
 /* ---------------------------------------------------------------- Resources */
-RenderResource& RenderGraph::addTexture(const std::string& n, const TextureDesc& d) {
+ResourceId RenderGraph::addTexture(const std::string& n, const TextureDesc& d) {
     int idx = static_cast<int>(m_resources.size());
     m_resourceIndex[n] = idx;
     m_resources.push_back({n, ResourceType::Texture, d});
-    return m_resources.back();
+    return {idx};
 }
 
-RenderResource& RenderGraph::addBuffer(const std::string& n, const BufferDesc& d) {
+ResourceId RenderGraph::addBuffer(const std::string& n, const BufferDesc& d) {
     int idx = static_cast<int>(m_resources.size());
     m_resourceIndex[n] = idx;
     m_resources.push_back({n, ResourceType::Buffer, d});
-    return m_resources.back();
+    return {idx};
+}
+
+ResourceId RenderGraph::importTexture(const std::string& n, const TextureDesc& d, TextureHandle h,
+                                      ResourceUsage initial, ResourceUsage final) {
+    const ResourceId id = addTexture(n, d);
+    RenderResource& res = m_resources[id.index];
+    res.handle = h;
+    res.imported = true;
+    res.initialUsage = initial;
+    res.finalUsage = final;
+    return id;
+}
+
+ResourceId RenderGraph::findResource(const std::string& name) const {
+    const auto it = m_resourceIndex.find(name);
+    return it == m_resourceIndex.end() ? ResourceId{} : ResourceId{it->second};
 }
 
 /* ---------------------------------------------------------------- Passes */
-RenderPass& RenderGraph::addPass(const std::string& n, PassType t, std::span<const std::string> r,
-                                 std::span<const std::string> w, RenderPass::ExecuteFn fn) {
-    int idx = static_cast<int>(m_passes.size());
-    m_passes.push_back(RenderPass{n, t, std::vector<std::string>(r.begin(), r.end()),
-                                  std::vector<std::string>(w.begin(), w.end()), std::move(fn)});
-    if (static_cast<int>(m_edges.size()) <= idx)
-        m_edges.resize(idx + 1);
-    return m_passes.back();
+PassId RenderGraph::addPass(const std::string& n, PassType t, std::vector<ResourceAccess> r,
+                            std::vector<ResourceAccess> w, RenderPass::ExecuteFn fn) {
+    m_passes.push_back(RenderPass{n, t, std::move(r), std::move(w), std::move(fn)});
+    return {static_cast<int>(m_passes.size() - 1)};
+}
+
+PassId RenderGraph::addPass(const std::string& n, PassType t, std::span<const std::string> r,
+                            std::span<const std::string> w, RenderPass::ExecuteFn fn) {
+    auto accesses = [&](std::span<const std::string> names, const char* access) {
+        std::vector<ResourceAccess> out;
+        out.reserve(names.size());
+        for (const std::string& name : names) {
+            const ResourceId id = findResource(name);
+            if (!id.valid())
+                throw std::runtime_error("RenderGraph: pass '" + n + "' " + access + " unknown resource '" + name +
+                                         "'");
+            out.push_back({id, ResourceUsage::Undefined});
+        }
+        return out;
+    };
+    return addPass(n, t, accesses(r, "reads"), accesses(w, "writes"), std::move(fn));
+}
+
+void RenderGraph::markOutput(ResourceId resource) {
+    if (std::find(m_outputs.begin(), m_outputs.end(), resource) == m_outputs.end())
+        m_outputs.push_back(resource);
+}
+
+void RenderGraph::markOutput(const std::string& resource) {
+    const ResourceId id = findResource(resource);
+    if (!id.valid())
+        throw std::runtime_error("RenderGraph: unknown output resource '" + resource + "'");
+    markOutput(id);
+}
+
+void RenderGraph::reset() {
+    m_resourceIndex.clear();
+    m_resources.clear();
+    m_passes.clear();
+    m_outputs.clear();
+}
+
+void RenderGraph::setFramesInFlight(uint32_t frames) {
+    if (frames == 0 || frames > kTimedFrames)
+        throw std::runtime_error("RenderGraph: " + std::to_string(frames) + " frames in flight, supports 1.." +
+                                 std::to_string(kTimedFrames));
+    m_framesInFlight = frames;
+}
+
+RenderGraph::~RenderGraph() {
+    /* without a backend the device – and all memory on it – is gone already */
+    if (RenderDevice::backend())
+        releaseMemory();
 }
 
 /* ---------------------------------------------------------------- Compile */
+namespace {
+
+/* FNV-1a 64, fed field by field so struct padding never leaks in */
+struct Fnv {
+    uint64_t h{14695981039346656037ull};
+
+    template <typename T> void add(const T& v) noexcept {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        for (unsigned char b : bytes) {
+            h ^= b;
+            h *= 1099511628211ull;
+        }
+    }
+    void add(std::string_view s) noexcept {
+        add(s.size());
+        for (char c : s)
+            add(c);
+    }
+};
+
+} // namespace
+
+RenderGraph::DeclarationHash RenderGraph::hashDeclarations() const {
+    Fnv topology, memory, bindings;
+    topology.add(m_resources.size());
+    for (const RenderResource& r : m_resources) {
+        topology.add(std::string_view{r.name});
+        topology.add(r.type);
+        topology.add(r.imported);
+        if (r.imported) {
+            const auto* tex = std::get_if<TextureHandle>(&r.handle);
+            bindings.add(tex ? tex->id : std::get<BufferHandle>(r.handle).id);
+            bindings.add(r.initialUsage);
+            bindings.add(r.finalUsage);
+        } else if (const auto* t = std::get_if<TextureDesc>(&r.desc)) {
+            for (uint32_t v : {t->width, t->height, t->layers, t->mipLevels})
+                memory.add(v);
+            memory.add(t->format);
+        } else {
+            memory.add(std::get<BufferDesc>(r.desc).sizeBytes);
+        }
+    }
+    memory.add(m_aliasing);
+
+    topology.add(m_passes.size());
+    for (const RenderPass& p : m_passes) {
+        topology.add(std::string_view{p.name});
+        topology.add(p.type);
+        topology.add(p.sideEffects);
+        topology.add(p.clearsAttachments);
+        topology.add(p.chunkCount > 0);
+        for (const std::vector<ResourceAccess>* list : {&p.reads, &p.writes}) {
+            topology.add(list->size());
+            for (const ResourceAccess& a : *list) {
+                topology.add(a.resource.index);
+                topology.add(a.usage);
+            }
+        }
+    }
+    topology.add(m_outputs.size());
+    for (ResourceId out : m_outputs)
+        topology.add(out.index);
+    topology.add(m_asyncCompute);
+    return {topology.h, memory.h, bindings.h};
+}
+
 void RenderGraph::compile() {
-    /* Build edges: pass A → pass B if B reads a resource A writes */
-    m_edges.assign(m_passes.size(), {});
-    for (auto& res : m_resources) {
-        if (res.type == ResourceType::Texture && res.handle.index() == 0) {
-            auto tex = gfx::RenderDevice::createTexture(std::get<TextureDesc>(res.desc));
-            res.handle = tex;
-        } else if (res.type == ResourceType::Buffer && res.handle.index() == 0) {
-            auto buf = gfx::RenderDevice::createBuffer(std::get<BufferDesc>(res.desc));
-            res.handle = buf;
+    const DeclarationHash hash = hashDeclarations();
+    CompileScope scope = CompileScope::Reused;
+    if (!m_compiled || hash.topology != m_hash.topology)
+        scope = CompileScope::Full;
+    else if (hash.memory != m_hash.memory)
+        scope = CompileScope::Memory;
+    else if (hash.bindings != m_hash.bindings)
+        scope = CompileScope::Barriers;
+    m_lastScope = scope;
+
+    if (scope == CompileScope::Full) {
+        m_compiled = false; // stays false if anything below throws
+        resolveResources();
+        buildEdges();
+        sortPasses();
+        cullPasses();
+        scheduleQueues();
+    }
+    if (scope >= CompileScope::Memory) {
+        retireTransients();
+        placeTransients();
+        allocateTransients();
+    } else {
+        /* re-declared resources start without handles – hand the cached ones back */
+        for (std::size_t r = 0; r < m_transientHandles.size(); ++r)
+            if (m_placements[r].heap >= 0)
+                m_resources[r].handle = m_transientHandles[r];
+    }
+    if (scope >= CompileScope::Barriers)
+        planBarriers();
+    m_hash = hash;
+    m_compiled = true;
+    if (scope == CompileScope::Reused)
+        return;
+
+    core::util::Logger::info("RenderGraph compiled with {} passes ({} culled), {} edges, {} barriers, {} queue batches",
+                             m_execOrder.size(), m_passes.size() - m_execOrder.size(), m_edges.size(),
+                             m_barriers.size() + m_releases.size(), m_batches.size());
+    core::util::Logger::info("RenderGraph transient memory: {} KiB in {} heaps ({} KiB unaliased, {} KiB saved)",
+                             m_memoryStats.heapBytes / 1024, m_memoryStats.heapCount,
+                             m_memoryStats.requestedBytes / 1024, m_memoryStats.savedBytes() / 1024);
+}
+
+void RenderGraph::resolveResources() {
+    auto lookup = [&](const RenderPass& p, ResourceId id, const char* access) {
+        if (id.index < 0 || id.index >= static_cast<int>(m_resources.size()))
+            throw std::runtime_error("RenderGraph: pass '" + p.name + "' " + access + " invalid resource id " +
+                                     std::to_string(id.index));
+        return id.index;
+    };
+    auto usageOf = [&](const RenderPass& p, const ResourceAccess& a, int res, bool write) {
+        if (a.usage != ResourceUsage::Undefined)
+            return a.usage;
+        const RenderResource& r = m_resources[res];
+        const bool buffer = r.type == ResourceType::Buffer;
+        switch (p.type) {
+        case PassType::Graphics:
+            if (!write)
+                return buffer ? ResourceUsage::Uniform : ResourceUsage::Sampled;
+            if (buffer)
+                return ResourceUsage::Storage;
+            return std::get<TextureDesc>(r.desc).format == TextureDesc::Format::Depth24
+                       ? ResourceUsage::DepthAttachment
+                       : ResourceUsage::ColorAttachment;
+        case PassType::Compute:
+            return write || buffer ? ResourceUsage::Storage : ResourceUsage::Sampled;
+        case PassType::Copy:
+            return write ? ResourceUsage::TransferDst : ResourceUsage::TransferSrc;
+        }
+        return ResourceUsage::Undefined;
+    };
+    m_passIo.assign(m_passes.size(), {});
+    for (std::size_t i = 0; i < m_passes.size(); ++i) {
+        const RenderPass& p = m_passes[i];
+        PassIo& io = m_passIo[i];
+        for (const ResourceAccess& a : p.writes) {
+            io.writes.push_back(lookup(p, a.resource, "writes"));
+            io.writeUsage.push_back(usageOf(p, a, io.writes.back(), true));
+        }
+        for (const ResourceAccess& a : p.reads) {
+            const int r = lookup(p, a.resource, "reads");
+            const auto w = std::find(io.writes.begin(), io.writes.end(), r);
+            io.reads.push_back(r);
+            if (a.usage == ResourceUsage::Undefined && w != io.writes.end()) // read-modify-write
+                io.readUsage.push_back(io.writeUsage[w - io.writes.begin()]);
+            else
+                io.readUsage.push_back(usageOf(p, a, r, false));
+        }
+    }
+}
+
+void RenderGraph::buildEdges() {
+    m_edges.clear();
+    const int passCount = static_cast<int>(m_passes.size());
+    std::vector<char> linked(static_cast<std::size_t>(passCount) * passCount, 0);
+    auto addEdge = [&](int from, int to, int res, Hazard h) {
+        char& seen = linked[static_cast<std::size_t>(from) * passCount + to];
+        if (from == to || seen)
+            return;
+        seen = 1;
+        m_edges.push_back({from, to, res, h});
+    };
+
+    /* per resource: writers and readers in declaration order */
+    std::vector<std::vector<int>> writers(m_resources.size()), readers(m_resources.size());
+    for (int p = 0; p < passCount; ++p) {
+        for (int r : m_passIo[p].writes)
+            if (writers[r].empty() || writers[r].back() != p)
+                writers[r].push_back(p);
+        for (int r : m_passIo[p].reads)
+            if (readers[r].empty() || readers[r].back() != p)
+                readers[r].push_back(p);
+    }
+
+    for (std::size_t r = 0; r < m_resources.size(); ++r) {
+        const std::vector<int>& w = writers[r];
+        const int res = static_cast<int>(r);
+        for (std::size_t i = 1; i < w.size(); ++i)
+            addEdge(w[i - 1], w[i], res, Hazard::WriteAfterWrite);
+        if (w.empty())
+            continue;
+
+        for (int reader : readers[r]) {
+            /* version read = last writer declared before the reader; a pass that reads and writes
+               sees the previous version */
+            auto next = std::lower_bound(w.begin(), w.end(), reader); // first writer at or after the reader
+            if (next == w.begin()) {
+                if (*next == reader) { // first writer reads the initial contents – nothing to wait for
+                    if (next + 1 != w.end())
+                        addEdge(reader, *(next + 1), res, Hazard::WriteAfterRead);
+                    continue;
+                }
+                addEdge(*next, reader, res, Hazard::ReadAfterWrite); // declared before any writer
+                if (next + 1 != w.end())
+                    addEdge(reader, *(next + 1), res, Hazard::WriteAfterRead);
+                continue;
+            }
+            addEdge(*(next - 1), reader, res, Hazard::ReadAfterWrite);
+            if (next != w.end() && *next == reader)
+                ++next; // its own write doesn't count as the next version
+            if (next != w.end())
+                addEdge(reader, *next, res, Hazard::WriteAfterRead);
         }
     }
+}
 
-    /* Topo sort (DFS) */
+void RenderGraph::sortPasses() {
+    const std::size_t n = m_passes.size();
+    std::vector<std::vector<int>> out(n);
+    std::vector<int> inDegree(n, 0);
+    for (const GraphEdge& e : m_edges) {
+        out[e.from].push_back(e.to);
+        ++inDegree[e.to];
+    }
+
+    /* Kahn with a min-heap: among ready passes, the one declared first goes first */
+    std::priority_queue<int, std::vector<int>, std::greater<int>> ready;
+    for (std::size_t i = 0; i < n; ++i)
+        if (inDegree[i] == 0)
+            ready.push(static_cast<int>(i));
     m_execOrder.clear();
-    std::vector<int> mark(m_passes.size(), 0);
-    for (int n = 0; n < (int)m_passes.size(); ++n)
-        if (!mark[n])
-            topoSort(n, m_execOrder, mark);
+    while (!ready.empty()) {
+        const int p = ready.top();
+        ready.pop();
+        m_execOrder.push_back(p);
+        for (int to : out[p])
+            if (--inDegree[to] == 0)
+                ready.push(to);
+    }
+    if (m_execOrder.size() != n) {
+        const std::string cycle = describeCycle(inDegree);
+        m_execOrder.clear();
+        throw std::runtime_error("RenderGraph: dependency cycle: " + cycle);
+    }
+}
+
+void RenderGraph::cullPasses() {
+    m_passLive.assign(m_passes.size(), m_outputs.empty());
+    m_resourceLive.assign(m_resources.size(), 0);
+
+    if (!m_outputs.empty()) {
+        std::vector<char> isOutput(m_resources.size(), 0);
+        for (ResourceId out : m_outputs) {
+            if (out.index < 0 || out.index >= static_cast<int>(m_resources.size()))
+                throw std::runtime_error("RenderGraph: invalid output resource id " + std::to_string(out.index));
+            isOutput[out.index] = 1;
+        }
+
+        /* roots: side-effect passes and every writer of an output – WAW edges chain the earlier writers in */
+        std::vector<int> stack;
+        for (std::size_t p = 0; p < m_passes.size(); ++p) {
+            bool root = m_passes[p].sideEffects;
+            for (int w : m_passIo[p].writes)
+                root = root || isOutput[w];
+            if (root) {
+                m_passLive[p] = 1;
+                stack.push_back(static_cast<int>(p));
+            }
+        }
+
+        /* walk producers backwards; WAR edges only constrain order, they don't make the reader needed */
+        std::vector<std::vector<int>> producers(m_passes.size());
+        for (const GraphEdge& e : m_edges)
+            if (e.hazard != Hazard::WriteAfterRead)
+                producers[e.to].push_back(e.from);
+        while (!stack.empty()) {
+            const int p = stack.back();
+            stack.pop_back();
+            for (int from : producers[p]) {
+                if (!m_passLive[from]) {
+                    m_passLive[from] = 1;
+                    stack.push_back(from);
+                }
+            }
+        }
+        std::erase_if(m_execOrder, [&](int p) { return !m_passLive[p]; });
+    }
+
+    for (int p : m_execOrder) {
+        for (int r : m_passIo[p].reads)
+            m_resourceLive[r] = 1;
+        for (int w : m_passIo[p].writes)
+            m_resourceLive[w] = 1;
+    }
+}
+
+/* Async compute: split the execution order into per-queue batches.
+   Dependencies come from each resource's last use (not the edges), so
+   two reads on different queues are ordered too – exclusive ownership
+   moves between them. */
+void RenderGraph::scheduleQueues() {
+    const bool async = m_asyncCompute && RenderDevice::backend()->hasAsyncCompute();
+    const std::size_t slots = m_execOrder.size();
+    m_slotQueue.assign(slots, QueueType::Graphics);
+    m_batches.clear();
+
+    std::vector<int> batchOf(slots, -1);
+    std::vector<int> lastUse(m_resources.size(), -1); // slot
+    int open[2]{-1, -1};                              // batch still taking passes, per queue
+    int waited[2]{-1, -1};                            // newest other-queue batch each queue has waited for
+    for (std::size_t slot = 0; slot < slots; ++slot) {
+        const int p = m_execOrder[slot];
+        const PassIo& io = m_passIo[p];
+        bool eligible = async && m_passes[p].type == PassType::Compute;
+        for (const std::vector<int>* list : {&io.reads, &io.writes})
+            for (int r : *list) {
+                const RenderResource& res = m_resources[r];
+                if (res.imported && lastUse[r] < 0 && res.initialUsage != ResourceUsage::Undefined)
+                    eligible = false; // its contents are owned by the graphics queue on entry
+            }
+        const QueueType queue = eligible ? QueueType::AsyncCompute : QueueType::Graphics;
+        const int q = static_cast<int>(queue), other = 1 - q;
+        m_slotQueue[slot] = queue;
+
+        int wait = -1;
+        for (const std::vector<int>* list : {&io.reads, &io.writes})
+            for (int r : *list)
+                if (lastUse[r] >= 0 && m_slotQueue[lastUse[r]] != queue)
+                    wait = std::max(wait, batchOf[lastUse[r]]);
+        if (wait > waited[q]) {
+            m_batches[wait].signals = true;
+            waited[q] = wait;
+            if (open[other] == wait)
+                open[other] = -1; // it has to be submitted before anything can wait for it
+        } else {
+            wait = -1;
+        }
+        if (open[q] < 0 || wait >= 0) {
+            open[q] = static_cast<int>(m_batches.size());
+            m_batches.push_back({queue, {}, wait, false});
+        }
+        m_batches[open[q]].slots.push_back(slot);
+        batchOf[slot] = open[q];
+        for (const std::vector<int>* list : {&io.reads, &io.writes})
+            for (int r : *list)
+                lastUse[r] = static_cast<int>(slot);
+    }
 
-    core::util::Logger::info("RenderGraph compiled with %zu passes", m_execOrder.size());
+    /* the frame ends on graphics, after all async work: its submission
+       and fence then cover both queues */
+    int lastAsync = -1;
+    for (std::size_t b = 0; b < m_batches.size(); ++b)
+        if (m_batches[b].queue == QueueType::AsyncCompute)
+            lastAsync = static_cast<int>(b);
+    const int g = static_cast<int>(QueueType::Graphics);
+    if (lastAsync > waited[g]) {
+        m_batches[lastAsync].signals = true;
+        m_batches.push_back({QueueType::Graphics, {}, lastAsync, false});
+    } else if (m_batches.empty() || m_batches.back().queue != QueueType::Graphics) {
+        m_batches.push_back({QueueType::Graphics, {}, -1, false});
+    }
+}
+
+/* ---------------------------------------------------------------- Transients */
+void RenderGraph::placeTransients() {
+    IRenderBackend* device = RenderDevice::backend();
+    m_placements.assign(m_resources.size(), {});
+    m_aliasPredecessor.assign(m_resources.size(), -1);
+    m_heaps.clear();
+    m_memoryStats = {};
+
+    /* lifetimes over the execution order */
+    std::vector<int> transients;
+    std::vector<char> seen(m_resources.size(), 0);
+    std::vector<char> async(m_resources.size(), 0); // slot order says nothing about when the async queue runs
+    for (std::size_t slot = 0; slot < m_execOrder.size(); ++slot) {
+        const PassIo& io = m_passIo[m_execOrder[slot]];
+        for (const std::vector<int>* list : {&io.reads, &io.writes}) {
+            for (int r : *list) {
+                if (m_resources[r].imported)
+                    continue;
+                TransientPlacement& pl = m_placements[r];
+                if (!seen[r]) {
+                    seen[r] = 1;
+                    pl.firstSlot = static_cast<int>(slot);
+                    transients.push_back(r);
+                }
+                pl.lastSlot = static_cast<int>(slot);
+                async[r] |= m_slotQueue[slot] == QueueType::AsyncCompute;
+            }
+        }
+    }
+
+    auto alignUp = [](uint64_t v, uint64_t a) { return (v + a - 1) / a * a; };
+    std::vector<MemoryRequirements> reqs(m_resources.size());
+    for (int r : transients) {
+        const RenderResource& res = m_resources[r];
+        reqs[r] = res.type == ResourceType::Texture ? device->memoryRequirements(std::get<TextureDesc>(res.desc))
+                                                    : device->memoryRequirements(std::get<BufferDesc>(res.desc));
+        m_placements[r].size = reqs[r].size;
+        m_memoryStats.requestedBytes += alignUp(reqs[r].size, reqs[r].alignment);
+    }
+
+    /* largest first, each at the lowest offset clear of everything alive at the same time */
+    std::stable_sort(transients.begin(), transients.end(),
+                     [&](int a, int b) { return m_placements[a].size > m_placements[b].size; });
+    std::vector<int> placed;
+    std::vector<std::pair<uint64_t, uint64_t>> busy;
+    for (int r : transients) {
+        TransientPlacement& pl = m_placements[r];
+        const ResourceType kind = m_resources[r].type;
+        auto heap = std::find_if(m_heaps.begin(), m_heaps.end(), [&](const Heap& h) {
+            return h.kind == kind && h.desc.memoryTypeBits == reqs[r].memoryTypeBits;
+        });
+        if (heap == m_heaps.end()) {
+            m_heaps.push_back({{0, reqs[r].memoryTypeBits}, kind, InvalidHeap});
+            heap = m_heaps.end() - 1;
+        }
+        pl.heap = static_cast<int>(heap - m_heaps.begin());
+
+        busy.clear();
+        for (int o : placed) {
+            const TransientPlacement& other = m_placements[o];
+            const bool overlap =
+                (other.firstSlot <= pl.lastSlot && pl.firstSlot <= other.lastSlot) || async[r] || async[o];
+            if (other.heap == pl.heap && (overlap || !m_aliasing))
+                busy.emplace_back(other.offset, other.offset + other.size);
+        }
+        std::sort(busy.begin(), busy.end());
+        uint64_t offset = 0;
+        for (const auto& [begin, end] : busy) {
+            if (alignUp(offset, reqs[r].alignment) + pl.size <= begin)
+                break;
+            offset = std::max(offset, end);
+        }
+        pl.offset = alignUp(offset, reqs[r].alignment);
+        heap->desc.sizeBytes = std::max(heap->desc.sizeBytes, pl.offset + pl.size);
+        placed.push_back(r);
+    }
+
+    /* who used each piece of memory last before a resource moves in */
+    for (int r : transients) {
+        const TransientPlacement& pl = m_placements[r];
+        int best = -1;
+        for (int o : transients) {
+            const TransientPlacement& other = m_placements[o];
+            if (other.heap != pl.heap || other.lastSlot >= pl.firstSlot || other.offset >= pl.offset + pl.size ||
+                pl.offset >= other.offset + other.size)
+                continue;
+            if (best < 0 || other.lastSlot > m_placements[best].lastSlot)
+                best = o;
+        }
+        m_aliasPredecessor[r] = best;
+    }
+
+    for (const Heap& h : m_heaps)
+        m_memoryStats.heapBytes += h.desc.sizeBytes;
+    m_memoryStats.heapCount = static_cast<uint32_t>(m_heaps.size());
+}
+
+void RenderGraph::allocateTransients() {
+    IRenderBackend* device = RenderDevice::backend();
+    m_transientHandles.assign(m_resources.size(), {});
+    for (Heap& h : m_heaps)
+        h.handle = device->createHeap(h.desc);
+    for (std::size_t r = 0; r < m_resources.size(); ++r) {
+        const TransientPlacement& pl = m_placements[r];
+        if (pl.heap < 0)
+            continue;
+        RenderResource& res = m_resources[r];
+        const HeapHandle heap = m_heaps[pl.heap].handle;
+        if (res.type == ResourceType::Texture)
+            res.handle = device->createPlacedTexture(std::get<TextureDesc>(res.desc), heap, pl.offset);
+        else
+            res.handle = device->createPlacedBuffer(std::get<BufferDesc>(res.desc), heap, pl.offset);
+        m_transientHandles[r] = res.handle;
+    }
+}
+
+/* Resources and heaps of the previous compile() – frames still in flight
+   may be using them, so they are only queued for destroyRetired() */
+void RenderGraph::retireTransients() {
+    Retired old{m_lastFrame, {}, {}};
+    for (std::size_t r = 0; r < m_transientHandles.size(); ++r) {
+        if (m_placements[r].heap < 0)
+            continue;
+        old.resources.push_back(m_transientHandles[r]);
+        if (r < m_resources.size() && !m_resources[r].imported)
+            m_resources[r].handle = {};
+    }
+    for (const Heap& h : m_heaps)
+        old.heaps.push_back(h.handle);
+    if (!old.resources.empty() || !old.heaps.empty())
+        m_retired.push_back(std::move(old));
+    m_heaps.clear();
+    m_placements.clear();
+    m_transientHandles.clear();
+}
+
+/* Everything retired by a frame the GPU has finished by the time `frame` records */
+void RenderGraph::destroyRetired(uint64_t frame) {
+    IRenderBackend* device = RenderDevice::backend();
+    while (!m_retired.empty() && m_retired.front().frame + m_framesInFlight <= frame) {
+        for (const auto& handle : m_retired.front().resources) {
+            if (const auto* tex = std::get_if<TextureHandle>(&handle))
+                device->destroyTexture(*tex);
+            else
+                device->destroyBuffer(std::get<BufferHandle>(handle));
+        }
+        for (HeapHandle h : m_retired.front().heaps)
+            device->destroyHeap(h);
+        m_retired.pop_front();
+    }
+}
+
+void RenderGraph::releaseMemory() {
+    retireTransients();
+    destroyRetired(m_lastFrame + m_framesInFlight); // every entry is from m_lastFrame or earlier
+    m_compiled = false;
+}
+
+/* ---------------------------------------------------------------- Barriers */
+void RenderGraph::planBarriers() {
+    std::vector<ResourceUsage> state(m_resources.size());
+    for (std::size_t r = 0; r < m_resources.size(); ++r)
+        state[r] = m_resources[r].initialUsage;
+
+    m_barriers.clear();
+    m_barrierResource.clear();
+    m_barrierStart.assign(1, 0);
+    std::vector<int> lastSlot(m_resources.size(), -1);
+    struct Release {
+        std::size_t slot; // issued after it
+        int resource;
+        ResourceBarrier barrier;
+    };
+    std::vector<Release> releases;
+    std::vector<std::pair<int, ResourceBarrier>> pending;          // this slot's, with their resource
+    auto moveTo = [&](int r, ResourceUsage after, std::size_t slot) {
+        const RenderResource& res = m_resources[r];
+        const ResourceUsage before = std::exchange(state[r], after);
+        const int last = std::exchange(lastSlot[r], static_cast<int>(slot));
+        const QueueType from = last >= 0 ? m_slotQueue[last] : QueueType::Graphics;
+        const QueueType to = slot < m_slotQueue.size() ? m_slotQueue[slot] : QueueType::Graphics;
+        const int pred = before == ResourceUsage::Undefined ? m_aliasPredecessor[r] : -1;
+        const ResourceUsage alias = pred >= 0 ? state[pred] : ResourceUsage::Undefined;
+        const bool texture = res.type == ResourceType::Texture;
+        const bool written = isWriteUsage(before) || isWriteUsage(after);
+        const bool needed = texture ? before != after || isWriteUsage(after)
+                                    : before != ResourceUsage::Undefined && written;
+        const bool handOver = last >= 0 && from != to && before != ResourceUsage::Undefined;
+        if (!needed && !handOver && alias == ResourceUsage::Undefined)
+            return;
+        const bool depth = texture && std::get<TextureDesc>(res.desc).format == TextureDesc::Format::Depth24;
+        ResourceBarrier barrier{res.handle, before, after, depth, alias, QueueTransfer::None, from, to};
+        if (handOver) {
+            barrier.transfer = QueueTransfer::Release;
+            releases.push_back({static_cast<std::size_t>(last), r, barrier});
+            barrier.transfer = QueueTransfer::Acquire;
+        }
+        pending.emplace_back(r, barrier);
+    };
+    auto flush = [&] {
+        for (const auto& [r, barrier] : pending) {
+            m_barriers.push_back(barrier);
+            m_barrierResource.push_back(r);
+        }
+        pending.clear();
+        m_barrierStart.push_back(m_barriers.size());
+    };
+
+    /* render pass groups can't span a queue submission, nor a release
+       (it would land inside the render pass) */
+    std::vector<char> batchStart(m_execOrder.size(), 0);
+    for (const QueueBatch& batch : m_batches)
+        if (!batch.slots.empty())
+            batchStart[batch.slots.front()] = 1;
+    std::vector<char> onAsync(m_resources.size(), 0);
+    for (std::size_t slot = 0; slot < m_execOrder.size(); ++slot)
+        if (m_slotQueue[slot] == QueueType::AsyncCompute) {
+            const PassIo& io = m_passIo[m_execOrder[slot]];
+            for (const std::vector<int>* list : {&io.reads, &io.writes})
+                for (int r : *list)
+                    onAsync[r] = 1;
+        }
+    m_groups.clear();
+    m_slotGroup.assign(m_execOrder.size(), -1);
+    std::vector<int> lastUse(m_resources.size(), -1);
+    bool prevTouchesAsync = false;
+
+    std::vector<std::pair<int, ResourceUsage>> touched;
+    for (std::size_t slot = 0; slot < m_execOrder.size(); ++slot) {
+        /* one state per resource and pass – a read and a write of it must agree */
+        const int p = m_execOrder[slot];
+        const PassIo& io = m_passIo[p];
+        touched.clear();
+        auto touch = [&](int r, ResourceUsage u) {
+            const auto it = std::find_if(touched.begin(), touched.end(), [&](const auto& t) { return t.first == r; });
+            if (it == touched.end())
+                touched.emplace_back(r, u);
+            else if (it->second != u)
+                throw std::runtime_error("RenderGraph: pass '" + m_passes[p].name + "' uses '" +
+                                         m_resources[r].name + "' with two different usages");
+        };
+        for (std::size_t i = 0; i < io.writes.size(); ++i)
+            touch(io.writes[i], io.writeUsage[i]);
+        for (std::size_t i = 0; i < io.reads.size(); ++i)
+            touch(io.reads[i], io.readUsage[i]);
+
+        const RenderPass& pass = m_passes[p];
+        const bool raster = pass.type == PassType::Graphics && m_slotQueue[slot] == QueueType::Graphics;
+        int color = -1, depth = -1;
+        bool touchesAsync = false;
+        for (const auto& [r, usage] : touched) {
+            if (raster && usage == ResourceUsage::ColorAttachment && color < 0)
+                color = r;
+            else if (raster && usage == ResourceUsage::DepthAttachment && depth < 0)
+                depth = r;
+            touchesAsync |= onAsync[r] != 0;
+            lastUse[r] = static_cast<int>(slot);
+        }
+        const ResourceUsage colorBefore = color >= 0 ? state[color] : ResourceUsage::Undefined;
+        const ResourceUsage depthBefore = depth >= 0 ? state[depth] : ResourceUsage::Undefined;
+        for (const auto& [r, usage] : touched)
+            moveTo(r, usage, slot);
+
+        /* merge into the previous pass's render pass when all this one
+           needs is attachment → same attachment, which rasterization
+           order already covers */
+        const int prev = slot > 0 ? m_slotGroup[slot - 1] : -1;
+        const auto withinPass = [&](const std::pair<int, ResourceBarrier>& b) {
+            return (b.first == color || b.first == depth) && b.second.before == b.second.after &&
+                   b.second.previousAlias == ResourceUsage::Undefined && b.second.transfer == QueueTransfer::None;
+        };
+        const bool sameAttachments =
+            prev >= 0 && m_groups[prev].color.index == color && m_groups[prev].depth.index == depth;
+        const bool merge = sameAttachments && !batchStart[slot] && !prevTouchesAsync && !touchesAsync &&
+                           pass.chunkCount == 0 && !pass.clearsAttachments &&
+                           m_passes[m_execOrder[slot - 1]].chunkCount == 0 &&
+                           std::all_of(pending.begin(), pending.end(), withinPass);
+        if (merge) {
+            m_groups[prev].lastSlot = slot;
+            m_slotGroup[slot] = prev;
+            pending.clear();
+        } else if (color >= 0 || depth >= 0) {
+            auto load = [&](ResourceUsage before) {
+                if (pass.clearsAttachments)
+                    return LoadOp::Clear;
+                return before == ResourceUsage::Undefined ? LoadOp::DontCare : LoadOp::Load;
+            };
+            RenderPassGroup group{slot, slot, ResourceId{color}, ResourceId{depth}, {}};
+            if (color >= 0)
+                group.ops.color.load = load(colorBefore);
+            if (depth >= 0)
+                group.ops.depth.load = load(depthBefore);
+            m_slotGroup[slot] = static_cast<int>(m_groups.size());
+            m_groups.push_back(group);
+        }
+        prevTouchesAsync = touchesAsync;
+        flush();
+    }
+
+    for (std::size_t r = 0; r < m_resources.size(); ++r)
+        if (m_resources[r].imported && m_resources[r].finalUsage != ResourceUsage::Undefined)
+            moveTo(static_cast<int>(r), m_resources[r].finalUsage, m_execOrder.size());
+    flush();
+
+    /* store only what someone looks at afterwards */
+    auto store = [&](ResourceId id, std::size_t lastSlot) {
+        const RenderResource& res = m_resources[id.index];
+        const bool keep = lastUse[id.index] > static_cast<int>(lastSlot) ||
+                          (res.imported && res.finalUsage != ResourceUsage::Undefined) ||
+                          std::find(m_outputs.begin(), m_outputs.end(), id) != m_outputs.end();
+        return keep ? StoreOp::Store : StoreOp::DontCare;
+    };
+    for (RenderPassGroup& group : m_groups) {
+        if (group.color.valid())
+            group.ops.color.store = store(group.color, group.lastSlot);
+        if (group.depth.valid())
+            group.ops.depth.store = store(group.depth, group.lastSlot);
+    }
+
+    std::stable_sort(releases.begin(), releases.end(),
+                     [](const Release& a, const Release& b) { return a.slot < b.slot; });
+    m_releases.clear();
+    m_releaseResource.clear();
+    m_releaseStart.assign(1, 0);
+    for (std::size_t slot = 0, i = 0; slot < m_execOrder.size(); ++slot) {
+        for (; i < releases.size() && releases[i].slot == slot; ++i) {
+            m_releases.push_back(releases[i].barrier);
+            m_releaseResource.push_back(releases[i].resource);
+        }
+        m_releaseStart.push_back(m_releases.size());
+    }
 }
 
-void RenderGraph::topoSort(int node, std::vector<int>& out, std::vector<int>& mark) {
-    mark[node] = 1;
-    for (int to : m_edges[node])
-        if (!mark[to])
-            topoSort(to, out, mark);
-    out.push_back(node);
+void RenderGraph::collectGpuTimes(const gfx::IRenderBackend::TimestampReadback& readback) {
+    const auto& [frame, order] = m_timedOrder[readback.tag % kTimedFrames];
+    if (readback.seconds.empty() || frame != readback.tag)
+        return; // nothing timed yet, or older than the frames we remember
+    for (std::size_t slot = 0; slot < order.size() && 2 * slot + 1 < readback.seconds.size(); ++slot) {
+        const double begin = readback.seconds[2 * slot], end = readback.seconds[2 * slot + 1];
+        if (!std::isnan(begin) && !std::isnan(end) && order[slot] < static_cast<int>(m_costs.size()))
+            m_costs[order[slot]].gpuSeconds = end - begin;
+    }
+}
+
+/* Every pass left with inDegree > 0 has an unsorted predecessor, so walking predecessors must loop */
+std::string RenderGraph::describeCycle(const std::vector<int>& inDegree) const {
+    std::vector<const GraphEdge*> into(m_passes.size(), nullptr);
+    for (const GraphEdge& e : m_edges)
+        if (inDegree[e.from] > 0 && inDegree[e.to] > 0)
+            into[e.to] = &e;
+
+    int p = static_cast<int>(std::find_if(inDegree.begin(), inDegree.end(), [](int d) { return d > 0; }) -
+                             inDegree.begin());
+    std::vector<int> seen(m_passes.size(), -1), path;
+    while (seen[p] < 0) {
+        seen[p] = static_cast<int>(path.size());
+        path.push_back(p);
+        p = into[p]->from;
+    }
+    /* path runs backwards along the edges; the cycle is path[seen[p]..] */
+    std::vector<int> cycle(path.begin() + seen[p], path.end());
+    std::reverse(cycle.begin(), cycle.end());
+    std::string text = m_passes[cycle[0]].name;
+    for (std::size_t i = 0; i < cycle.size(); ++i) {
+        const int to = cycle[(i + 1) % cycle.size()];
+        text += " -[" + m_resources[into[to]->resource].name + "]-> " + m_passes[to].name;
+    }
+    return text;
 }
 
 /* ---------------------------------------------------------------- Execute */
-void RenderGraph::execute(uint64_t frame, gfx::CmdHandle cmd) {
-    for (int idx : m_execOrder) {
-        auto& p = m_passes[idx];
-        // core::util::Logger::info("[RG] Pass %s (idx=%d)", p.name.c_str(), idx);
-
-        RenderPass::ExecCtx ctx{frame, this,
-                                gfx::RenderDevice::backend(), // device
-                                cmd};                         // cmd handle
-        if (p.onExecute)
-            p.onExecute(ctx);
-        // std::cout << "[RG] Pass " << p.name << " executed." << std::endl;
+gfx::CmdHandle RenderGraph::execute(uint64_t frame, gfx::CmdHandle cmd) {
+    gfx::IRenderBackend* device = gfx::RenderDevice::backend();
+    const bool parallel = m_parallel && core::jobs::JobSystem::running();
+
+    m_lastFrame = frame;
+    destroyRetired(frame);
+
+    m_costs.resize(m_passes.size());
+    collectGpuTimes(device->beginTimestamps(static_cast<uint32_t>(2 * m_execOrder.size()), frame));
+    m_timedOrder[frame % kTimedFrames] = {frame, m_execOrder};
+
+    /* batches in submission order; the first graphics one records into
+       cmd, the last (always graphics) is left open for endFrame() */
+    std::vector<gfx::SyncPoint> points(m_batches.size());
+    bool frameCmdTaken = false;
+    for (std::size_t b = 0; b < m_batches.size(); ++b) {
+        const QueueBatch& batch = m_batches[b];
+        const bool graphics = batch.queue == QueueType::Graphics;
+        gfx::CmdHandle into = cmd;
+        if (!graphics || frameCmdTaken)
+            into = device->beginBatch(batch.queue);
+        frameCmdTaken |= graphics;
+        if (batch.wait >= 0)
+            device->batchWait(into, points[batch.wait]);
+        recordSlots(frame, batch.slots, into, parallel && graphics); // worker pools are graphics-family
+        if (b + 1 == m_batches.size())
+            cmd = into;
+        else
+            points[b] = device->submitBatch(into, batch.queue, batch.signals);
+    }
+    if (const auto barriers = barriersAt(m_execOrder.size()); !barriers.empty())
+        device->cmdBarriers(cmd, barriers);
+    return cmd;
+}
+
+RenderPass::ExecCtx RenderGraph::contextFor(uint64_t frame, std::size_t slot, gfx::CmdHandle cmd,
+                                            bool secondaryContents) {
+    RenderPass::ExecCtx ctx{frame, this, gfx::RenderDevice::backend(), cmd, secondaryContents};
+    if (const int g = m_slotGroup[slot]; g >= 0) {
+        const RenderPassGroup& group = m_groups[g];
+        ctx.attachmentOps = group.ops;
+        ctx.continuesRenderPass = slot != group.firstSlot;
+        ctx.keepsRenderPassOpen = slot != group.lastSlot;
+    }
+    return ctx;
+}
+
+void RenderGraph::recordSlots(uint64_t frame, std::span<const std::size_t> slots, gfx::CmdHandle cmd,
+                              bool parallel) {
+    gfx::IRenderBackend* device = gfx::RenderDevice::backend();
+    auto issue = [&](std::span<const ResourceBarrier> barriers, gfx::CmdHandle into) {
+        if (!barriers.empty())
+            device->cmdBarriers(into, barriers);
+    };
+    auto passAt = [&](std::size_t slot) -> const RenderPass& { return m_passes[m_execOrder[slot]]; };
+    /* barriers + pass between two timestamps; the CPU time lands in the pass's own PassCost */
+    auto timed = [&](std::size_t slot, gfx::CmdHandle into, auto&& record) {
+        const auto query = static_cast<uint32_t>(2 * slot);
+        device->cmdWriteTimestamp(into, m_slotQueue[slot], query);
+        const uint64_t start = core::util::Tsc::now();
+        issue(barriersAt(slot), into);
+        record();
+        m_costs[m_execOrder[slot]].cpuSeconds = core::util::Tsc::toSeconds(core::util::Tsc::now() - start);
+        device->cmdWriteTimestamp(into, m_slotQueue[slot], query + 1);
+    };
+
+    if (!parallel) {
+        for (std::size_t slot : slots) {
+            const RenderPass& p = passAt(slot);
+            timed(slot, cmd, [&] {
+                const RenderPass::ExecCtx ctx = contextFor(frame, slot, cmd, false);
+                if (p.onExecute)
+                    p.onExecute(ctx);
+                if (p.chunkCount > 0) {
+                    for (uint32_t c = 0; c < p.chunkCount; ++c)
+                        if (p.onChunk)
+                            p.onChunk(ctx, c);
+                    if (p.onFinish)
+                        p.onFinish(ctx);
+                }
+            });
+            issue(releasesAt(slot), cmd);
+        }
+        return;
+    }
+
+    /* Runs of Compute/Copy passes record side by side, one secondary
+       each (their barriers go in first).  Graphics passes begin render
+       passes, which a secondary can't, so they – like primaryOnly and
+       chunked passes – record on the primary and split the runs.
+       Secondaries execute in slot order, so the submitted stream is the
+       same as the serial one. */
+    auto onPrimary = [&](std::size_t slot) {
+        const RenderPass& p = passAt(slot);
+        return p.type == PassType::Graphics || p.primaryOnly || p.chunkCount > 0;
+    };
+    std::vector<gfx::CmdHandle> secondaries;
+    for (std::size_t i = 0; i < slots.size();) {
+        const RenderPass& p = passAt(slots[i]);
+        if (onPrimary(slots[i])) {
+            timed(slots[i], cmd, [&] {
+                const RenderPass::ExecCtx ctx = contextFor(frame, slots[i], cmd, p.chunkCount > 0);
+                if (p.onExecute)
+                    p.onExecute(ctx);
+                if (!ctx.secondaryContents)
+                    return;
+                secondaries.assign(p.chunkCount, {});
+                core::jobs::JobSystem::parallelFor(p.chunkCount, 1, [&](std::size_t b, std::size_t e) {
+                    for (std::size_t c = b; c < e; ++c) {
+                        const gfx::CmdHandle sec = device->beginSecondary(cmd, true);
+                        if (p.onChunk)
+                            p.onChunk({frame, this, device, sec}, static_cast<uint32_t>(c));
+                        device->endSecondary(sec);
+                        secondaries[c] = sec;
+                    }
+                });
+                device->cmdExecuteSecondaries(cmd, secondaries);
+                if (p.onFinish)
+                    p.onFinish(ctx);
+            });
+            issue(releasesAt(slots[i]), cmd);
+            ++i;
+            continue;
+        }
+
+        std::size_t runEnd = i + 1;
+        while (runEnd < slots.size() && !onPrimary(slots[runEnd]))
+            ++runEnd;
+        secondaries.assign(runEnd - i, {});
+        core::jobs::JobSystem::parallelFor(runEnd - i, 1, [&, first = i](std::size_t b, std::size_t e) {
+            for (std::size_t k = b; k < e; ++k) {
+                const std::size_t slot = slots[first + k];
+                const RenderPass& rp = passAt(slot);
+                const gfx::CmdHandle sec = device->beginSecondary(cmd, false);
+                timed(slot, sec, [&] {
+                    if (rp.onExecute)
+                        rp.onExecute(contextFor(frame, slot, sec, false));
+                });
+                issue(releasesAt(slot), sec);
+                device->endSecondary(sec);
+                secondaries[k] = sec;
+            }
+        });
+        device->cmdExecuteSecondaries(cmd, secondaries);
+        i = runEnd;
     }
 }
 
@@ -2,46 +2,382 @@
 #include "RenderPass.h"
 #include "RenderResource.h"
 #include "core/util/Logger.h"
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace gfx {
 
-/* Very first-cut framegraph -------------------------------------------------- */
+/* Why pass `from` has to run before pass `to` */
+enum class Hazard : uint8_t { ReadAfterWrite, WriteAfterWrite, WriteAfterRead };
+
+struct GraphEdge {
+    int from;
+    int to;
+    int resource; // the resource that forces the order
+    Hazard hazard;
+};
+
+/* Where a transient resource lives, valid after compile() */
+struct TransientPlacement {
+    int heap{-1}; // -1: imported or culled, not placed
+    uint64_t offset{0};
+    uint64_t size{0};
+    int firstSlot{0}, lastSlot{0}; // execution slots that touch it
+};
+
+/* Passes submitted together to one queue, valid after compile().
+   Batches are listed (and submitted) in an order where every wait
+   refers to an earlier batch. */
+struct QueueBatch {
+    QueueType queue{QueueType::Graphics};
+    std::vector<std::size_t> slots; // execution slots, ascending
+    int wait{-1};                   // batch on the other queue this one waits for, or -1
+    bool signals{false};            // a later batch waits for this one
+};
+
+/* Consecutive graphics passes recorded into one render pass instance,
+   valid after compile().  color/depth are the attachments (invalid:
+   none the graph knows); ops are for the whole group – loads as the
+   first pass needs, stores only what is used after the last. */
+struct RenderPassGroup {
+    std::size_t firstSlot{0}, lastSlot{0};
+    ResourceId color, depth;
+    RenderPassOps ops;
+};
+
+/* Last measured cost of a pass.  cpuSeconds: execute() recording it
+   (barriers and callbacks, on whichever thread recorded it).
+   gpuSeconds: between the timestamps around it, read back once its
+   frame retired – so a few frames behind, and < 0 until the backend
+   delivered one. */
+struct PassCost {
+    double cpuSeconds{0.0};
+    double gpuSeconds{-1.0};
+};
+
+/* How much the last compile() had to redo */
+enum class CompileScope : uint8_t {
+    Reused,   // declarations unchanged – nothing rebuilt
+    Barriers, // only imported handles/states changed – barriers re-planned
+    Memory,   // resource descriptions changed – transients re-placed and reallocated
+    Full,     // passes, accesses or outputs changed – everything rebuilt
+};
+
+struct TransientMemoryStats {
+    uint64_t requestedBytes{0}; // every transient in its own (aligned) allocation
+    uint64_t heapBytes{0};      // what the aliased heaps take
+    uint32_t heapCount{0};
+
+    uint64_t savedBytes() const noexcept {
+        return requestedBytes > heapBytes ? requestedBytes - heapBytes : 0;
+    }
+};
+
+/* ----------------------------------------------------------------- *
+   Framegraph: passes declare what they read and write, compile()
+   derives the order
+   * The builder hands out ResourceId/PassId indices; names are kept
+     for logs and error messages only.  Name-based overloads resolve
+     once at declaration, so execution never hashes or compares strings
+   * Passes may be declared in any order.  A resource with several
+     writers is versioned by declaration order: a read sees the last
+     writer declared before it (or the first writer, if none is)
+   * Edges: writer → reader (RAW), writer → next writer (WAW), reader
+     → next writer (WAR, so nobody overwrites data still to be read)
+   * Kahn sort, ties broken by declaration order; a cycle throws
+     std::runtime_error naming the passes and resources involved
+   * Dead-pass culling: once outputs are marked, only passes they
+     (or a sideEffects pass) depend on through RAW/WAW edges run;
+     resources no surviving pass touches are never allocated.  With
+     no outputs marked nothing is culled
+   * Barriers: every access carries a ResourceUsage; compile() tracks
+     each resource's state along the execution order and emits a
+     barrier only where the layout changes or a write is involved
+     (read → read in one layout needs none).  All barriers in front
+     of a pass go out in one IRenderBackend::cmdBarriers() call;
+     imported resources get a last batch back to their finalUsage
+   * Transients (every non-imported resource) live only between their
+     first and last execution slot.  They are placed into one heap per
+     memory-type set, largest first, at the lowest offset free of
+     every resource whose lifetime overlaps – so a G-buffer and the
+     post chain after it share memory.  The first barrier on reused
+     memory waits for the previous occupant (previousAlias)
+   * Caching: compile() hashes the declarations in three layers –
+     topology (passes, accesses, outputs), memory (descriptions,
+     aliasing) and bindings (imported handles and states) – and
+     redoes only the stages whose layer changed.  reset() drops the
+     declarations but keeps the compiled result, so the graph can be
+     declared afresh every frame; callbacks are always the latest ones.
+     Transient memory a recompile replaces lives on until the frames
+     in flight are done with it (setFramesInFlight)
+   * Async compute (setAsyncCompute): Compute passes go to the
+     backend's compute queue.  A pass touching a resource last used on
+     the other queue starts a new batch that waits for the batch of
+     that use, and the resource changes hands with a Release/Acquire
+     barrier pair.  Waiting on a batch covers every earlier one of its
+     queue, so each batch waits for at most one.  Transients used on
+     the async queue don't alias, and a compute pass that would be
+     first to touch an imported resource's contents stays on graphics
+   * Render passes: a graphics pass's attachments are its Color/Depth
+     Attachment accesses.  A pass joins the one before it when both
+     use the same attachments and it needs no barrier except attachment
+     → same attachment, which rasterization order covers inside one
+     render pass; chunked and clearing passes start their own.  Loads
+     are Clear (clearsAttachments), Load when the attachment has
+     contents by then, DontCare otherwise; stores are DontCare unless
+     a later pass uses the attachment, it is an output, or an imported
+     resource leaves in a defined state.  Merging attachments
+     that differ into several subpasses would need pipelines built per
+     subpass, which the backend doesn't do
+ * ----------------------------------------------------------------- */
 class RenderGraph {
   public:
+    RenderGraph() = default;
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+    ~RenderGraph(); // releaseMemory()
+
     /* Resource & pass creation */
-    RenderResource& addTexture(const std::string& name, const TextureDesc& desc);
-    RenderResource& addBuffer(const std::string& name, const BufferDesc& desc);
+    ResourceId addTexture(const std::string& name, const TextureDesc& desc);
+    ResourceId addBuffer(const std::string& name, const BufferDesc& desc);
+
+    /* Owned outside the graph: never allocated, starts every frame as
+       initialUsage and is left as finalUsage (Undefined = don't care) */
+    ResourceId importTexture(const std::string& name, const TextureDesc& desc, TextureHandle handle,
+                             ResourceUsage initialUsage, ResourceUsage finalUsage);
+
+    /* Usage left Undefined (or names only) picks the default for the pass type:
+       Graphics reads Sampled/Uniform, writes Color/DepthAttachment; Compute
+       Sampled/Storage; Copy TransferSrc/TransferDst.  A defaulted read of
+       something the pass also writes takes the write's usage.  Unknown
+       names throw std::runtime_error */
+    PassId addPass(const std::string& name, PassType type, std::vector<ResourceAccess> reads,
+                   std::vector<ResourceAccess> writes, RenderPass::ExecuteFn exec);
+    PassId addPass(const std::string& name, PassType type, std::span<const std::string> reads,
+                   std::span<const std::string> writes, RenderPass::ExecuteFn exec);
+
+    RenderResource& resource(ResourceId id) {
+        return m_resources[id.index];
+    }
+    const RenderResource& resource(ResourceId id) const {
+        return m_resources[id.index];
+    }
+    TextureHandle texture(ResourceId id) const {
+        return std::get<TextureHandle>(m_resources[id.index].handle);
+    }
+    BufferHandle buffer(ResourceId id) const {
+        return std::get<BufferHandle>(m_resources[id.index].handle);
+    }
+    /* Build-time lookup; invalid id if there is no such resource */
+    ResourceId findResource(const std::string& name) const;
 
-    RenderPass& addPass(const std::string& name, PassType type, std::span<const std::string> reads,
-                        std::span<const std::string> writes, RenderPass::ExecuteFn exec);
+    RenderPass& pass(PassId id) {
+        return m_passes[id.index];
+    }
+    const RenderPass& pass(PassId id) const {
+        return m_passes[id.index];
+    }
+
+    /* Resources whose final contents leave the graph (swapchain, readback, …) */
+    void markOutput(ResourceId resource);
+    void markOutput(const std::string& resource);
 
-    RenderResource& resource(const std::string& n) {
-        return m_resources[m_resourceIndex.at(n)];
+    /* Off: every transient gets its own memory (to rule out aliasing bugs) */
+    void setAliasingEnabled(bool on) noexcept {
+        m_aliasing = on;
     }
-    const RenderResource& resource(const std::string& n) const {
-        return m_resources[m_resourceIndex.at(n)];
+
+    /* On: Compute passes run on the async compute queue when the backend
+       has one, overlapping the graphics work they don't depend on */
+    void setAsyncCompute(bool on) noexcept {
+        m_asyncCompute = on;
     }
 
+    /* On: execute() records Compute/Copy passes and pass chunks on
+       JobSystem workers into secondary command buffers and stitches them
+       in execution order; Graphics passes stay on the primary (see
+       RenderPass).  Ignored while the JobSystem isn't running. */
+    void setParallelRecording(bool on) noexcept {
+        m_parallel = on;
+    }
+
+    /* Forget all resources, passes and outputs (ids restart at 0); the
+       compiled result stays cached for the next compile() */
+    void reset();
+
+    /* How many frames the GPU may still be working on behind execute()
+       (1..8).  Transient memory a recompile replaces is destroyed that
+       many frames later, once no frame in flight can touch it */
+    void setFramesInFlight(uint32_t frames);
+
+    /* Destroy every transient resource and heap now, retired ones too,
+       and drop the compiled result.  Only with the device idle, e.g.
+       between preShutdown() and shutdown() */
+    void releaseMemory();
+
     /* Offline */
-    void compile(); // topological sort + basic validation
+    void compile(); // dependency edges + topological sort + validation; throws std::runtime_error
+    CompileScope lastCompileScope() const noexcept {
+        return m_lastScope;
+    }
+
+    /* Per-frame; not from inside a JobSystem job.  Returns the graphics
+       command buffer the frame continues in – with async compute the
+       graph submits earlier batches itself and cmd may have been one */
+    gfx::CmdHandle execute(uint64_t frame, gfx::CmdHandle cmd);
+
+    /* Introspection, valid after compile() */
+    std::span<const int> executionOrder() const noexcept {
+        return m_execOrder;
+    }
+    std::span<const GraphEdge> edges() const noexcept {
+        return m_edges;
+    }
+    std::size_t passCount() const noexcept {
+        return m_passes.size();
+    }
+    bool isCulled(PassId pass) const {
+        return !m_passLive.empty() && !m_passLive[pass.index];
+    }
+    bool isResourceUsed(ResourceId resource) const {
+        return m_resourceLive.empty() || m_resourceLive[resource.index];
+    }
+    const TransientPlacement& placement(ResourceId resource) const {
+        return m_placements[resource.index];
+    }
+    const TransientMemoryStats& transientMemory() const noexcept {
+        return m_memoryStats;
+    }
+    /* Barriers issued before executionOrder()[slot]; slot == executionOrder().size()
+       is the final batch for imported resources */
+    std::span<const ResourceBarrier> barriersAt(std::size_t slot) const {
+        if (slot + 1 >= m_barrierStart.size())
+            return {};
+        return std::span<const ResourceBarrier>(m_barriers).subspan(m_barrierStart[slot],
+                                                                    m_barrierStart[slot + 1] - m_barrierStart[slot]);
+    }
+    /* Queue-ownership releases issued right after executionOrder()[slot], on its queue */
+    std::span<const ResourceBarrier> releasesAt(std::size_t slot) const {
+        if (slot + 1 >= m_releaseStart.size())
+            return {};
+        return std::span<const ResourceBarrier>(m_releases).subspan(m_releaseStart[slot],
+                                                                    m_releaseStart[slot + 1] - m_releaseStart[slot]);
+    }
+    QueueType queueOf(std::size_t slot) const {
+        return m_slotQueue[slot];
+    }
+    std::span<const QueueBatch> queueBatches() const noexcept {
+        return m_batches;
+    }
+    std::span<const RenderPassGroup> renderPassGroups() const noexcept {
+        return m_groups;
+    }
+    /* index into renderPassGroups(), -1 for passes without attachments */
+    int renderPassGroupOf(std::size_t slot) const {
+        return m_slotGroup[slot];
+    }
+    PassCost passCost(PassId pass) const {
+        return pass.index < static_cast<int>(m_costs.size()) ? m_costs[pass.index] : PassCost{};
+    }
 
-    /* Per-frame */
-    void execute(uint64_t frame, gfx::CmdHandle cmd);
+    /* Dumps of the compiled graph for finding expensive nodes: passes
+       (culled ones included), resources with their placement and the
+       resources they alias, dependency edges, barriers, queue batches
+       and render pass groups, with each pass's PassCost.  exportDot()
+       is Graphviz (`dot -Tsvg`), shading passes by cost; exportJson()
+       carries the same for tooling.  Throw std::runtime_error before
+       the first compile() */
+    std::string exportDot() const;
+    std::string exportJson() const;
 
   private:
-    void topoSort(int node, std::vector<int>& out, std::vector<int>& mark);
+    struct PassIo { // resource indices resolved from the declared names
+        std::vector<int> reads, writes;
+        std::vector<ResourceUsage> readUsage, writeUsage; // defaults resolved
+    };
+
+    void resolveResources();
+    void buildEdges();
+    void sortPasses();
+    void cullPasses();
+    void scheduleQueues();
+    void placeTransients();
+    void allocateTransients();
+    void retireTransients();
+    void destroyRetired(uint64_t frame);
+    void planBarriers();
+    void recordSlots(uint64_t frame, std::span<const std::size_t> slots, gfx::CmdHandle cmd, bool parallel);
+    RenderPass::ExecCtx contextFor(uint64_t frame, std::size_t slot, gfx::CmdHandle cmd, bool secondaryContents);
+
+    struct DeclarationHash {
+        uint64_t topology{0}, memory{0}, bindings{0};
+    };
+    DeclarationHash hashDeclarations() const;
+    std::string describeCycle(const std::vector<int>& inDegree) const;
+    void collectGpuTimes(const gfx::IRenderBackend::TimestampReadback& readback);
+    void checkExportable() const;
 
     std::unordered_map<std::string, int> m_resourceIndex;
     std::vector<RenderResource> m_resources;
 
     std::vector<RenderPass> m_passes;
-    std::vector<std::vector<int>> m_edges; // pass dependency DAG
-    std::vector<int> m_execOrder;          // valid after compile()
+    std::vector<PassIo> m_passIo;
+    std::vector<GraphEdge> m_edges; // pass dependency DAG, one edge per ordered pair
+    std::vector<int> m_execOrder;   // valid after compile(), culled passes excluded
+    std::vector<ResourceId> m_outputs;
+    std::vector<char> m_passLive, m_resourceLive;
+    std::vector<ResourceBarrier> m_barriers;
+    std::vector<std::size_t> m_barrierStart; // per execution slot + final batch, into m_barriers
+    std::vector<int> m_barrierResource;      // per m_barriers entry, for the exports
+    std::vector<ResourceBarrier> m_releases;
+    std::vector<int> m_releaseResource; // per m_releases entry
+    std::vector<std::size_t> m_releaseStart; // per execution slot, into m_releases
+    std::vector<QueueType> m_slotQueue;      // per execution slot
+    std::vector<QueueBatch> m_batches;
+    std::vector<RenderPassGroup> m_groups;
+    std::vector<int> m_slotGroup; // per execution slot, into m_groups or -1
+
+    /* timestamps 2·slot and 2·slot + 1 bracket a pass; the execution
+       order is kept per frame until its timestamps come back */
+    static constexpr std::size_t kTimedFrames = 8; // ≥ frames in flight
+    std::vector<PassCost> m_costs;                 // per pass
+    std::array<std::pair<uint64_t, std::vector<int>>, kTimedFrames> m_timedOrder{};
+
+    struct Heap {
+        HeapDesc desc;
+        ResourceType kind;
+        HeapHandle handle;
+    };
+    bool m_aliasing{true};
+    bool m_parallel{false};
+    bool m_asyncCompute{false};
+    std::vector<TransientPlacement> m_placements; // per resource
+    std::vector<int> m_aliasPredecessor;          // per resource: last earlier occupant of its memory, or -1
+    std::vector<Heap> m_heaps;
+    std::vector<std::variant<TextureHandle, BufferHandle>> m_transientHandles; // per resource, while placed
+
+    /* memory of earlier compiles, destroyed framesInFlight frames after
+       the last execute() that could use it */
+    struct Retired {
+        uint64_t frame;
+        std::vector<std::variant<TextureHandle, BufferHandle>> resources;
+        std::vector<HeapHandle> heaps;
+    };
+    std::deque<Retired> m_retired;
+    uint32_t m_framesInFlight{2};
+    uint64_t m_lastFrame{0}; // last frame execute() recorded
+    TransientMemoryStats m_memoryStats;
+
+    bool m_compiled{false};
+    DeclarationHash m_hash;
+    CompileScope m_lastScope{CompileScope::Full};
 };
 
 } // namespace gfx
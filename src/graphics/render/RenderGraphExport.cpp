@@ -0,0 +1,334 @@
+#include "RenderGraph.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- Export */
+namespace {
+
+const char* toString(PassType t) {
+    switch (t) {
+    case PassType::Graphics:
+        return "Graphics";
+    case PassType::Compute:
+        return "Compute";
+    case PassType::Copy:
+        return "Copy";
+    }
+    return "?";
+}
+
+const char* toString(QueueType q) {
+    return q == QueueType::AsyncCompute ? "AsyncCompute" : "Graphics";
+}
+
+const char* toString(ResourceUsage u) {
+    switch (u) {
+    case ResourceUsage::Undefined:
+        return "Undefined";
+    case ResourceUsage::ColorAttachment:
+        return "ColorAttachment";
+    case ResourceUsage::DepthAttachment:
+        return "DepthAttachment";
+    case ResourceUsage::Sampled:
+        return "Sampled";
+    case ResourceUsage::Storage:
+        return "Storage";
+    case ResourceUsage::TransferSrc:
+        return "TransferSrc";
+    case ResourceUsage::TransferDst:
+        return "TransferDst";
+    case ResourceUsage::Present:
+        return "Present";
+    case ResourceUsage::VertexBuffer:
+        return "VertexBuffer";
+    case ResourceUsage::IndexBuffer:
+        return "IndexBuffer";
+    case ResourceUsage::Uniform:
+        return "Uniform";
+    }
+    return "?";
+}
+
+const char* toString(Hazard h) {
+    switch (h) {
+    case Hazard::ReadAfterWrite:
+        return "ReadAfterWrite";
+    case Hazard::WriteAfterWrite:
+        return "WriteAfterWrite";
+    case Hazard::WriteAfterRead:
+        return "WriteAfterRead";
+    }
+    return "?";
+}
+
+const char* toString(QueueTransfer t) {
+    switch (t) {
+    case QueueTransfer::None:
+        return "None";
+    case QueueTransfer::Release:
+        return "Release";
+    case QueueTransfer::Acquire:
+        return "Acquire";
+    }
+    return "?";
+}
+
+const char* toString(LoadOp op) {
+    switch (op) {
+    case LoadOp::Load:
+        return "Load";
+    case LoadOp::Clear:
+        return "Clear";
+    case LoadOp::DontCare:
+        return "DontCare";
+    }
+    return "?";
+}
+
+const char* toString(StoreOp op) {
+    return op == StoreOp::Store ? "Store" : "DontCare";
+}
+
+/* contents of a JSON string or quoted DOT id – names are user-chosen */
+std::string escaped(std::string_view s) {
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string milliseconds(double seconds) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.3f", seconds * 1e3);
+    return buf;
+}
+
+/* Other transients sharing bytes of r's heap range – they take turns in it */
+std::vector<int> aliasesOf(std::span<const TransientPlacement> placements, std::size_t r) {
+    std::vector<int> out;
+    const TransientPlacement& a = placements[r];
+    if (a.heap < 0)
+        return out;
+    for (std::size_t q = 0; q < placements.size(); ++q) {
+        const TransientPlacement& b = placements[q];
+        if (q != r && b.heap == a.heap && b.offset < a.offset + a.size && a.offset < b.offset + b.size)
+            out.push_back(static_cast<int>(q));
+    }
+    return out;
+}
+
+} // namespace
+
+void RenderGraph::checkExportable() const {
+    if (!m_compiled || m_passLive.size() != m_passes.size() || m_placements.size() != m_resources.size())
+        throw std::runtime_error("RenderGraph: nothing to export before compile()");
+}
+
+std::string RenderGraph::exportJson() const {
+    checkExportable();
+    std::vector<int> slotOf(m_passes.size(), -1);
+    for (std::size_t slot = 0; slot < m_execOrder.size(); ++slot)
+        slotOf[m_execOrder[slot]] = static_cast<int>(slot);
+
+    std::ostringstream js;
+    js << "{\n  \"passes\": [";
+    for (std::size_t p = 0; p < m_passes.size(); ++p) {
+        const RenderPass& pass = m_passes[p];
+        const int slot = slotOf[p];
+        const PassCost cost = passCost(PassId{static_cast<int>(p)});
+        js << (p ? "," : "") << "\n    {\"id\": " << p << ", \"name\": \"" << escaped(pass.name) << "\", \"type\": \""
+           << toString(pass.type) << "\", \"culled\": " << (m_passLive[p] ? "false" : "true") << ", \"slot\": " << slot;
+        if (slot >= 0)
+            js << ", \"queue\": \"" << toString(m_slotQueue[slot]) << "\", \"renderPass\": " << m_slotGroup[slot];
+        for (const auto& [key, list, usage] : {std::tuple{"reads", &m_passIo[p].reads, &m_passIo[p].readUsage},
+                                               std::tuple{"writes", &m_passIo[p].writes, &m_passIo[p].writeUsage}}) {
+            js << ", \"" << key << "\": [";
+            for (std::size_t i = 0; i < list->size(); ++i)
+                js << (i ? ", " : "") << "{\"resource\": " << (*list)[i] << ", \"usage\": \""
+                   << toString((*usage)[i]) << "\"}";
+            js << "]";
+        }
+        js << ", \"cpuMs\": " << milliseconds(cost.cpuSeconds)
+           << ", \"gpuMs\": " << (cost.gpuSeconds < 0 ? std::string("null") : milliseconds(cost.gpuSeconds)) << "}";
+    }
+
+    js << "\n  ],\n  \"resources\": [";
+    for (std::size_t r = 0; r < m_resources.size(); ++r) {
+        const RenderResource& res = m_resources[r];
+        const TransientPlacement& at = m_placements[r];
+        const bool output = std::find(m_outputs.begin(), m_outputs.end(), ResourceId{static_cast<int>(r)}) !=
+                            m_outputs.end();
+        js << (r ? "," : "") << "\n    {\"id\": " << r << ", \"name\": \"" << escaped(res.name) << "\", \"type\": \""
+           << (res.type == ResourceType::Texture ? "Texture" : "Buffer") << "\", \"imported\": "
+           << (res.imported ? "true" : "false") << ", \"output\": " << (output ? "true" : "false")
+           << ", \"used\": " << (isResourceUsed(ResourceId{static_cast<int>(r)}) ? "true" : "false");
+        if (at.heap >= 0) {
+            js << ", \"heap\": " << at.heap << ", \"offset\": " << at.offset << ", \"size\": " << at.size
+               << ", \"firstSlot\": " << at.firstSlot << ", \"lastSlot\": " << at.lastSlot << ", \"aliases\": [";
+            const std::vector<int> aliases = aliasesOf(m_placements, r);
+            for (std::size_t i = 0; i < aliases.size(); ++i)
+                js << (i ? ", " : "") << aliases[i];
+            js << "]";
+        }
+        js << "}";
+    }
+
+    js << "\n  ],\n  \"edges\": [";
+    for (std::size_t e = 0; e < m_edges.size(); ++e)
+        js << (e ? "," : "") << "\n    {\"from\": " << m_edges[e].from << ", \"to\": " << m_edges[e].to
+           << ", \"resource\": " << m_edges[e].resource << ", \"hazard\": \"" << toString(m_edges[e].hazard) << "\"}";
+
+    /* slot == passes executed: the final batch for imported resources */
+    js << "\n  ],\n  \"barriers\": [";
+    bool first = true;
+    auto barrier = [&](std::size_t slot, int resource, const ResourceBarrier& b, const char* when) {
+        js << (first ? "" : ",") << "\n    {\"slot\": " << slot << ", \"when\": \"" << when
+           << "\", \"resource\": " << resource << ", \"before\": \"" << toString(b.before) << "\", \"after\": \""
+           << toString(b.after) << "\", \"transfer\": \"" << toString(b.transfer) << "\", \"aliasing\": "
+           << (b.previousAlias != ResourceUsage::Undefined ? "true" : "false") << "}";
+        first = false;
+    };
+    for (std::size_t slot = 0; slot + 1 < m_barrierStart.size(); ++slot)
+        for (std::size_t i = m_barrierStart[slot]; i < m_barrierStart[slot + 1]; ++i)
+            barrier(slot, m_barrierResource[i], m_barriers[i], "before");
+    for (std::size_t slot = 0; slot + 1 < m_releaseStart.size(); ++slot)
+        for (std::size_t i = m_releaseStart[slot]; i < m_releaseStart[slot + 1]; ++i)
+            barrier(slot, m_releaseResource[i], m_releases[i], "after");
+
+    js << "\n  ],\n  \"batches\": [";
+    for (std::size_t b = 0; b < m_batches.size(); ++b) {
+        js << (b ? "," : "") << "\n    {\"queue\": \"" << toString(m_batches[b].queue) << "\", \"slots\": [";
+        for (std::size_t i = 0; i < m_batches[b].slots.size(); ++i)
+            js << (i ? ", " : "") << m_batches[b].slots[i];
+        js << "], \"wait\": " << m_batches[b].wait << ", \"signals\": " << (m_batches[b].signals ? "true" : "false")
+           << "}";
+    }
+
+    js << "\n  ],\n  \"renderPasses\": [";
+    for (std::size_t g = 0; g < m_groups.size(); ++g) {
+        const RenderPassGroup& group = m_groups[g];
+        js << (g ? "," : "") << "\n    {\"firstSlot\": " << group.firstSlot << ", \"lastSlot\": " << group.lastSlot
+           << ", \"color\": " << group.color.index << ", \"colorLoad\": \"" << toString(group.ops.color.load)
+           << "\", \"colorStore\": \"" << toString(group.ops.color.store) << "\", \"depth\": " << group.depth.index
+           << ", \"depthLoad\": \"" << toString(group.ops.depth.load) << "\", \"depthStore\": \""
+           << toString(group.ops.depth.store) << "\"}";
+    }
+
+    js << "\n  ],\n  \"memory\": {\"heapCount\": " << m_memoryStats.heapCount
+       << ", \"heapBytes\": " << m_memoryStats.heapBytes << ", \"requestedBytes\": " << m_memoryStats.requestedBytes
+       << "}\n}\n";
+    return js.str();
+}
+
+std::string RenderGraph::exportDot() const {
+    checkExportable();
+    std::vector<int> slotOf(m_passes.size(), -1);
+    for (std::size_t slot = 0; slot < m_execOrder.size(); ++slot)
+        slotOf[m_execOrder[slot]] = static_cast<int>(slot);
+
+    /* shade by GPU time where there is one, recording time otherwise */
+    auto costOf = [&](std::size_t p) {
+        const PassCost c = passCost(PassId{static_cast<int>(p)});
+        return c.gpuSeconds >= 0 ? c.gpuSeconds : c.cpuSeconds;
+    };
+    double maxCost = 0.0;
+    for (std::size_t p = 0; p < m_passes.size(); ++p)
+        maxCost = std::max(maxCost, costOf(p));
+
+    std::ostringstream dot;
+    dot << "digraph RenderGraph {\n  rankdir=LR;\n  node [fontname=\"Helvetica\", fontsize=10];\n"
+        << "  edge [fontname=\"Helvetica\", fontsize=8];\n";
+
+    auto passNode = [&](std::size_t p, const char* indent) {
+        const RenderPass& pass = m_passes[p];
+        const int slot = slotOf[p];
+        const PassCost cost = passCost(PassId{static_cast<int>(p)});
+        dot << indent << "p" << p << " [shape=box, label=\"" << escaped(pass.name) << "\\n" << toString(pass.type);
+        if (slot < 0) {
+            dot << " · culled\", style=dashed, fontcolor=gray50, color=gray50];\n";
+            return;
+        }
+        const std::size_t barriers = barriersAt(static_cast<std::size_t>(slot)).size();
+        dot << " · slot " << slot << " · " << toString(m_slotQueue[slot]) << "\\ncpu "
+            << milliseconds(cost.cpuSeconds) << " ms";
+        if (cost.gpuSeconds >= 0)
+            dot << " · gpu " << milliseconds(cost.gpuSeconds) << " ms";
+        if (barriers > 0)
+            dot << "\\n" << barriers << (barriers == 1 ? " barrier" : " barriers");
+        char fill[32];
+        std::snprintf(fill, sizeof(fill), "0.000 %.3f 1.000", maxCost > 0 ? costOf(p) / maxCost : 0.0);
+        dot << "\", style=filled, fillcolor=\"" << fill << "\"];\n";
+    };
+
+    /* merged render passes as clusters, everything else at top level */
+    std::vector<char> clustered(m_passes.size(), 0);
+    for (std::size_t g = 0; g < m_groups.size(); ++g) {
+        const RenderPassGroup& group = m_groups[g];
+        dot << "  subgraph cluster_rp" << g << " {\n    label=\"render pass " << g;
+        if (group.color.valid())
+            dot << "\\ncolor " << toString(group.ops.color.load) << "/" << toString(group.ops.color.store);
+        if (group.depth.valid())
+            dot << "\\ndepth " << toString(group.ops.depth.load) << "/" << toString(group.ops.depth.store);
+        dot << "\";\n    style=dashed;\n";
+        for (std::size_t slot = group.firstSlot; slot <= group.lastSlot; ++slot) {
+            passNode(static_cast<std::size_t>(m_execOrder[slot]), "    ");
+            clustered[m_execOrder[slot]] = 1;
+        }
+        dot << "  }\n";
+    }
+    for (std::size_t p = 0; p < m_passes.size(); ++p)
+        if (!clustered[p])
+            passNode(p, "  ");
+
+    for (std::size_t r = 0; r < m_resources.size(); ++r) {
+        const RenderResource& res = m_resources[r];
+        const TransientPlacement& at = m_placements[r];
+        dot << "  r" << r << " [shape=" << (res.imported ? "doubleoctagon" : "ellipse") << ", label=\""
+            << escaped(res.name);
+        if (const auto* t = std::get_if<TextureDesc>(&res.desc); t && !res.imported)
+            dot << "\\n" << t->width << "x" << t->height;
+        if (at.heap >= 0)
+            dot << "\\nheap " << at.heap << " @ " << at.offset;
+        dot << "\"" << (isResourceUsed(ResourceId{static_cast<int>(r)}) ? "" : ", fontcolor=gray50, color=gray50")
+            << "];\n";
+    }
+
+    for (std::size_t p = 0; p < m_passes.size(); ++p) {
+        const PassIo& io = m_passIo[p];
+        for (std::size_t i = 0; i < io.reads.size(); ++i)
+            dot << "  r" << io.reads[i] << " -> p" << p << " [label=\"" << toString(io.readUsage[i]) << "\"];\n";
+        for (std::size_t i = 0; i < io.writes.size(); ++i)
+            dot << "  p" << p << " -> r" << io.writes[i] << " [label=\"" << toString(io.writeUsage[i])
+                << "\", color=firebrick];\n";
+    }
+    /* orderings no access edge shows */
+    for (const GraphEdge& e : m_edges)
+        if (e.hazard != Hazard::ReadAfterWrite)
+            dot << "  p" << e.from << " -> p" << e.to << " [style=dotted, label=\"" << toString(e.hazard) << "\"];\n";
+    for (std::size_t r = 0; r < m_resources.size(); ++r)
+        for (int q : aliasesOf(m_placements, r))
+            if (q > static_cast<int>(r))
+                dot << "  r" << r << " -> r" << q << " [style=dashed, dir=none, color=gray50, label=\"aliases\"];\n";
+    dot << "}\n";
+    return dot.str();
+}
+
+} // namespace gfx
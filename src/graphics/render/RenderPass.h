@@ -1,4 +1,5 @@
 #pragma once
+#include "RenderResource.h"
 #include "backend/include/IRenderBackend.h"
 #include <functional>
 #include <string>
@@ -6,16 +7,24 @@
 
 namespace gfx {
 
-struct RenderResource;
-
 enum class PassType { Graphics, Compute, Copy };
 
+/* Handed out by RenderGraph::addPass */
+struct PassId {
+    int index{-1};
+
+    bool valid() const noexcept {
+        return index >= 0;
+    }
+    friend bool operator==(PassId, PassId) = default;
+};
+
 /* A node in the graph: declares reads/writes + lambda to record work */
 struct RenderPass {
     std::string name;
     PassType type{PassType::Graphics};
-    std::vector<std::string> reads;
-    std::vector<std::string> writes;
+    std::vector<ResourceAccess> reads;
+    std::vector<ResourceAccess> writes;
 
     /* Callback invoked at execution time.
        Args: this pass’ index, user-opaque context ptr (later), frame number. */
@@ -24,9 +33,46 @@ struct RenderPass {
         class RenderGraph* graph; // query handles if needed
         gfx::IRenderBackend* device;
         gfx::CmdHandle cmd;
+        bool secondaryContents{false}; // chunked pass: begin render passes with secondary contents
+
+        /* Render-pass merging: consecutive passes drawing to the same
+           attachments share one render pass instance.  Begin and end
+           through these, so a merged pass skips the begin (or the end)
+           and the compiled load/store ops are applied. */
+        RenderPassOps attachmentOps{};
+        bool continuesRenderPass{false}; // the previous pass left its render pass open
+        bool keepsRenderPassOpen{false}; // the next pass draws into this one's
+
+        void beginRenderPass(void* pipeline, uint32_t fbIdx) const {
+            if (!continuesRenderPass)
+                device->cmdBeginRenderPass(cmd, pipeline, fbIdx, secondaryContents, attachmentOps);
+        }
+        void endRenderPass() const {
+            if (!keepsRenderPassOpen)
+                device->cmdEndRenderPass(cmd);
+        }
     };
     using ExecuteFn = std::function<void(const ExecCtx&)>;
     ExecuteFn onExecute;
+
+    bool sideEffects{false}; // never culled, even if nothing reads its output (readbacks, queries, …)
+    bool clearsAttachments{false}; // load op Clear: the previous contents are never read
+
+    /* Parallel recording (RenderGraph::setParallelRecording).  By default
+       a Compute or Copy pass records into its own secondary on a
+       JobSystem worker, so onExecute must only touch state the pass owns.
+       Graphics passes begin render passes, which only a primary can, so
+       they record on the primary – spread their draws with chunks.
+       * primaryOnly: record on the primary, on the calling thread
+       * chunkCount > 0: onExecute is a prologue on the primary (begin the
+         render pass here), then onChunk(ctx, 0…chunkCount-1) record in
+         parallel into secondaries that continue it, then onFinish closes
+         it on the primary.  Serially, the chunks run inline in order. */
+    using ChunkFn = std::function<void(const ExecCtx&, uint32_t chunk)>;
+    bool primaryOnly{false};
+    uint32_t chunkCount{0};
+    ChunkFn onChunk;
+    ExecuteFn onFinish;
 };
 
 } // namespace gfx
@@ -20,6 +20,57 @@ struct BufferDesc {
     uint64_t sizeBytes{0};
 };
 
+/* What a resource needs from the memory it is placed in */
+struct MemoryRequirements {
+    uint64_t size{0};
+    uint64_t alignment{1};
+    uint32_t memoryTypeBits{~0u}; // backend memory types the resource may live in
+};
+
+/* A block of device memory that placed resources are bound into */
+struct HeapDesc {
+    uint64_t sizeBytes{0};
+    uint32_t memoryTypeBits{~0u};
+};
+
+/* How a pass touches a resource – the backend maps each usage to a
+   layout, access mask and pipeline stage */
+enum class ResourceUsage : uint8_t {
+    Undefined, // contents don't matter (transients at frame start)
+    ColorAttachment,
+    DepthAttachment,
+    Sampled,
+    Storage,
+    TransferSrc,
+    TransferDst,
+    Present,
+    VertexBuffer,
+    IndexBuffer,
+    Uniform,
+};
+
+constexpr bool isWriteUsage(ResourceUsage u) noexcept {
+    return u == ResourceUsage::ColorAttachment || u == ResourceUsage::DepthAttachment || u == ResourceUsage::Storage ||
+           u == ResourceUsage::TransferDst;
+}
+
+/* Handed out by RenderGraph::addTexture/addBuffer/importTexture – an
+   index into the graph, so passes never look names up while recording */
+struct ResourceId {
+    int index{-1};
+
+    bool valid() const noexcept {
+        return index >= 0;
+    }
+    friend bool operator==(ResourceId, ResourceId) = default;
+};
+
+/* One declared read or write of a pass */
+struct ResourceAccess {
+    ResourceId resource;
+    ResourceUsage usage{ResourceUsage::Undefined};
+};
+
 struct RenderResource {
     std::string name;
     ResourceType type;
@@ -27,6 +78,55 @@ struct RenderResource {
 
     /* backend handle filled during RenderGraph::compile() */
     std::variant<gfx::TextureHandle, gfx::BufferHandle> handle;
+
+    /* imported resources (swapchain, persistent history, …) are owned
+       elsewhere: not allocated, and enter/leave each frame in these states */
+    bool imported{false};
+    ResourceUsage initialUsage{ResourceUsage::Undefined};
+    ResourceUsage finalUsage{ResourceUsage::Undefined};
+};
+
+/* What a render pass does with an attachment's contents on entry and exit */
+enum class LoadOp : uint8_t { Load, Clear, DontCare };
+enum class StoreOp : uint8_t { Store, DontCare };
+
+struct AttachmentOps {
+    LoadOp load{LoadOp::Load};
+    StoreOp store{StoreOp::Store};
+};
+
+/* Chosen by RenderGraph for a pass's colour and depth attachment.  The
+   defaults are for attachments the graph doesn't know: colour kept,
+   depth cleared and thrown away. */
+struct RenderPassOps {
+    AttachmentOps color{};
+    AttachmentOps depth{LoadOp::Clear, StoreOp::DontCare};
+};
+
+/* Where a pass is submitted; AsyncCompute overlaps the graphics queue */
+enum class QueueType : uint8_t { Graphics, AsyncCompute };
+
+/* Handing a resource from one queue to the other takes two barriers:
+   a Release recorded on srcQueue after its last use there, and an
+   Acquire recorded on dstQueue once the submissions are ordered */
+enum class QueueTransfer : uint8_t { None, Release, Acquire };
+
+/* A state change compiled by RenderGraph, already resolved to a backend
+   handle.  Every barrier of one pass boundary goes to the backend in a
+   single cmdBarriers() call. */
+struct ResourceBarrier {
+    std::variant<gfx::TextureHandle, gfx::BufferHandle> handle;
+    ResourceUsage before;
+    ResourceUsage after;
+    bool depth{false}; // depth aspect instead of colour
+
+    /* First use of memory another transient had earlier in the frame:
+       that resource's last usage, whose accesses have to finish first */
+    ResourceUsage previousAlias{ResourceUsage::Undefined};
+
+    QueueTransfer transfer{QueueTransfer::None};
+    QueueType srcQueue{QueueType::Graphics}; // queue of the last use (before)
+    QueueType dstQueue{QueueType::Graphics}; // queue of the next use (after)
 };
 
 } // namespace gfx
@@ -0,0 +1,244 @@
+#include "graphics/resources/BlockCompression.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gfx::bc {
+
+namespace {
+
+std::uint16_t pack565(const float c[3]) noexcept {
+    const auto q = [](float v, int maxV) {
+        return static_cast<std::uint16_t>(std::clamp(static_cast<int>(v / 255.f * maxV + 0.5f), 0, maxV));
+    };
+    return static_cast<std::uint16_t>((q(c[0], 31) << 11) | (q(c[1], 63) << 5) | q(c[2], 31));
+}
+
+void unpack565(std::uint16_t v, int out[3]) noexcept {
+    const int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+/* Principal axis of the block's colours by power iteration on the covariance */
+void principalAxis(const std::uint8_t* rgba, const float mean[3], float axis[3]) noexcept {
+    float cov[6]{}; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        const float r = rgba[i * 4 + 0] - mean[0];
+        const float g = rgba[i * 4 + 1] - mean[1];
+        const float b = rgba[i * 4 + 2] - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+    }
+    float v[3]{1.f, 1.f, 1.f};
+    for (int it = 0; it < 8; ++it) {
+        const float x = cov[0] * v[0] + cov[1] * v[1] + cov[2] * v[2];
+        const float y = cov[1] * v[0] + cov[3] * v[1] + cov[4] * v[2];
+        const float z = cov[2] * v[0] + cov[4] * v[1] + cov[5] * v[2];
+        const float len = std::max({std::fabs(x), std::fabs(y), std::fabs(z)});
+        if (len < 1e-6f)
+            break; // flat block – any axis will do
+        v[0] = x / len;
+        v[1] = y / len;
+        v[2] = z / len;
+    }
+    const float n = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    for (int k = 0; k < 3; ++k)
+        axis[k] = v[k] / n;
+}
+
+void put16(std::byte* p, std::uint16_t v) noexcept {
+    p[0] = static_cast<std::byte>(v & 0xFF);
+    p[1] = static_cast<std::byte>(v >> 8);
+}
+
+std::uint16_t get16(const std::byte* p) noexcept {
+    return static_cast<std::uint16_t>(std::to_integer<unsigned>(p[0]) | (std::to_integer<unsigned>(p[1]) << 8));
+}
+
+void encodeColor(const std::uint8_t* rgba, std::byte* out) noexcept {
+    float mean[3]{};
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 3; ++k)
+            mean[k] += rgba[i * 4 + k] / 16.f;
+
+    float axis[3];
+    principalAxis(rgba, mean, axis);
+
+    float tMin = 1e9f, tMax = -1e9f;
+    for (int i = 0; i < 16; ++i) {
+        float t = 0.f;
+        for (int k = 0; k < 3; ++k)
+            t += (rgba[i * 4 + k] - mean[k]) * axis[k];
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    /* inset by 1/16 of the range: endpoints hug the bulk of the colours, not outliers */
+    const float inset = (tMax - tMin) / 16.f;
+    float hi[3], lo[3];
+    for (int k = 0; k < 3; ++k) {
+        hi[k] = std::clamp(mean[k] + axis[k] * (tMax - inset), 0.f, 255.f);
+        lo[k] = std::clamp(mean[k] + axis[k] * (tMin + inset), 0.f, 255.f);
+    }
+
+    std::uint16_t c0 = pack565(hi), c1 = pack565(lo);
+    if (c0 < c1)
+        std::swap(c0, c1);
+    put16(out, c0);
+    put16(out + 2, c1);
+
+    std::uint32_t indices = 0;
+    if (c0 != c1) { // c0 > c1 → four-colour mode
+        int e0[3], e1[3], pal[4][3];
+        unpack565(c0, e0);
+        unpack565(c1, e1);
+        for (int k = 0; k < 3; ++k) {
+            pal[0][k] = e0[k];
+            pal[1][k] = e1[k];
+            pal[2][k] = (2 * e0[k] + e1[k]) / 3;
+            pal[3][k] = (e0[k] + 2 * e1[k]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int err = 0;
+                for (int k = 0; k < 3; ++k) {
+                    const int d = rgba[i * 4 + k] - pal[p][k];
+                    err += d * d;
+                }
+                if (err < bestErr) {
+                    bestErr = err;
+                    best = p;
+                }
+            }
+            indices |= static_cast<std::uint32_t>(best) << (2 * i);
+        }
+    }
+    for (int b = 0; b < 4; ++b)
+        out[4 + b] = static_cast<std::byte>((indices >> (8 * b)) & 0xFF);
+}
+
+void decodeColor(const std::byte* in, std::uint8_t* rgba, bool allowThreeColor) noexcept {
+    const std::uint16_t c0 = get16(in), c1 = get16(in + 2);
+    int pal[4][4];
+    unpack565(c0, pal[0]);
+    unpack565(c1, pal[1]);
+    pal[0][3] = pal[1][3] = pal[2][3] = pal[3][3] = 255;
+    for (int k = 0; k < 3; ++k) {
+        if (c0 > c1 || !allowThreeColor) {
+            pal[2][k] = (2 * pal[0][k] + pal[1][k]) / 3;
+            pal[3][k] = (pal[0][k] + 2 * pal[1][k]) / 3;
+        } else {
+            pal[2][k] = (pal[0][k] + pal[1][k]) / 2;
+            pal[3][k] = 0;
+        }
+    }
+    if (c0 <= c1 && allowThreeColor)
+        pal[3][3] = 0; // punch-through alpha
+
+    std::uint32_t indices = 0;
+    for (int b = 0; b < 4; ++b)
+        indices |= std::to_integer<std::uint32_t>(in[4 + b]) << (8 * b);
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 4; ++k)
+            rgba[i * 4 + k] = static_cast<std::uint8_t>(pal[(indices >> (2 * i)) & 3][k]);
+}
+
+} // namespace
+
+void encodeBC1(const std::uint8_t* rgba, std::byte* out) noexcept {
+    encodeColor(rgba, out);
+}
+
+void encodeBC3(const std::uint8_t* rgba, std::byte* out) noexcept {
+    std::uint8_t a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, rgba[i * 4 + 3]);
+        a1 = std::min(a1, rgba[i * 4 + 3]);
+    }
+    out[0] = static_cast<std::byte>(a0);
+    out[1] = static_cast<std::byte>(a1);
+
+    std::uint64_t indices = 0;
+    if (a0 != a1) { // a0 > a1 → eight interpolated values
+        int pal[8];
+        pal[0] = a0;
+        pal[1] = a1;
+        for (int p = 2; p < 8; ++p)
+            pal[p] = ((8 - p) * a0 + (p - 1) * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                const int err = std::abs(rgba[i * 4 + 3] - pal[p]);
+                if (err < bestErr) {
+                    bestErr = err;
+                    best = p;
+                }
+            }
+            indices |= static_cast<std::uint64_t>(best) << (3 * i);
+        }
+    }
+    for (int b = 0; b < 6; ++b)
+        out[2 + b] = static_cast<std::byte>((indices >> (8 * b)) & 0xFF);
+
+    encodeColor(rgba, out + 8);
+}
+
+void decodeBC1(const std::byte* in, std::uint8_t* rgba) noexcept {
+    decodeColor(in, rgba, true);
+}
+
+void decodeBC3(const std::byte* in, std::uint8_t* rgba) noexcept {
+    decodeColor(in + 8, rgba, false);
+
+    const int a0 = std::to_integer<int>(in[0]), a1 = std::to_integer<int>(in[1]);
+    int pal[8]{a0, a1};
+    for (int p = 2; p < 8; ++p) {
+        if (a0 > a1)
+            pal[p] = ((8 - p) * a0 + (p - 1) * a1) / 7;
+        else
+            pal[p] = p < 6 ? ((6 - p) * a0 + (p - 1) * a1) / 5 : (p == 6 ? 0 : 255);
+    }
+    std::uint64_t indices = 0;
+    for (int b = 0; b < 6; ++b)
+        indices |= std::to_integer<std::uint64_t>(in[2 + b]) << (8 * b);
+    for (int i = 0; i < 16; ++i)
+        rgba[i * 4 + 3] = static_cast<std::uint8_t>(pal[(indices >> (3 * i)) & 7]);
+}
+
+std::vector<std::byte> compressImage(TexelFormat format, const std::uint8_t* rgba, std::uint32_t width,
+                                     std::uint32_t height) {
+    if (!isBlockCompressed(format))
+        throw std::invalid_argument("compressImage: not a block-compressed format");
+    const bool bc3 = format == TexelFormat::BC3 || format == TexelFormat::BC3_sRGB;
+    const std::uint32_t blockBytes = formatUnitBytes(format);
+    const std::uint32_t bw = (width + 3) / 4, bh = (height + 3) / 4;
+
+    std::vector<std::byte> out(static_cast<std::size_t>(bw) * bh * blockBytes);
+    std::uint8_t block[64];
+    for (std::uint32_t by = 0; by < bh; ++by) {
+        for (std::uint32_t bx = 0; bx < bw; ++bx) {
+            for (std::uint32_t y = 0; y < 4; ++y) {
+                const std::uint32_t sy = std::min(by * 4 + y, height - 1);
+                for (std::uint32_t x = 0; x < 4; ++x) {
+                    const std::uint32_t sx = std::min(bx * 4 + x, width - 1);
+                    std::memcpy(block + (y * 4 + x) * 4, rgba + (static_cast<std::size_t>(sy) * width + sx) * 4, 4);
+                }
+            }
+            std::byte* dst = out.data() + (static_cast<std::size_t>(by) * bw + bx) * blockBytes;
+            if (bc3)
+                encodeBC3(block, dst);
+            else
+                encodeBC1(block, dst);
+        }
+    }
+    return out;
+}
+
+} // namespace gfx::bc
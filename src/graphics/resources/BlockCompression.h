@@ -0,0 +1,27 @@
+#pragma once
+#include "graphics/resources/CookedTexture.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gfx::bc {
+
+/* ----------------------------------------------------------------- *
+   BC1 / BC3 block encoders (offline – used by the texture cooker)
+   * Colour endpoints come from the principal axis of the block's
+     colours (range fit), indices from nearest palette entry
+   * Inputs are 4×4 RGBA8 texels, row-major (64 bytes)
+   * Decoders exist for tests and tool-side error reports
+ * ----------------------------------------------------------------- */
+void encodeBC1(const std::uint8_t* rgba, std::byte* out) noexcept; // 8 bytes out
+void encodeBC3(const std::uint8_t* rgba, std::byte* out) noexcept; // 16 bytes out
+
+void decodeBC1(const std::byte* in, std::uint8_t* rgba) noexcept;
+void decodeBC3(const std::byte* in, std::uint8_t* rgba) noexcept;
+
+/* Whole w×h RGBA8 image → block rows; partial edge blocks repeat the edge texels.
+   format must be one of the BC formats. */
+std::vector<std::byte> compressImage(TexelFormat format, const std::uint8_t* rgba, std::uint32_t width,
+                                     std::uint32_t height);
+
+} // namespace gfx::bc
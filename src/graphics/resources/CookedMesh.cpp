@@ -0,0 +1,377 @@
+#include "graphics/resources/CookedMesh.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace gfx {
+
+using core::math::Vec3;
+
+namespace {
+
+constexpr std::uint64_t alignUp(std::uint64_t v) noexcept {
+    constexpr std::uint64_t a = CookedMeshHeader::kSectionAlign;
+    return (v + a - 1) & ~(a - 1);
+}
+
+std::uint16_t toUnorm16(float v) noexcept {
+    return static_cast<std::uint16_t>(std::clamp(v, 0.f, 1.f) * 65535.f + 0.5f);
+}
+
+std::int16_t toSnorm16(float v) noexcept {
+    return static_cast<std::int16_t>(std::lround(std::clamp(v, -1.f, 1.f) * 32767.f));
+}
+
+std::uint8_t toUnorm8(float v) noexcept {
+    return static_cast<std::uint8_t>(std::clamp(v, 0.f, 1.f) * 255.f + 0.5f);
+}
+
+float signNotZero(float v) noexcept {
+    return v >= 0.f ? 1.f : -1.f;
+}
+
+} // namespace
+
+/* ---------------- quantization ---------------- */
+
+std::uint16_t floatToHalf(float f) noexcept {
+    const std::uint32_t x = std::bit_cast<std::uint32_t>(f);
+    const std::uint32_t sign = (x >> 16) & 0x8000u;
+    const std::uint32_t absx = x & 0x7fffffffu;
+
+    if (absx >= 0x7f800000u) // inf / nan
+        return static_cast<std::uint16_t>(sign | 0x7c00u | (absx > 0x7f800000u ? 0x200u : 0u));
+    if (absx >= 0x477ff000u) // rounds past the largest half
+        return static_cast<std::uint16_t>(sign | 0x7c00u);
+    if (absx < 0x38800000u) { // subnormal half (or zero)
+        const float scaled = std::bit_cast<float>(absx) * 16777216.f; // × 2^24
+        return static_cast<std::uint16_t>(sign | static_cast<std::uint32_t>(std::nearbyint(scaled)));
+    }
+    /* normal: rebias exponent, round mantissa to nearest even */
+    const std::uint32_t mant = absx & 0x1fffu;
+    std::uint32_t h = (absx - 0x38000000u) >> 13;
+    if (mant > 0x1000u || (mant == 0x1000u && (h & 1u)))
+        ++h;
+    return static_cast<std::uint16_t>(sign | h);
+}
+
+float halfToFloat(std::uint16_t h) noexcept {
+    const std::uint32_t sign = std::uint32_t{h & 0x8000u} << 16;
+    const std::uint32_t exp = (h >> 10) & 0x1fu;
+    const std::uint32_t mant = h & 0x3ffu;
+    if (exp == 0) {
+        const float v = static_cast<float>(mant) / 16777216.f; // × 2^-24
+        return sign ? -v : v;
+    }
+    if (exp == 31)
+        return std::bit_cast<float>(sign | 0x7f800000u | (mant << 13));
+    return std::bit_cast<float>(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+void octEncode(const Vec3& n, std::int16_t out[2]) noexcept {
+    const float l1 = std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]);
+    float x = l1 > 0.f ? n[0] / l1 : 0.f;
+    float y = l1 > 0.f ? n[1] / l1 : 0.f;
+    if (l1 > 0.f && n[2] < 0.f) {
+        const float fx = (1.f - std::abs(y)) * signNotZero(x);
+        const float fy = (1.f - std::abs(x)) * signNotZero(y);
+        x = fx;
+        y = fy;
+    }
+    out[0] = toSnorm16(x);
+    out[1] = toSnorm16(y);
+}
+
+Vec3 octDecode(const std::int16_t in[2]) noexcept {
+    const float x = std::max(in[0] / 32767.f, -1.f);
+    const float y = std::max(in[1] / 32767.f, -1.f);
+    Vec3 n{x, y, 1.f - std::abs(x) - std::abs(y)};
+    const float t = std::max(-n[2], 0.f);
+    n[0] += n[0] >= 0.f ? -t : t;
+    n[1] += n[1] >= 0.f ? -t : t;
+    const float len = n.length();
+    return len > 0.f ? n * (1.f / len) : Vec3{0.f, 0.f, 1.f};
+}
+
+MeshBounds computeBounds(std::span<const SourceSubmesh> submeshes) noexcept {
+    constexpr float kMax = std::numeric_limits<float>::max();
+    MeshBounds b{{kMax, kMax, kMax}, {-kMax, -kMax, -kMax}, {}, 0.f};
+    bool any = false;
+    for (const auto& sm : submeshes)
+        for (const auto& v : sm.vertices)
+            for (int c = 0; c < 3; ++c) {
+                b.min[c] = std::min(b.min[c], v.position[c]);
+                b.max[c] = std::max(b.max[c], v.position[c]);
+                any = true;
+            }
+    if (!any)
+        return {};
+
+    /* sphere around the AABB centre – looser than Ritter, but stable under re-cooking */
+    b.center = (b.min + b.max) * 0.5f;
+    float r2 = 0.f;
+    for (const auto& sm : submeshes)
+        for (const auto& v : sm.vertices)
+            r2 = std::max(r2, (v.position - b.center).lengthSquared());
+    b.radius = std::sqrt(r2);
+    return b;
+}
+
+MeshVertex encodeVertex(const SourceVertex& v, const MeshBounds& bounds) noexcept {
+    MeshVertex out{};
+    for (int c = 0; c < 3; ++c) {
+        const float extent = bounds.max[c] - bounds.min[c];
+        out.position[c] = extent > 0.f ? toUnorm16((v.position[c] - bounds.min[c]) / extent) : 0;
+    }
+    octEncode(v.normal, out.normal);
+    out.uv[0] = floatToHalf(v.uv[0]);
+    out.uv[1] = floatToHalf(v.uv[1]);
+    for (int c = 0; c < 4; ++c)
+        out.color[c] = toUnorm8(v.color[c]);
+    return out;
+}
+
+SourceVertex decodeVertex(const MeshVertex& v, const MeshBounds& bounds) noexcept {
+    SourceVertex out;
+    for (int c = 0; c < 3; ++c)
+        out.position[c] = bounds.min[c] + (bounds.max[c] - bounds.min[c]) * (v.position[c] / 65535.f);
+    out.normal = octDecode(v.normal);
+    out.uv = {halfToFloat(v.uv[0]), halfToFloat(v.uv[1])};
+    for (int c = 0; c < 4; ++c)
+        out.color[c] = v.color[c] / 255.f;
+    return out;
+}
+
+/* ---------------- LOD selection ---------------- */
+
+float projectedSphereSize(const Vec3& center, float radius, const Vec3& eye, float projScale) noexcept {
+    const float distance = (center - eye).length();
+    if (distance <= radius)
+        return std::numeric_limits<float>::infinity(); // camera inside the bounds
+    return radius * projScale / distance;
+}
+
+std::uint32_t selectLod(std::span<const CookedLod> lods, float screenSize, float lodBias) noexcept {
+    const float size = screenSize * lodBias;
+    for (std::size_t i = lods.size(); i-- > 1;)
+        if (size <= lods[i].maxScreenSize)
+            return static_cast<std::uint32_t>(i);
+    return 0;
+}
+
+void selectLods(std::span<const CookedLod> lods, std::span<const core::math::Vec4> spheres, const Vec3& eye,
+                float projScale, std::span<std::uint32_t> out, float lodBias) noexcept {
+    const std::size_t n = std::min(spheres.size(), out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        const Vec3 center{spheres[i][0], spheres[i][1], spheres[i][2]};
+        out[i] = selectLod(lods, projectedSphereSize(center, spheres[i][3], eye, projScale), lodBias);
+    }
+}
+
+/* pixels of error = error · H · s / (2 · radius)  →  s ≤ 2 · radius · P / (error · H) */
+float lodMaxScreenSize(float error, float meshRadius) noexcept {
+    if (error <= 0.f || meshRadius <= 0.f)
+        return std::numeric_limits<float>::infinity();
+    return 2.f * meshRadius * kLodPixelError / (error * kLodReferenceHeight);
+}
+
+/* ---------------- runtime ---------------- */
+
+std::span<const std::uint16_t> CookedMeshView::indices16() const noexcept {
+    if (!header || header->indexType != IndexType::U16)
+        return {};
+    return {reinterpret_cast<const std::uint16_t*>(indices.data()), indices.size() / 2};
+}
+
+std::span<const std::uint32_t> CookedMeshView::indices32() const noexcept {
+    if (!header || header->indexType != IndexType::U32)
+        return {};
+    return {reinterpret_cast<const std::uint32_t*>(indices.data()), indices.size() / 4};
+}
+
+bool isCookedMesh(std::span<const std::byte> blob) noexcept {
+    std::uint32_t magic = 0;
+    if (blob.size() < sizeof(CookedMeshHeader))
+        return false;
+    std::memcpy(&magic, blob.data(), sizeof(magic));
+    return magic == CookedMeshHeader::kMagic;
+}
+
+CookedMeshView parseCookedMesh(std::span<const std::byte> blob) {
+    if (!isCookedMesh(blob))
+        throw std::runtime_error("Not a cooked mesh");
+
+    CookedMeshView v;
+    v.header = reinterpret_cast<const CookedMeshHeader*>(blob.data());
+    const CookedMeshHeader& h = *v.header;
+    if (h.version != CookedMeshHeader::kVersion)
+        throw std::runtime_error("Cooked mesh: unsupported version");
+    if (h.vertexStride != sizeof(MeshVertex) || h.indexType > IndexType::U32 || h.indexCount % 3)
+        throw std::runtime_error("Cooked mesh: bad header");
+
+    /* counts are 32-bit, so sizes can't wrap – but offsets come from the
+       file, so a section is checked as offset ≤ end && bytes ≤ end - offset */
+    auto fits = [](std::uint64_t offset, std::uint64_t bytes, std::uint64_t end) {
+        return offset <= end && bytes <= end - offset;
+    };
+    const std::uint64_t indexBytes = std::uint64_t{h.indexCount} * (h.indexType == IndexType::U16 ? 2 : 4);
+    const std::uint64_t tableEnd = sizeof(CookedMeshHeader) + std::uint64_t{h.submeshCount} * sizeof(CookedSubmesh);
+    const std::uint64_t lodBytes = std::uint64_t{h.lodCount} * sizeof(CookedLod);
+    const std::uint64_t meshletBytes = std::uint64_t{h.meshletCount} * sizeof(CookedMeshlet);
+    const std::uint64_t vertexBytes = std::uint64_t{h.vertexCount} * sizeof(MeshVertex);
+    if (h.fileSize > blob.size() || tableEnd > h.lodOffset || !fits(h.lodOffset, lodBytes, h.meshletOffset) ||
+        !fits(h.meshletOffset, meshletBytes, h.vertexOffset) || !fits(h.vertexOffset, vertexBytes, h.indexOffset) ||
+        !fits(h.indexOffset, indexBytes, h.fileSize) || h.lodOffset % alignof(CookedLod) ||
+        h.meshletOffset % alignof(CookedMeshlet) || h.vertexOffset % CookedMeshHeader::kSectionAlign ||
+        h.indexOffset % CookedMeshHeader::kSectionAlign)
+        throw std::runtime_error("Cooked mesh: truncated");
+
+    v.submeshes = {reinterpret_cast<const CookedSubmesh*>(blob.data() + sizeof(CookedMeshHeader)), h.submeshCount};
+    v.lods = {reinterpret_cast<const CookedLod*>(blob.data() + h.lodOffset), h.lodCount};
+    v.meshlets = {reinterpret_cast<const CookedMeshlet*>(blob.data() + h.meshletOffset), h.meshletCount};
+    v.vertices = {reinterpret_cast<const MeshVertex*>(blob.data() + h.vertexOffset), h.vertexCount};
+    v.indices = blob.subspan(h.indexOffset, indexBytes);
+
+    for (const CookedSubmesh& sm : v.submeshes) {
+        if (std::uint64_t{sm.firstIndex} + sm.indexCount > h.indexCount ||
+            std::uint64_t{sm.firstVertex} + sm.vertexCount > h.vertexCount || sm.indexCount % 3 ||
+            sm.lodCount == 0 || std::uint64_t{sm.firstLod} + sm.lodCount > h.lodCount ||
+            std::uint64_t{sm.firstMeshlet} + sm.meshletCount > h.meshletCount)
+            throw std::runtime_error("Cooked mesh: bad submesh table");
+    }
+    for (const CookedMeshlet& m : v.meshlets) {
+        if (std::uint64_t{m.firstIndex} + m.triangleCount * 3u > h.indexCount)
+            throw std::runtime_error("Cooked mesh: bad meshlet table");
+    }
+    for (const CookedLod& lod : v.lods) {
+        if (std::uint64_t{lod.firstIndex} + lod.indexCount > h.indexCount || lod.indexCount % 3)
+            throw std::runtime_error("Cooked mesh: bad LOD table");
+    }
+    return v;
+}
+
+MeshFile loadCookedMesh(const std::filesystem::path& p) {
+    MeshFile mesh{core::util::MappedFile{p}, {}};
+    mesh.view = parseCookedMesh(mesh.file.bytes());
+    return mesh;
+}
+
+/* ---------------- cooker ---------------- */
+
+std::vector<std::byte> buildCookedMesh(std::span<const SourceSubmesh> submeshes) {
+    CookedMeshHeader h{};
+    h.magic = CookedMeshHeader::kMagic;
+    h.version = CookedMeshHeader::kVersion;
+    h.vertexStride = sizeof(MeshVertex);
+    h.submeshCount = static_cast<std::uint32_t>(submeshes.size());
+    h.bounds = computeBounds(submeshes);
+
+    std::uint64_t vertexCount = 0, indexCount = 0, lodCount = 0, meshletCount = 0;
+    bool wide = false;
+    for (const auto& sm : submeshes) {
+        auto validate = [&](const std::vector<std::uint32_t>& list) {
+            if (list.size() % 3)
+                throw std::invalid_argument("buildCookedMesh: index count is not a multiple of 3");
+            for (std::uint32_t i : list)
+                if (i >= sm.vertices.size())
+                    throw std::invalid_argument("buildCookedMesh: index out of range");
+            indexCount += list.size();
+        };
+        validate(sm.indices);
+        for (const SourceLod& lod : sm.lods)
+            validate(lod.indices);
+        wide |= sm.vertices.size() > 65536;
+        vertexCount += sm.vertices.size();
+        lodCount += 1 + sm.lods.size();
+        meshletCount += sm.meshlets.size();
+        for (const CookedMeshlet& m : sm.meshlets)
+            if (std::uint64_t{m.firstIndex} + m.triangleCount * 3u > sm.indices.size())
+                throw std::invalid_argument("buildCookedMesh: meshlet outside LOD 0");
+    }
+    constexpr std::uint64_t kMax32 = std::numeric_limits<std::uint32_t>::max();
+    if (vertexCount > kMax32 || indexCount > kMax32)
+        throw std::invalid_argument("buildCookedMesh: mesh too large");
+
+    h.vertexCount = static_cast<std::uint32_t>(vertexCount);
+    h.indexCount = static_cast<std::uint32_t>(indexCount);
+    h.lodCount = static_cast<std::uint32_t>(lodCount);
+    h.meshletCount = static_cast<std::uint32_t>(meshletCount);
+    h.indexType = wide ? IndexType::U32 : IndexType::U16;
+    const std::uint64_t indexSize = wide ? 4 : 2;
+    h.lodOffset = sizeof(CookedMeshHeader) + submeshes.size() * sizeof(CookedSubmesh);
+    h.meshletOffset = h.lodOffset + lodCount * sizeof(CookedLod);
+    h.vertexOffset = alignUp(h.meshletOffset + meshletCount * sizeof(CookedMeshlet));
+    h.indexOffset = alignUp(h.vertexOffset + vertexCount * sizeof(MeshVertex));
+    h.fileSize = alignUp(h.indexOffset + indexCount * indexSize);
+
+    std::vector<std::byte> out(h.fileSize);
+    std::memcpy(out.data(), &h, sizeof(h));
+
+    std::uint32_t firstVertex = 0, firstIndex = 0, firstLod = 0, firstMeshlet = 0;
+    auto* table = out.data() + sizeof(CookedMeshHeader);
+    auto* lodTable = out.data() + h.lodOffset;
+    auto* meshletTable = out.data() + h.meshletOffset;
+    auto* vertices = out.data() + h.vertexOffset;
+    auto* indices = out.data() + h.indexOffset;
+
+    /* appends one index list, returns its LOD entry */
+    auto writeIndices = [&](const std::vector<std::uint32_t>& list, float error) {
+        const CookedLod lod{firstIndex, static_cast<std::uint32_t>(list.size()), error,
+                            lodMaxScreenSize(error, h.bounds.radius)};
+        for (std::uint32_t i : list) {
+            if (wide) {
+                std::memcpy(indices, &i, 4);
+            } else {
+                const auto i16 = static_cast<std::uint16_t>(i);
+                std::memcpy(indices, &i16, 2);
+            }
+            indices += indexSize;
+        }
+        firstIndex += lod.indexCount;
+        std::memcpy(lodTable, &lod, sizeof(lod));
+        lodTable += sizeof(lod);
+        return lod;
+    };
+
+    for (const auto& sm : submeshes) {
+        const MeshBounds local = computeBounds({&sm, 1});
+        const CookedLod lod0 = writeIndices(sm.indices, 0.f);
+        for (CookedMeshlet m : sm.meshlets) {
+            m.firstIndex += lod0.firstIndex;
+            std::memcpy(meshletTable, &m, sizeof(m));
+            meshletTable += sizeof(m);
+        }
+        for (const SourceLod& lod : sm.lods)
+            writeIndices(lod.indices, lod.error);
+
+        const auto lodsHere = static_cast<std::uint32_t>(1 + sm.lods.size());
+        const CookedSubmesh entry{lod0.firstIndex,
+                                  lod0.indexCount,
+                                  firstVertex,
+                                  static_cast<std::uint32_t>(sm.vertices.size()),
+                                  sm.material,
+                                  firstLod,
+                                  lodsHere,
+                                  firstMeshlet,
+                                  static_cast<std::uint32_t>(sm.meshlets.size()),
+                                  local.min,
+                                  local.max};
+        std::memcpy(table, &entry, sizeof(entry));
+        table += sizeof(entry);
+
+        for (const SourceVertex& v : sm.vertices) {
+            const MeshVertex q = encodeVertex(v, h.bounds);
+            std::memcpy(vertices, &q, sizeof(q));
+            vertices += sizeof(q);
+        }
+        firstVertex += entry.vertexCount;
+        firstLod += lodsHere;
+        firstMeshlet += entry.meshletCount;
+    }
+    return out;
+}
+
+} // namespace gfx
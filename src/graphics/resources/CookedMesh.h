@@ -0,0 +1,213 @@
+#pragma once
+#include "core/math/Vec.hpp"
+#include "core/util/FileSystem.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   Cooked mesh container (.vmesh), written by tools/mesh_cooker
+   [CookedMeshHeader][CookedSubmesh × n][CookedLod × m]
+   [CookedMeshlet × k][pad][vertices][pad][indices]
+   * Vertices are quantized MeshVertex (20 B instead of 44 B fp32)
+   * One shared vertex/index buffer; each submesh indexes relative to
+     its firstVertex, so 16-bit indices are used whenever every
+     submesh has ≤ 65536 vertices
+   * Every submesh has ≥ 1 LOD (LOD 0 = full detail); all LODs of a
+     submesh index the same vertex range, only the index lists differ
+   * LOD 0 is split into meshlets (≤ 64 vertices, ≤ 124 triangles):
+     consecutive runs of its index list, each with a bounding sphere
+     and normal cone for cluster culling
+   * Sections are 16-byte aligned – the loader validates offsets and
+     hands out spans over the mapping, nothing is parsed or copied
+ * ----------------------------------------------------------------- */
+enum class IndexType : std::uint32_t { U16, U32 };
+
+/* Positions: unorm16 relative to the mesh AABB ([3] is padding)
+   Normals:   octahedral, snorm16 × 2
+   UVs:       IEEE half × 2
+   Colour:    unorm8 RGBA */
+struct MeshVertex {
+    std::uint16_t position[4];
+    std::int16_t normal[2];
+    std::uint16_t uv[2];
+    std::uint8_t color[4];
+};
+static_assert(sizeof(MeshVertex) == 20);
+
+struct MeshBounds {
+    core::math::Vec3 min;
+    core::math::Vec3 max;
+    core::math::Vec3 center; // bounding sphere
+    float radius;
+};
+static_assert(sizeof(MeshBounds) == 40);
+
+struct CookedMeshHeader {
+    static constexpr std::uint32_t kMagic = 0x48534D56; // "VMSH"
+    static constexpr std::uint32_t kVersion = 3;
+    static constexpr std::uint32_t kSectionAlign = 16;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    std::uint32_t submeshCount;
+    IndexType indexType;
+    std::uint32_t vertexStride; // sizeof(MeshVertex)
+    std::uint32_t lodCount;     // entries in the LOD table, all submeshes
+    MeshBounds bounds;          // positions dequantize against bounds.min/max
+    std::uint32_t meshletCount;
+    std::uint32_t reserved;
+    std::uint64_t lodOffset;
+    std::uint64_t meshletOffset;
+    std::uint64_t vertexOffset;
+    std::uint64_t indexOffset;
+    std::uint64_t fileSize;
+};
+static_assert(sizeof(CookedMeshHeader) == 120);
+
+struct CookedSubmesh {
+    std::uint32_t firstIndex;  // LOD 0
+    std::uint32_t indexCount;  // LOD 0
+    std::uint32_t firstVertex; // vertexOffset for the draw
+    std::uint32_t vertexCount;
+    std::uint32_t material;
+    std::uint32_t firstLod; // into the LOD table
+    std::uint32_t lodCount;
+    std::uint32_t firstMeshlet; // into the meshlet table
+    std::uint32_t meshletCount;
+    core::math::Vec3 min;
+    core::math::Vec3 max;
+};
+static_assert(sizeof(CookedSubmesh) == 60);
+
+/* One detail level.  maxScreenSize is the largest projected size (see
+   projectedSphereSize) at which this level's simplification error
+   stays under kLodPixelError pixels at kLodReferenceHeight – LOD 0
+   is +inf, coarser levels get smaller thresholds. */
+struct CookedLod {
+    std::uint32_t firstIndex;
+    std::uint32_t indexCount;
+    float error; // object-space deviation from LOD 0
+    float maxScreenSize;
+};
+static_assert(sizeof(CookedLod) == 16);
+
+/* A run of LOD 0 triangles.  Backfacing from `eye` (object space) iff
+   dot(center - eye, coneAxis) >= coneCutoff * |center - eye| + radius;
+   coneCutoff is 1 when the normals spread too far for that to hold. */
+struct CookedMeshlet {
+    std::uint32_t firstIndex; // absolute in the file, relative to LOD 0 on the cooker side
+    std::uint16_t triangleCount;
+    std::uint16_t vertexCount;
+    core::math::Vec3 center;
+    float radius;
+    core::math::Vec3 coneAxis;
+    float coneCutoff;
+};
+static_assert(sizeof(CookedMeshlet) == 40);
+
+constexpr std::uint32_t kMeshletMaxVertices = 64;
+constexpr std::uint32_t kMeshletMaxTriangles = 124;
+
+constexpr float kLodPixelError = 1.f;
+constexpr float kLodReferenceHeight = 1080.f;
+
+/* Parsed, zero-copy view into a cooked mesh blob */
+struct CookedMeshView {
+    const CookedMeshHeader* header{nullptr};
+    std::span<const CookedSubmesh> submeshes;
+    std::span<const CookedLod> lods;
+    std::span<const CookedMeshlet> meshlets;
+    std::span<const MeshVertex> vertices;
+    std::span<const std::byte> indices; // 2 or 4 bytes each, see header->indexType
+
+    std::span<const std::byte> vertexBytes() const noexcept {
+        return std::as_bytes(vertices);
+    }
+    std::span<const std::uint16_t> indices16() const noexcept;
+    std::span<const std::uint32_t> indices32() const noexcept;
+
+    std::span<const CookedLod> lodsOf(const CookedSubmesh& sm) const noexcept {
+        return lods.subspan(sm.firstLod, sm.lodCount);
+    }
+    std::span<const CookedMeshlet> meshletsOf(const CookedSubmesh& sm) const noexcept {
+        return meshlets.subspan(sm.firstMeshlet, sm.meshletCount);
+    }
+};
+
+/* Validates header, submesh table and sections; throws std::runtime_error */
+CookedMeshView parseCookedMesh(std::span<const std::byte> blob);
+
+bool isCookedMesh(std::span<const std::byte> blob) noexcept;
+
+/* A mapped .vmesh – view aliases file and stays valid while it's alive */
+struct MeshFile {
+    core::util::MappedFile file;
+    CookedMeshView view;
+};
+
+MeshFile loadCookedMesh(const std::filesystem::path& p);
+
+/* ---------------- cooker side ---------------- */
+
+struct SourceVertex {
+    core::math::Vec3 position;
+    core::math::Vec3 normal;
+    core::math::Vec2 uv;
+    core::math::Vec4 color{1.f, 1.f, 1.f, 1.f};
+};
+
+struct SourceLod {
+    std::vector<std::uint32_t> indices; // same vertices as LOD 0
+    float error{0.f};
+};
+
+struct SourceSubmesh {
+    std::vector<SourceVertex> vertices;
+    std::vector<std::uint32_t> indices; // triangle list, local to vertices – LOD 0
+    std::uint32_t material{0};
+    std::vector<SourceLod> lods;         // LOD 1…n, coarsest last
+    std::vector<CookedMeshlet> meshlets; // over `indices`, see buildMeshlets
+};
+
+/* Quantizes and serialises; throws std::invalid_argument on bad input */
+std::vector<std::byte> buildCookedMesh(std::span<const SourceSubmesh> submeshes);
+
+/* ---------------- LOD selection ---------------- */
+
+/* Fraction of the viewport height covered by a sphere's diameter;
+   projScale is proj[1][1] (= 1 / tan(fovY / 2)) */
+float projectedSphereSize(const core::math::Vec3& center, float radius, const core::math::Vec3& eye,
+                          float projScale) noexcept;
+
+/* Coarsest level whose threshold admits `screenSize`.  lodBias > 1
+   keeps detail longer, < 1 drops it sooner. */
+std::uint32_t selectLod(std::span<const CookedLod> lods, float screenSize, float lodBias = 1.f) noexcept;
+
+/* Per-instance: spheres are world-space (xyz centre, w radius) */
+void selectLods(std::span<const CookedLod> lods, std::span<const core::math::Vec4> spheres,
+                const core::math::Vec3& eye, float projScale, std::span<std::uint32_t> out,
+                float lodBias = 1.f) noexcept;
+
+/* Threshold stored in CookedLod::maxScreenSize for a given error */
+float lodMaxScreenSize(float error, float meshRadius) noexcept;
+
+/* ---------------- quantization helpers ---------------- */
+
+std::uint16_t floatToHalf(float f) noexcept;
+float halfToFloat(std::uint16_t h) noexcept;
+
+void octEncode(const core::math::Vec3& n, std::int16_t out[2]) noexcept;
+core::math::Vec3 octDecode(const std::int16_t in[2]) noexcept;
+
+MeshBounds computeBounds(std::span<const SourceSubmesh> submeshes) noexcept;
+MeshVertex encodeVertex(const SourceVertex& v, const MeshBounds& bounds) noexcept;
+SourceVertex decodeVertex(const MeshVertex& v, const MeshBounds& bounds) noexcept;
+
+} // namespace gfx
@@ -0,0 +1,80 @@
+#include "graphics/resources/CookedTexture.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace gfx {
+
+bool isCookedTexture(std::span<const std::byte> blob) noexcept {
+    std::uint32_t magic = 0;
+    if (blob.size() < sizeof(CookedTextureHeader))
+        return false;
+    std::memcpy(&magic, blob.data(), sizeof(magic));
+    return magic == CookedTextureHeader::kMagic;
+}
+
+CookedTextureView parseCookedTexture(std::span<const std::byte> blob) {
+    if (!isCookedTexture(blob))
+        throw std::runtime_error("Not a cooked texture");
+
+    CookedTextureView v;
+    v.header = reinterpret_cast<const CookedTextureHeader*>(blob.data());
+    const CookedTextureHeader& h = *v.header;
+    if (h.version != CookedTextureHeader::kVersion)
+        throw std::runtime_error("Cooked texture: unsupported version");
+    if (h.format > TexelFormat::BC3_sRGB || h.width == 0 || h.height == 0 || h.mipCount == 0 || h.mipCount > 16)
+        throw std::runtime_error("Cooked texture: bad header");
+
+    const std::uint64_t tableEnd = sizeof(CookedTextureHeader) + std::uint64_t{h.mipCount} * sizeof(CookedMip);
+    if (tableEnd > h.payloadOffset || h.payloadOffset + h.payloadSize > blob.size())
+        throw std::runtime_error("Cooked texture: truncated");
+
+    v.mips = {reinterpret_cast<const CookedMip*>(blob.data() + sizeof(CookedTextureHeader)), h.mipCount};
+    v.payload = blob.subspan(h.payloadOffset, h.payloadSize);
+
+    std::uint32_t w = h.width, hh = h.height;
+    for (const CookedMip& m : v.mips) {
+        if (m.width != w || m.height != hh || m.size != mipByteSize(h.format, w, hh) || m.offset < h.payloadOffset ||
+            m.offset + m.size > h.payloadOffset + h.payloadSize || m.offset % CookedTextureHeader::kPayloadAlign)
+            throw std::runtime_error("Cooked texture: bad mip table");
+        w = w > 1 ? w / 2 : 1;
+        hh = hh > 1 ? hh / 2 : 1;
+    }
+    return v;
+}
+
+std::vector<std::byte> buildCookedTexture(TexelFormat format, std::uint32_t width, std::uint32_t height,
+                                          std::span<const std::vector<std::byte>> mips) {
+    constexpr std::uint64_t kAlign = CookedTextureHeader::kPayloadAlign;
+    const auto alignUp = [](std::uint64_t v) { return (v + kAlign - 1) & ~(kAlign - 1); };
+
+    CookedTextureHeader h{};
+    h.magic = CookedTextureHeader::kMagic;
+    h.version = CookedTextureHeader::kVersion;
+    h.format = format;
+    h.width = width;
+    h.height = height;
+    h.mipCount = static_cast<std::uint32_t>(mips.size());
+    h.payloadOffset = alignUp(sizeof(CookedTextureHeader) + mips.size() * sizeof(CookedMip));
+
+    std::vector<CookedMip> table;
+    std::uint64_t cursor = h.payloadOffset;
+    std::uint32_t w = width, hh = height;
+    for (const auto& level : mips) {
+        if (level.size() != mipByteSize(format, w, hh))
+            throw std::invalid_argument("buildCookedTexture: mip size does not match its dimensions");
+        table.push_back({cursor, level.size(), w, hh});
+        cursor = alignUp(cursor + level.size());
+        w = w > 1 ? w / 2 : 1;
+        hh = hh > 1 ? hh / 2 : 1;
+    }
+    h.payloadSize = cursor - h.payloadOffset;
+
+    std::vector<std::byte> out(cursor);
+    std::memcpy(out.data(), &h, sizeof(h));
+    std::memcpy(out.data() + sizeof(h), table.data(), table.size() * sizeof(CookedMip));
+    for (std::size_t i = 0; i < mips.size(); ++i)
+        std::memcpy(out.data() + table[i].offset, mips[i].data(), mips[i].size());
+    return out;
+}
+
+} // namespace gfx
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   Cooked texture container (.vtex), written by tools/texture_cooker
+   [CookedTextureHeader][CookedMip × mipCount][pad][mip 0][mip 1]…
+   * Every mip is stored exactly as the GPU wants it (block rows for
+     BC formats, tightly packed texels otherwise), 16-byte aligned,
+     so the loader copies the whole payload into staging in one go
+ * ----------------------------------------------------------------- */
+enum class TexelFormat : std::uint32_t {
+    RGBA8,
+    RGBA8_sRGB,
+    BC1,      // RGB, 4 bpp
+    BC1_sRGB,
+    BC3,      // RGBA, 8 bpp
+    BC3_sRGB,
+};
+
+struct CookedTextureHeader {
+    static constexpr std::uint32_t kMagic = 0x58455456; // "VTEX"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kPayloadAlign = 16;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    TexelFormat format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t mipCount;
+    std::uint64_t payloadOffset; // first mip; all mips are contiguous from here
+    std::uint64_t payloadSize;
+};
+static_assert(sizeof(CookedTextureHeader) == 40);
+
+struct CookedMip {
+    std::uint64_t offset; // from file start
+    std::uint64_t size;
+    std::uint32_t width;
+    std::uint32_t height;
+};
+static_assert(sizeof(CookedMip) == 24);
+
+/* Parsed, zero-copy view into a cooked texture blob */
+struct CookedTextureView {
+    const CookedTextureHeader* header{nullptr};
+    std::span<const CookedMip> mips;
+    std::span<const std::byte> payload;
+};
+
+constexpr bool isBlockCompressed(TexelFormat f) noexcept {
+    return f != TexelFormat::RGBA8 && f != TexelFormat::RGBA8_sRGB;
+}
+
+constexpr bool isSrgb(TexelFormat f) noexcept {
+    return f == TexelFormat::RGBA8_sRGB || f == TexelFormat::BC1_sRGB || f == TexelFormat::BC3_sRGB;
+}
+
+/* Bytes per 4×4 block (BC) or per texel (uncompressed) */
+constexpr std::uint32_t formatUnitBytes(TexelFormat f) noexcept {
+    switch (f) {
+    case TexelFormat::BC1:
+    case TexelFormat::BC1_sRGB:
+        return 8;
+    case TexelFormat::BC3:
+    case TexelFormat::BC3_sRGB:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+constexpr std::uint64_t mipByteSize(TexelFormat f, std::uint32_t w, std::uint32_t h) noexcept {
+    if (isBlockCompressed(f))
+        return std::uint64_t{(w + 3) / 4} * ((h + 3) / 4) * formatUnitBytes(f);
+    return std::uint64_t{w} * h * formatUnitBytes(f);
+}
+
+/* Validates header and mip table against the blob; throws std::runtime_error */
+CookedTextureView parseCookedTexture(std::span<const std::byte> blob);
+
+bool isCookedTexture(std::span<const std::byte> blob) noexcept;
+
+/* Serialises a full mip chain (level 0 first, sizes per mipByteSize) – cooker side */
+std::vector<std::byte> buildCookedTexture(TexelFormat format, std::uint32_t width, std::uint32_t height,
+                                          std::span<const std::vector<std::byte>> mips);
+
+} // namespace gfx
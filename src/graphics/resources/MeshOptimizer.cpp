@@ -0,0 +1,305 @@
+#include "graphics/resources/MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace gfx {
+
+using core::math::Vec3;
+
+namespace {
+
+constexpr std::uint32_t kInvalid = std::numeric_limits<std::uint32_t>::max();
+
+/* ---------------- Forsyth scoring ---------------- */
+
+constexpr int kForsythCache = 32;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kValenceBoostScale = 2.f;
+constexpr float kValenceBoostPower = -0.5f;
+
+float vertexScore(int cachePos, std::uint32_t remaining) {
+    if (remaining == 0)
+        return -1.f; // nothing left to draw through this vertex
+    float score = 0.f;
+    if (cachePos >= 0) {
+        if (cachePos < 3)
+            score = kLastTriScore; // just used – fixed score so the next tri doesn't simply re-use the last edge
+        else
+            score = std::pow(1.f - static_cast<float>(cachePos - 3) / (kForsythCache - 3), kCacheDecayPower);
+    }
+    /* favour vertices with few triangles left, so they get finished off and leave the cache */
+    return score + kValenceBoostScale * std::pow(static_cast<float>(remaining), kValenceBoostPower);
+}
+
+/* ---------------- welding key ---------------- */
+
+struct VertexKey {
+    MeshVertex v;
+
+    bool operator==(const VertexKey& o) const noexcept {
+        return std::memcmp(&v, &o.v, sizeof(v)) == 0;
+    }
+};
+
+struct VertexKeyHash {
+    std::size_t operator()(const VertexKey& k) const noexcept {
+        const auto* p = reinterpret_cast<const unsigned char*>(&k.v);
+        std::uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < sizeof(k.v); ++i)
+            h = (h ^ p[i]) * 1099511628211ull;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+} // namespace
+
+VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices, std::uint32_t vertexCount,
+                                    std::uint32_t cacheSize) {
+    if (indices.empty())
+        return {};
+
+    /* FIFO: a vertex is resident iff fewer than cacheSize misses happened since it was loaded */
+    std::vector<std::uint64_t> loadedAt(vertexCount, std::numeric_limits<std::uint64_t>::max());
+    std::uint64_t misses = 0;
+    std::uint32_t unique = 0;
+    for (std::uint32_t i : indices) {
+        const std::uint64_t stamp = loadedAt[i];
+        if (stamp == std::numeric_limits<std::uint64_t>::max())
+            ++unique;
+        else if (misses - stamp < cacheSize)
+            continue;
+        loadedAt[i] = misses++;
+    }
+    const float tris = static_cast<float>(indices.size() / 3);
+    return {static_cast<float>(misses) / tris, static_cast<float>(misses) / static_cast<float>(unique)};
+}
+
+std::uint32_t weldVertices(SourceSubmesh& mesh, const MeshBounds& quantization) {
+    std::unordered_map<VertexKey, std::uint32_t, VertexKeyHash> seen;
+    seen.reserve(mesh.vertices.size());
+
+    std::vector<std::uint32_t> remap(mesh.vertices.size());
+    std::vector<SourceVertex> unique;
+    unique.reserve(mesh.vertices.size());
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const VertexKey key{encodeVertex(mesh.vertices[i], quantization)};
+        const auto [it, inserted] = seen.try_emplace(key, static_cast<std::uint32_t>(unique.size()));
+        if (inserted)
+            unique.push_back(mesh.vertices[i]);
+        remap[i] = it->second;
+    }
+    const auto removed = static_cast<std::uint32_t>(mesh.vertices.size() - unique.size());
+
+    /* welding can collapse sliver triangles – drop them */
+    std::size_t out = 0;
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const std::uint32_t a = remap[mesh.indices[t]], b = remap[mesh.indices[t + 1]], c = remap[mesh.indices[t + 2]];
+        if (a == b || b == c || a == c)
+            continue;
+        mesh.indices[out++] = a;
+        mesh.indices[out++] = b;
+        mesh.indices[out++] = c;
+    }
+    mesh.indices.resize(out);
+    mesh.vertices = std::move(unique);
+    return removed;
+}
+
+void optimizeVertexCache(std::span<std::uint32_t> indices, std::uint32_t vertexCount) {
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount < 2)
+        return;
+
+    /* vertex → live triangles, packed; the first remaining[v] entries are still undrawn */
+    std::vector<std::uint32_t> remaining(vertexCount, 0), first(vertexCount + 1, 0);
+    for (std::uint32_t i : indices)
+        ++remaining[i];
+    for (std::uint32_t v = 0; v < vertexCount; ++v)
+        first[v + 1] = first[v] + remaining[v];
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        std::vector<std::uint32_t> fill(first.begin(), first.end() - 1);
+        for (std::size_t t = 0; t < triCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+    }
+
+    std::vector<int> cachePos(vertexCount, -1);
+    std::vector<float> vScore(vertexCount), tScore(triCount, 0.f);
+    for (std::uint32_t v = 0; v < vertexCount; ++v)
+        vScore[v] = vertexScore(-1, remaining[v]);
+    for (std::size_t t = 0; t < triCount; ++t)
+        for (int k = 0; k < 3; ++k)
+            tScore[t] += vScore[indices[t * 3 + k]];
+
+    std::vector<std::uint32_t> out;
+    out.reserve(indices.size());
+    std::vector<char> emitted(triCount, 0);
+    std::array<std::uint32_t, kForsythCache + 3> cache{}, next{};
+    std::size_t cacheCount = 0, scan = 0;
+
+    std::uint32_t best = static_cast<std::uint32_t>(std::max_element(tScore.begin(), tScore.end()) - tScore.begin());
+    for (std::size_t n = 0; n < triCount; ++n) {
+        if (best == kInvalid) { // cache ran dry – continue with the next undrawn triangle
+            while (emitted[scan])
+                ++scan;
+            best = static_cast<std::uint32_t>(scan);
+        }
+        emitted[best] = 1;
+        const std::uint32_t* tri = &indices[best * 3];
+        out.insert(out.end(), tri, tri + 3);
+
+        /* retire the triangle from its vertices' live lists */
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t v = tri[k];
+            std::uint32_t* live = &adjacency[first[v]];
+            const std::uint32_t end = --remaining[v];
+            for (std::uint32_t j = 0; j <= end; ++j) {
+                if (live[j] == best) {
+                    std::swap(live[j], live[end]);
+                    break;
+                }
+            }
+        }
+
+        /* LRU: the triangle's vertices go to the front */
+        std::size_t nextCount = 0;
+        for (int k = 0; k < 3; ++k)
+            if (std::find(next.begin(), next.begin() + nextCount, tri[k]) == next.begin() + nextCount)
+                next[nextCount++] = tri[k];
+        for (std::size_t i = 0; i < cacheCount; ++i)
+            if (std::find(next.begin(), next.begin() + nextCount, cache[i]) == next.begin() + nextCount)
+                next[nextCount++] = cache[i];
+
+        /* rescore everything that was or is in the cache, then the triangles around it */
+        for (std::size_t i = 0; i < nextCount; ++i) {
+            const std::uint32_t v = next[i];
+            cachePos[v] = i < static_cast<std::size_t>(kForsythCache) ? static_cast<int>(i) : -1;
+            vScore[v] = vertexScore(cachePos[v], remaining[v]);
+        }
+        cacheCount = std::min<std::size_t>(nextCount, kForsythCache);
+        std::copy_n(next.begin(), cacheCount, cache.begin());
+
+        best = kInvalid;
+        float bestScore = -std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i < nextCount; ++i) {
+            const std::uint32_t v = next[i];
+            for (std::uint32_t j = 0; j < remaining[v]; ++j) {
+                const std::uint32_t t = adjacency[first[v] + j];
+                const std::uint32_t* tv = &indices[t * 3];
+                tScore[t] = vScore[tv[0]] + vScore[tv[1]] + vScore[tv[2]];
+                if (tScore[t] > bestScore) {
+                    bestScore = tScore[t];
+                    best = t;
+                }
+            }
+        }
+    }
+    std::copy(out.begin(), out.end(), indices.begin());
+}
+
+void optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const SourceVertex> vertices, float threshold) {
+    const std::size_t triCount = indices.size() / 3;
+    if (triCount < 2)
+        return;
+    const auto vertexCount = static_cast<std::uint32_t>(vertices.size());
+    const float baseAcmr = analyzeVertexCache(indices, vertexCount).acmr;
+
+    /* hard boundaries: triangles where the FIFO cache misses all three vertices */
+    std::vector<std::size_t> clusterStart;
+    {
+        std::vector<std::uint64_t> loadedAt(vertexCount, std::numeric_limits<std::uint64_t>::max());
+        std::uint64_t misses = 0;
+        for (std::size_t t = 0; t < triCount; ++t) {
+            int triMisses = 0;
+            for (int k = 0; k < 3; ++k) {
+                const std::uint32_t v = indices[t * 3 + k];
+                if (loadedAt[v] != std::numeric_limits<std::uint64_t>::max() && misses - loadedAt[v] < kVertexCacheSize)
+                    continue;
+                loadedAt[v] = misses++;
+                ++triMisses;
+            }
+            if (t == 0 || triMisses == 3)
+                clusterStart.push_back(t);
+        }
+    }
+    if (clusterStart.size() < 2)
+        return;
+    clusterStart.push_back(triCount);
+
+    /* area-weighted centroid and normal per cluster */
+    const std::size_t clusterCount = clusterStart.size() - 1;
+    std::vector<Vec3> centroid(clusterCount), normal(clusterCount);
+    Vec3 meshCentroid{};
+    float meshArea = 0.f;
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        float area = 0.f;
+        for (std::size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+            const Vec3& a = vertices[indices[t * 3]].position;
+            const Vec3& b = vertices[indices[t * 3 + 1]].position;
+            const Vec3& d = vertices[indices[t * 3 + 2]].position;
+            const Vec3 n = (b - a).cross(d - a);
+            const float triArea = n.length();
+            centroid[c] += (a + b + d) * (triArea / 3.f);
+            normal[c] += n;
+            area += triArea;
+        }
+        meshCentroid += centroid[c];
+        meshArea += area;
+        centroid[c] = area > 0.f ? centroid[c] * (1.f / area) : Vec3{};
+    }
+    if (meshArea <= 0.f)
+        return;
+    meshCentroid *= 1.f / meshArea;
+
+    /* outward-facing clusters (far side of the centroid, facing away from it) occlude the rest – draw first */
+    std::vector<float> key(clusterCount);
+    for (std::size_t c = 0; c < clusterCount; ++c) {
+        const float len = normal[c].length();
+        key[c] = len > 0.f ? (centroid[c] - meshCentroid).dot(normal[c] * (1.f / len)) : 0.f;
+    }
+    std::vector<std::size_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return key[a] > key[b]; });
+
+    std::vector<std::uint32_t> sorted;
+    sorted.reserve(indices.size());
+    for (std::size_t c : order)
+        sorted.insert(sorted.end(), indices.begin() + clusterStart[c] * 3, indices.begin() + clusterStart[c + 1] * 3);
+
+    if (analyzeVertexCache(sorted, vertexCount).acmr <= baseAcmr * threshold)
+        std::copy(sorted.begin(), sorted.end(), indices.begin());
+}
+
+void optimizeVertexFetch(SourceSubmesh& mesh) {
+    std::vector<std::uint32_t> remap(mesh.vertices.size(), kInvalid);
+    std::vector<SourceVertex> ordered;
+    ordered.reserve(mesh.vertices.size());
+    for (std::uint32_t& i : mesh.indices) {
+        if (remap[i] == kInvalid) {
+            remap[i] = static_cast<std::uint32_t>(ordered.size());
+            ordered.push_back(mesh.vertices[i]);
+        }
+        i = remap[i];
+    }
+    mesh.vertices = std::move(ordered);
+}
+
+MeshOptimizeReport optimizeMesh(SourceSubmesh& mesh, const MeshBounds& quantization) {
+    MeshOptimizeReport r;
+    r.before = analyzeVertexCache(mesh.indices, static_cast<std::uint32_t>(mesh.vertices.size()));
+    r.welded = weldVertices(mesh, quantization);
+    optimizeVertexCache(mesh.indices, static_cast<std::uint32_t>(mesh.vertices.size()));
+    optimizeOverdraw(mesh.indices, mesh.vertices);
+    optimizeVertexFetch(mesh);
+    r.after = analyzeVertexCache(mesh.indices, static_cast<std::uint32_t>(mesh.vertices.size()));
+    return r;
+}
+
+} // namespace gfx
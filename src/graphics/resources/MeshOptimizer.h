@@ -0,0 +1,52 @@
+#pragma once
+#include "graphics/resources/CookedMesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   Offline index/vertex reordering for triangle lists (mesh_cooker)
+   * weldVertices         – merge vertices that quantize identically
+   * optimizeVertexCache  – Forsyth's greedy LRU scoring
+   * optimizeOverdraw     – Tipsify-style: cut the cache-ordered list
+     into clusters at cache restarts, draw outward-facing clusters
+     first; rejected if ACMR grows past `threshold`
+   * optimizeVertexFetch  – vertices in first-use order, unused ones
+     dropped, so the fetch stream is (mostly) linear
+   Each pass keeps the triangle set; only the order changes.
+ * ----------------------------------------------------------------- */
+
+/* ACMR = post-transform cache misses per triangle (0.5 is ideal for
+   big grids, 3 is worst); ATVR = misses per referenced vertex (1 is
+   ideal).  FIFO cache, like most real hardware. */
+struct VertexCacheStats {
+    float acmr{0.f};
+    float atvr{0.f};
+};
+
+constexpr std::uint32_t kVertexCacheSize = 16;
+
+VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices, std::uint32_t vertexCount,
+                                    std::uint32_t cacheSize = kVertexCacheSize);
+
+/* Returns the number of vertices removed */
+std::uint32_t weldVertices(SourceSubmesh& mesh, const MeshBounds& quantization);
+
+void optimizeVertexCache(std::span<std::uint32_t> indices, std::uint32_t vertexCount);
+
+void optimizeOverdraw(std::span<std::uint32_t> indices, std::span<const SourceVertex> vertices,
+                      float threshold = 1.05f);
+
+void optimizeVertexFetch(SourceSubmesh& mesh);
+
+struct MeshOptimizeReport {
+    VertexCacheStats before, after;
+    std::uint32_t welded{0};
+};
+
+/* All of the above, in order: weld → cache → overdraw → fetch */
+MeshOptimizeReport optimizeMesh(SourceSubmesh& mesh, const MeshBounds& quantization);
+
+} // namespace gfx
@@ -0,0 +1,289 @@
+#include "graphics/resources/MeshSimplifier.h"
+#include "graphics/resources/MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace gfx {
+
+using core::math::Vec3;
+
+namespace {
+
+constexpr double kBorderWeight = 10.0;
+
+/* Symmetric 4×4 quadric, stored as A (3×3), b, c – plus the total weight so error() is a mean squared distance.
+   Only ranks collapses; the error reported to callers is tracked separately as a plane distance. */
+struct Quadric {
+    double a00{0}, a01{0}, a02{0}, a11{0}, a12{0}, a22{0};
+    double b0{0}, b1{0}, b2{0};
+    double c{0};
+    double w{0};
+
+    void addPlane(const Vec3& n, double d, double weight) {
+        a00 += weight * n[0] * n[0];
+        a01 += weight * n[0] * n[1];
+        a02 += weight * n[0] * n[2];
+        a11 += weight * n[1] * n[1];
+        a12 += weight * n[1] * n[2];
+        a22 += weight * n[2] * n[2];
+        b0 += weight * n[0] * d;
+        b1 += weight * n[1] * d;
+        b2 += weight * n[2] * d;
+        c += weight * d * d;
+        w += weight;
+    }
+
+    Quadric& operator+=(const Quadric& o) {
+        a00 += o.a00;
+        a01 += o.a01;
+        a02 += o.a02;
+        a11 += o.a11;
+        a12 += o.a12;
+        a22 += o.a22;
+        b0 += o.b0;
+        b1 += o.b1;
+        b2 += o.b2;
+        c += o.c;
+        w += o.w;
+        return *this;
+    }
+
+    double error(const Vec3& p) const {
+        const double x = p[0], y = p[1], z = p[2];
+        const double q = a00 * x * x + a11 * y * y + a22 * z * z + 2 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                         2 * (b0 * x + b1 * y + b2 * z) + c;
+        return w > 0 ? std::max(q, 0.0) / w : 0.0;
+    }
+};
+
+struct Collapse {
+    std::uint32_t from, to;
+    double cost;
+};
+
+std::uint64_t edgeKey(std::uint32_t a, std::uint32_t b) {
+    return a < b ? (std::uint64_t{a} << 32 | b) : (std::uint64_t{b} << 32 | a);
+}
+
+Vec3 triNormal(const Vec3& a, const Vec3& b, const Vec3& c) {
+    return (b - a).cross(c - a);
+}
+
+} // namespace
+
+SimplifyResult simplifyMesh(std::span<const std::uint32_t> indices, std::span<const SourceVertex> vertices,
+                            std::size_t targetIndexCount, float maxError) {
+    SimplifyResult result;
+    result.indices.assign(indices.begin(), indices.end());
+    std::vector<std::uint32_t>& tris = result.indices;
+    const auto vertexCount = static_cast<std::uint32_t>(vertices.size());
+    if (tris.size() <= targetIndexCount || vertexCount == 0)
+        return result;
+
+    /* seams: several vertices at one position – collapse topology on the first of them, never move any of them */
+    std::vector<std::uint32_t> canon(vertexCount);
+    std::vector<char> locked(vertexCount, 0);
+    {
+        struct PosHash {
+            std::size_t operator()(const Vec3& p) const noexcept {
+                std::uint32_t bits[3];
+                std::memcpy(bits, p.v.data(), sizeof(bits));
+                return (std::size_t{bits[0]} * 73856093u) ^ (std::size_t{bits[1]} * 19349663u) ^
+                       (std::size_t{bits[2]} * 83492791u);
+            }
+        };
+        struct PosEq {
+            bool operator()(const Vec3& a, const Vec3& b) const noexcept {
+                return a.v == b.v;
+            }
+        };
+        std::unordered_map<Vec3, std::uint32_t, PosHash, PosEq> firstAt;
+        std::vector<std::uint32_t> shared(vertexCount, 0);
+        for (std::uint32_t v = 0; v < vertexCount; ++v) {
+            canon[v] = firstAt.try_emplace(vertices[v].position, v).first->second;
+            ++shared[canon[v]];
+        }
+        for (std::uint32_t v = 0; v < vertexCount; ++v)
+            locked[v] = shared[canon[v]] > 1;
+    }
+
+    auto countEdges = [&](std::unordered_map<std::uint64_t, std::uint32_t>& edges) {
+        edges.clear();
+        for (std::size_t t = 0; t < tris.size(); t += 3)
+            for (int k = 0; k < 3; ++k)
+                ++edges[edgeKey(canon[tris[t + k]], canon[tris[t + (k + 1) % 3]])];
+    };
+
+    /* quadrics: one plane per adjacent triangle (area-weighted), plus perpendicular planes along open borders */
+    std::vector<Quadric> quadrics(vertexCount);
+    std::unordered_map<std::uint64_t, std::uint32_t> edges;
+    countEdges(edges);
+    for (std::size_t t = 0; t < tris.size(); t += 3) {
+        const Vec3 n = triNormal(vertices[tris[t]].position, vertices[tris[t + 1]].position,
+                                 vertices[tris[t + 2]].position);
+        const float len = n.length();
+        if (len <= 0.f)
+            continue;
+        const Vec3 un = n * (1.f / len);
+        const double d = -un.dot(vertices[tris[t]].position);
+        for (int k = 0; k < 3; ++k)
+            quadrics[tris[t + k]].addPlane(un, d, len * 0.5);
+
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t a = tris[t + k], b = tris[t + (k + 1) % 3];
+            if (edges[edgeKey(canon[a], canon[b])] != 1)
+                continue;
+            const Vec3 edge = vertices[b].position - vertices[a].position;
+            const Vec3 side = edge.cross(un);
+            const float sideLen = side.length();
+            if (sideLen <= 0.f)
+                continue;
+            const Vec3 sn = side * (1.f / sideLen);
+            const double sd = -sn.dot(vertices[a].position);
+            const double weight = kBorderWeight * edge.lengthSquared();
+            quadrics[a].addPlane(sn, sd, weight);
+            quadrics[b].addPlane(sn, sd, weight);
+        }
+    }
+
+    const double maxCost = static_cast<double>(maxError) * maxError;
+    std::vector<std::uint32_t> adjFirst(vertexCount + 1), adjacency, remap(vertexCount);
+    std::vector<char> border(vertexCount), dirty(vertexCount);
+    std::vector<Collapse> candidates;
+    std::vector<float> drift(vertexCount, 0.f); // bound on how far triangles touching v are from the input
+    float worst = 0.f;
+
+    while (tris.size() > targetIndexCount) {
+        /* per-pass topology: vertex → triangles, border vertices */
+        std::fill(adjFirst.begin(), adjFirst.end(), 0);
+        for (std::uint32_t i : tris)
+            ++adjFirst[i + 1];
+        for (std::uint32_t v = 0; v < vertexCount; ++v)
+            adjFirst[v + 1] += adjFirst[v];
+        adjacency.resize(tris.size());
+        {
+            std::vector<std::uint32_t> fill(adjFirst.begin(), adjFirst.end() - 1);
+            for (std::size_t t = 0; t < tris.size(); ++t)
+                adjacency[fill[tris[t]]++] = static_cast<std::uint32_t>(t / 3);
+        }
+        countEdges(edges);
+        std::fill(border.begin(), border.end(), 0);
+        for (std::size_t t = 0; t < tris.size(); t += 3) {
+            for (int k = 0; k < 3; ++k) {
+                const std::uint32_t a = tris[t + k], b = tris[t + (k + 1) % 3];
+                if (edges[edgeKey(canon[a], canon[b])] == 1)
+                    border[a] = border[b] = 1;
+            }
+        }
+
+        candidates.clear();
+        for (std::size_t t = 0; t < tris.size(); t += 3) {
+            for (int k = 0; k < 3; ++k) {
+                const std::uint32_t a = tris[t + k], b = tris[t + (k + 1) % 3];
+                const bool borderEdge = edges[edgeKey(canon[a], canon[b])] == 1;
+                for (const auto& [from, to] : {std::pair{a, b}, std::pair{b, a}}) {
+                    if (locked[from] || (border[from] && !borderEdge))
+                        continue;
+                    Quadric q = quadrics[from];
+                    q += quadrics[to];
+                    candidates.push_back({from, to, q.error(vertices[to].position)});
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& l, const Collapse& r) { return l.cost < r.cost; });
+
+        std::fill(dirty.begin(), dirty.end(), 0);
+        for (std::uint32_t v = 0; v < vertexCount; ++v)
+            remap[v] = v;
+        const std::size_t budget = (tris.size() - targetIndexCount + 2) / 3;
+        std::size_t removed = 0, applied = 0;
+
+        for (const Collapse& c : candidates) {
+            if (c.cost > maxCost)
+                break; // mean squared distance past maxError²: some plane is already farther than maxError
+            if (dirty[c.from] || dirty[c.to])
+                continue;
+
+            /* reject if any surviving triangle around `from` would flip or collapse to nothing, and measure
+               how far `to` lies off the planes of the triangles it reshapes */
+            bool ok = true;
+            std::size_t dying = 0;
+            float offPlane = 0.f;
+            const Vec3 move = vertices[c.to].position - vertices[c.from].position;
+            for (std::uint32_t j = adjFirst[c.from]; j < adjFirst[c.from + 1] && ok; ++j) {
+                const std::uint32_t* tri = &tris[adjacency[j] * 3];
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) {
+                    ++dying;
+                    continue;
+                }
+                Vec3 p[3];
+                for (int k = 0; k < 3; ++k)
+                    p[k] = vertices[tri[k]].position;
+                const Vec3 before = triNormal(p[0], p[1], p[2]);
+                for (int k = 0; k < 3; ++k)
+                    if (tri[k] == c.from)
+                        p[k] = vertices[c.to].position;
+                const Vec3 after = triNormal(p[0], p[1], p[2]);
+                ok = before.dot(after) > 0.f;
+                if (const float len = before.length(); len > 0.f)
+                    offPlane = std::max(offPlane, std::abs(before.dot(move)) / len);
+            }
+            /* triangles around `from` were within drift[from] of the input; the reshaped ones add offPlane */
+            const float deviation = drift[c.from] + offPlane;
+            if (!ok || deviation > maxError)
+                continue;
+
+            remap[c.from] = c.to;
+            quadrics[c.to] += quadrics[c.from];
+            worst = std::max(worst, deviation);
+            for (std::uint32_t j = adjFirst[c.from]; j < adjFirst[c.from + 1]; ++j) {
+                for (int k = 0; k < 3; ++k) {
+                    const std::uint32_t v = tris[adjacency[j] * 3 + k];
+                    dirty[v] = 1;
+                    drift[v] = std::max(drift[v], deviation);
+                }
+            }
+            ++applied;
+            removed += dying;
+            if (removed >= budget)
+                break;
+        }
+        if (applied == 0)
+            break;
+
+        std::size_t out = 0;
+        for (std::size_t t = 0; t < tris.size(); t += 3) {
+            const std::uint32_t a = remap[tris[t]], b = remap[tris[t + 1]], c = remap[tris[t + 2]];
+            if (a == b || b == c || a == c)
+                continue;
+            tris[out++] = a;
+            tris[out++] = b;
+            tris[out++] = c;
+        }
+        tris.resize(out);
+    }
+    result.error = worst;
+    return result;
+}
+
+void generateLods(SourceSubmesh& mesh, std::uint32_t levels, float maxError) {
+    mesh.lods.clear();
+    const auto vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+    const std::vector<std::uint32_t>* prev = &mesh.indices;
+    float error = 0.f;
+    for (std::uint32_t level = 1; level < levels; ++level) {
+        const std::size_t target = std::max<std::size_t>(prev->size() / 6 * 3, 3);
+        SimplifyResult r = simplifyMesh(*prev, mesh.vertices, target, maxError - error);
+        if (r.indices.empty() || r.indices.size() * 10 > prev->size() * 9)
+            break;
+        optimizeVertexCache(r.indices, vertexCount);
+        error += r.error;
+        mesh.lods.push_back({std::move(r.indices), error});
+        prev = &mesh.lods.back().indices;
+    }
+}
+
+} // namespace gfx
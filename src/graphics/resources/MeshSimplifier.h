@@ -0,0 +1,42 @@
+#pragma once
+#include "graphics/resources/CookedMesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   Quadric-error-metric simplifier (Garland & Heckbert) for LODs
+   * Half-edge collapses only: a vertex moves onto a neighbour, so
+     every LOD indexes the original vertex buffer – no new vertices,
+     no attribute interpolation
+   * Area-weighted plane quadrics + penalty planes on open borders;
+     border vertices only slide along their border
+   * Vertices on attribute seams (same position, several vertices)
+     are locked, so UV/normal seams never tear
+   * Collapses that would flip a triangle are rejected
+   * Works in passes: rank every edge by quadric cost, collapse the
+     cheapest independent ones whose deviation stays within maxError,
+     rebuild – until the target is reached or nothing fits
+ * ----------------------------------------------------------------- */
+struct SimplifyResult {
+    std::vector<std::uint32_t> indices;
+    /* Upper bound on the deviation introduced, in object units: each
+       collapse adds the largest distance of the moved vertex from the
+       planes of the triangles it reshapes to the drift those triangles
+       already had.  CookedMesh turns it into pixels per screen size. */
+    float error{0.f};
+};
+
+SimplifyResult simplifyMesh(std::span<const std::uint32_t> indices, std::span<const SourceVertex> vertices,
+                            std::size_t targetIndexCount, float maxError);
+
+/* Fills mesh.lods so the submesh has up to `levels` LODs, each half
+   the triangles of the one before and vertex-cache optimised.  Stops
+   early once a level can't shed another 10% of its triangles within
+   maxError.  LOD errors are cumulative (upper bound of the deviation
+   from LOD 0). */
+void generateLods(SourceSubmesh& mesh, std::uint32_t levels, float maxError);
+
+} // namespace gfx
@@ -0,0 +1,107 @@
+#include "graphics/resources/MeshletBuilder.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gfx {
+
+using core::math::Vec3;
+
+namespace {
+
+void computeMeshletBounds(CookedMeshlet& m, std::span<const std::uint32_t> tris,
+                          std::span<const SourceVertex> vertices) {
+    Vec3 lo = vertices[tris[0]].position, hi = lo;
+    for (std::uint32_t i : tris) {
+        const Vec3& p = vertices[i].position;
+        for (int k = 0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], p[k]);
+            hi[k] = std::max(hi[k], p[k]);
+        }
+    }
+    m.center = (lo + hi) * 0.5f;
+    float r2 = 0.f;
+    for (std::uint32_t i : tris)
+        r2 = std::max(r2, (vertices[i].position - m.center).lengthSquared());
+    m.radius = std::sqrt(r2);
+
+    /* cone: axis = mean face normal, opening = the widest normal */
+    Vec3 normals[kMeshletMaxTriangles];
+    std::size_t normalCount = 0;
+    Vec3 sum{};
+    for (std::size_t t = 0; t < tris.size(); t += 3) {
+        const Vec3& a = vertices[tris[t]].position;
+        const Vec3 n = (vertices[tris[t + 1]].position - a).cross(vertices[tris[t + 2]].position - a);
+        const float len = n.length();
+        if (len <= 0.f)
+            continue;
+        normals[normalCount] = n * (1.f / len);
+        sum += normals[normalCount++];
+    }
+    const float sumLen = sum.length();
+    m.coneAxis = sumLen > 0.f ? sum * (1.f / sumLen) : Vec3{0.f, 0.f, 1.f};
+    m.coneCutoff = 1.f;
+    if (normalCount == 0 || sumLen <= 0.f)
+        return;
+    float minDot = 1.f;
+    for (std::size_t i = 0; i < normalCount; ++i)
+        minDot = std::min(minDot, normals[i].dot(m.coneAxis));
+    if (minDot > 0.f)
+        m.coneCutoff = std::sqrt(1.f - minDot * minDot);
+}
+
+} // namespace
+
+std::vector<CookedMeshlet> buildMeshlets(std::span<const std::uint32_t> indices, std::span<const SourceVertex> vertices,
+                                         std::uint32_t maxVertices, std::uint32_t maxTriangles) {
+    if (maxVertices < 3 || maxVertices > 0xFFFF || maxTriangles == 0 || maxTriangles > kMeshletMaxTriangles)
+        throw std::invalid_argument("buildMeshlets: bad meshlet limits");
+    if (indices.size() % 3)
+        throw std::invalid_argument("buildMeshlets: index count not a multiple of 3");
+
+    std::vector<CookedMeshlet> meshlets;
+    std::vector<std::uint32_t> owner(vertices.size(), ~0u); // last meshlet that referenced the vertex
+    CookedMeshlet cur{};
+    auto flush = [&](std::size_t end) {
+        if (cur.triangleCount == 0)
+            return;
+        computeMeshletBounds(cur, indices.subspan(cur.firstIndex, end - cur.firstIndex), vertices);
+        meshlets.push_back(cur);
+    };
+
+    auto newVertices = [&](std::size_t t, std::uint32_t id) {
+        std::uint32_t fresh = 0;
+        for (std::size_t k = 0; k < 3; ++k) {
+            bool repeated = owner[indices[t + k]] == id;
+            for (std::size_t j = 0; j < k; ++j)
+                repeated |= indices[t + j] == indices[t + k];
+            fresh += !repeated;
+        }
+        return fresh;
+    };
+
+    for (std::size_t t = 0; t < indices.size(); t += 3) {
+        for (std::size_t k = 0; k < 3; ++k)
+            if (indices[t + k] >= vertices.size())
+                throw std::invalid_argument("buildMeshlets: index out of range");
+        std::uint32_t fresh = newVertices(t, static_cast<std::uint32_t>(meshlets.size()));
+        if (cur.triangleCount == maxTriangles || cur.vertexCount + fresh > maxVertices) {
+            flush(t);
+            cur = {};
+            cur.firstIndex = static_cast<std::uint32_t>(t);
+            fresh = newVertices(t, static_cast<std::uint32_t>(meshlets.size()));
+        }
+        for (std::size_t k = 0; k < 3; ++k)
+            owner[indices[t + k]] = static_cast<std::uint32_t>(meshlets.size());
+        cur.vertexCount = static_cast<std::uint16_t>(cur.vertexCount + fresh);
+        ++cur.triangleCount;
+    }
+    flush(indices.size());
+    return meshlets;
+}
+
+void generateMeshlets(SourceSubmesh& mesh) {
+    mesh.meshlets = buildMeshlets(mesh.indices, mesh.vertices);
+}
+
+} // namespace gfx
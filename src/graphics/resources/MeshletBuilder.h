@@ -0,0 +1,28 @@
+#pragma once
+#include "graphics/resources/CookedMesh.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   Meshlet partitioning for cluster culling (mesh_cooker)
+   * Greedy over the index list as it is: a meshlet grows until the
+     next triangle would exceed maxVertices unique vertices or
+     maxTriangles – run it after optimizeVertexCache so neighbouring
+     triangles (and so tight bounds) end up together
+   * Meshlets are contiguous index ranges, the index list is not
+     touched and no per-meshlet vertex/primitive lists are stored
+   * Bounds: sphere around the AABB centre; cone from the geometric
+     face normals (the winding the rasterizer culls by), see
+     CookedMeshlet for the test
+ * ----------------------------------------------------------------- */
+std::vector<CookedMeshlet> buildMeshlets(std::span<const std::uint32_t> indices, std::span<const SourceVertex> vertices,
+                                         std::uint32_t maxVertices = kMeshletMaxVertices,
+                                         std::uint32_t maxTriangles = kMeshletMaxTriangles);
+
+/* Fills mesh.meshlets over LOD 0 */
+void generateMeshlets(SourceSubmesh& mesh);
+
+} // namespace gfx
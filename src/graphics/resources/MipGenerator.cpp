@@ -0,0 +1,198 @@
+#include "graphics/resources/MipGenerator.h"
+#include "core/jobs/JobSystem.h"
+#include "core/math/Simd128.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+namespace gfx {
+
+namespace {
+
+using core::math::Float4;
+
+constexpr int kMaxTaps = 8;
+constexpr std::size_t kTexelsPerJob = 64 * 1024;
+
+/* 2:1 kernel – dst texel x covers src texels 2x, 2x+1; tap k reads src 2x + first + k */
+struct Kernel {
+    int first;
+    int count;
+    std::array<float, kMaxTaps> weights;
+};
+
+double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+Kernel makeKernel(MipFilter filter) {
+    if (filter == MipFilter::Box)
+        return {0, 2, {0.5f, 0.5f}};
+
+    /* sinc at the destination's Nyquist rate, Kaiser window (alpha 4) over ±4 src texels */
+    constexpr double kAlpha = 4.0, kRadius = 4.0;
+    Kernel k{-3, 8, {}};
+    double total = 0.0;
+    for (int i = 0; i < k.count; ++i) {
+        const double d = (k.first + i) - 0.5; // src texel centre → dst texel centre
+        const double t = d / 2.0;
+        const double sinc = std::sin(std::numbers::pi * t) / (std::numbers::pi * t);
+        const double x = d / kRadius;
+        const double window = besselI0(kAlpha * std::sqrt(1.0 - x * x)) / besselI0(kAlpha);
+        k.weights[i] = static_cast<float>(sinc * window);
+        total += k.weights[i];
+    }
+    for (int i = 0; i < k.count; ++i)
+        k.weights[i] = static_cast<float>(k.weights[i] / total);
+    return k;
+}
+
+struct ColorLuts {
+    std::array<float, 256> toLinear;
+    std::array<std::uint8_t, 4096> toSrgb; // indexed by linear × 4095
+
+    ColorLuts() {
+        for (int i = 0; i < 256; ++i) {
+            const float c = i / 255.f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; ++i) {
+            const float l = i / 4095.f;
+            const float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.f / 2.4f) - 0.055f;
+            toSrgb[i] = static_cast<std::uint8_t>(std::clamp(c * 255.f + 0.5f, 0.f, 255.f));
+        }
+    }
+};
+
+const ColorLuts& luts() {
+    static const ColorLuts s;
+    return s;
+}
+
+std::size_t rowsPerJob(std::uint32_t width) {
+    return std::max<std::size_t>(1, kTexelsPerJob / std::max(width, 1u));
+}
+
+/* src rows [y0, y1): halve horizontally */
+void filterRows(const float* src, std::uint32_t sw, float* dst, std::uint32_t dw, const Kernel& k, std::size_t y0,
+                std::size_t y1) {
+    for (std::size_t y = y0; y < y1; ++y) {
+        const float* in = src + y * sw * 4;
+        float* out = dst + y * dw * 4;
+        for (std::uint32_t x = 0; x < dw; ++x) {
+            Float4 acc;
+            for (int i = 0; i < k.count; ++i) {
+                const int sx = std::clamp(static_cast<int>(2 * x) + k.first + i, 0, static_cast<int>(sw) - 1);
+                acc = acc + Float4::load(in + sx * 4) * Float4{k.weights[i]};
+            }
+            acc.store(out + x * 4);
+        }
+    }
+}
+
+/* dst rows [y0, y1): halve vertically, clamp to [0, 1] (Kaiser rings) */
+void filterColumns(const float* src, std::uint32_t sh, float* dst, std::uint32_t dw, const Kernel& k, std::size_t y0,
+                   std::size_t y1) {
+    for (std::size_t y = y0; y < y1; ++y) {
+        const float* rows[kMaxTaps];
+        for (int i = 0; i < k.count; ++i) {
+            const int sy = std::clamp(static_cast<int>(2 * y) + k.first + i, 0, static_cast<int>(sh) - 1);
+            rows[i] = src + static_cast<std::size_t>(sy) * dw * 4;
+        }
+        float* out = dst + y * dw * 4;
+        for (std::uint32_t x = 0; x < dw; ++x) {
+            Float4 acc;
+            for (int i = 0; i < k.count; ++i)
+                acc = acc + Float4::load(rows[i] + x * 4) * Float4{k.weights[i]};
+            acc.store(out + x * 4);
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = std::clamp(out[x * 4 + c], 0.f, 1.f);
+        }
+    }
+}
+
+void toBytes(const float* src, std::uint8_t* dst, std::size_t texels, bool srgb) {
+    const auto& lut = luts();
+    for (std::size_t i = 0; i < texels; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            const float v = src[i * 4 + c];
+            dst[i * 4 + c] = srgb ? lut.toSrgb[static_cast<int>(v * 4095.f + 0.5f)]
+                                  : static_cast<std::uint8_t>(v * 255.f + 0.5f);
+        }
+        dst[i * 4 + 3] = static_cast<std::uint8_t>(src[i * 4 + 3] * 255.f + 0.5f);
+    }
+}
+
+} // namespace
+
+std::uint32_t mipLevelCount(std::uint32_t width, std::uint32_t height) noexcept {
+    std::uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        ++levels;
+    }
+    return levels;
+}
+
+MipChain generateMips(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height, const MipOptions& options) {
+    using core::jobs::JobSystem;
+
+    std::uint32_t levelCount = mipLevelCount(width, height);
+    if (options.maxLevels)
+        levelCount = std::min(levelCount, options.maxLevels);
+
+    MipChain chain;
+    std::uint64_t total = 0;
+    for (std::uint32_t i = 0, w = width, h = height; i < levelCount; ++i) {
+        const std::uint64_t size = std::uint64_t{w} * h * 4;
+        chain.levels.push_back({total, size, w, h});
+        total += size;
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+    }
+    chain.rgba.resize(total);
+    std::memcpy(chain.rgba.data(), rgba, chain.levels[0].size);
+    if (levelCount == 1)
+        return chain;
+
+    /* level 0 → linear floats */
+    const auto& lut = luts();
+    std::vector<float> cur(static_cast<std::size_t>(width) * height * 4);
+    JobSystem::parallelFor(height, rowsPerJob(width), [&](std::size_t y0, std::size_t y1) {
+        for (std::size_t i = y0 * width * 4; i < y1 * width * 4; ++i) {
+            const bool color = options.srgb && (i % 4) != 3;
+            cur[i] = color ? lut.toLinear[rgba[i]] : rgba[i] / 255.f;
+        }
+    });
+
+    const Kernel kernel = makeKernel(options.filter);
+    std::vector<float> tmp, next;
+    for (std::uint32_t level = 1; level < levelCount; ++level) {
+        const CookedMip& src = chain.levels[level - 1];
+        const CookedMip& dst = chain.levels[level];
+
+        tmp.resize(static_cast<std::size_t>(dst.width) * src.height * 4);
+        JobSystem::parallelFor(src.height, rowsPerJob(src.width), [&](std::size_t y0, std::size_t y1) {
+            filterRows(cur.data(), src.width, tmp.data(), dst.width, kernel, y0, y1);
+        });
+
+        next.resize(static_cast<std::size_t>(dst.width) * dst.height * 4);
+        JobSystem::parallelFor(dst.height, rowsPerJob(dst.width), [&](std::size_t y0, std::size_t y1) {
+            filterColumns(tmp.data(), src.height, next.data(), dst.width, kernel, y0, y1);
+            toBytes(next.data() + y0 * dst.width * 4, chain.rgba.data() + dst.offset + y0 * dst.width * 4,
+                    (y1 - y0) * dst.width, options.srgb);
+        });
+        cur.swap(next);
+    }
+    return chain;
+}
+
+} // namespace gfx
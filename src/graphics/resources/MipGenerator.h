@@ -0,0 +1,39 @@
+#pragma once
+#include "graphics/resources/CookedTexture.h"
+#include <cstdint>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   CPU mip-chain generator for RGBA8 images
+   * Separable 2:1 downsampling: Box (2 taps) or Kaiser-windowed sinc
+     (8 taps – sharper, less aliasing)
+   * sRGB-correct: colour is filtered in linear light (LUT in, LUT
+     out), alpha is always linear
+   * Each level is filtered from the previous level's float data, so
+     error doesn't compound through 8-bit requantisation
+   * Rows are split across JobSystem (inline if it isn't running);
+     the inner loops run on Float4
+ * ----------------------------------------------------------------- */
+enum class MipFilter { Box, Kaiser };
+
+struct MipOptions {
+    MipFilter filter{MipFilter::Kaiser};
+    bool srgb{true};
+    std::uint32_t maxLevels{0}; // 0 = down to 1×1
+};
+
+/* Every level in one contiguous, tightly packed buffer – ready for a
+   single staging copy with one buffer→image region per level */
+struct MipChain {
+    std::vector<std::uint8_t> rgba;
+    std::vector<CookedMip> levels; // offset/size into rgba, level 0 first
+};
+
+std::uint32_t mipLevelCount(std::uint32_t width, std::uint32_t height) noexcept;
+
+MipChain generateMips(const std::uint8_t* rgba, std::uint32_t width, std::uint32_t height,
+                      const MipOptions& options = {});
+
+} // namespace gfx
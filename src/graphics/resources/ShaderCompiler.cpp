@@ -0,0 +1,89 @@
+#include "graphics/resources/ShaderCompiler.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace gfx {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<std::byte> readAll(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    const std::vector<char> chars{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    std::vector<std::byte> out(chars.size());
+    if (!chars.empty())
+        std::memcpy(out.data(), chars.data(), chars.size());
+    return out;
+}
+
+std::string quote(const fs::path& p) {
+    return '"' + p.string() + '"';
+}
+
+} // namespace
+
+fs::path shaderCompilerPath() {
+    if (const char* glslc = std::getenv("GLSLC"); glslc && *glslc)
+        return glslc;
+#if defined(_WIN32)
+    const char* exe = "glslc.exe";
+#else
+    const char* exe = "glslc";
+#endif
+    if (const char* sdk = std::getenv("VULKAN_SDK"); sdk && *sdk) {
+        const fs::path p = fs::path(sdk) / "bin" / exe;
+        std::error_code ec;
+        if (fs::exists(p, ec))
+            return p;
+    }
+    return exe;
+}
+
+ShaderCompileResult compileShader(const fs::path& source) {
+    static std::atomic<std::uint32_t> s_counter{0}; // unique temp names across concurrent jobs
+    const fs::path tmp = fs::temp_directory_path() /
+                         ("ve_shader_" + std::to_string(s_counter.fetch_add(1)) + "_" + source.filename().string());
+    const fs::path spv = fs::path(tmp).concat(".spv");
+    const fs::path log = fs::path(tmp).concat(".log");
+
+    std::string cmd = quote(shaderCompilerPath()) + " " + quote(source) + " -o " + quote(spv) + " > " + quote(log) +
+                      " 2>&1";
+#if defined(_WIN32)
+    cmd = '"' + cmd + '"'; // cmd.exe strips the outer pair
+#endif
+    const int status = std::system(cmd.c_str());
+
+    ShaderCompileResult r;
+    const auto logBytes = readAll(log);
+    r.log.assign(reinterpret_cast<const char*>(logBytes.data()), logBytes.size());
+    if (status == 0) {
+        r.spirv = readAll(spv);
+        if (!isSpirv(r.spirv)) {
+            r.log += "glslc produced no valid SPIR-V\n";
+            r.spirv.clear();
+        }
+    } else if (r.log.empty()) {
+        r.log = "cannot run " + shaderCompilerPath().string() + "\n";
+    }
+    std::error_code ec;
+    fs::remove(spv, ec);
+    fs::remove(log, ec);
+    return r;
+}
+
+bool isSpirv(const std::vector<std::byte>& code) noexcept {
+    constexpr std::uint32_t kMagic = 0x07230203;
+    std::uint32_t magic = 0;
+    if (code.size() < 20 || code.size() % 4)
+        return false;
+    std::memcpy(&magic, code.data(), sizeof(magic));
+    return magic == kMagic;
+}
+
+} // namespace gfx
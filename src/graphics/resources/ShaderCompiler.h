@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   GLSL → SPIR-V for hot reload, through the Vulkan SDK's glslc
+   * Compiler: $GLSLC, else $VULKAN_SDK/bin/glslc, else glslc on PATH
+   * Stage comes from the extension (.vert, .frag, .comp, …)
+   * Blocking – run it on a JobSystem worker, not the render thread
+ * ----------------------------------------------------------------- */
+struct ShaderCompileResult {
+    std::vector<std::byte> spirv; // empty on failure
+    std::string log;              // compiler diagnostics
+
+    bool ok() const noexcept {
+        return !spirv.empty();
+    }
+};
+
+std::filesystem::path shaderCompilerPath();
+
+ShaderCompileResult compileShader(const std::filesystem::path& source);
+
+/* SPIR-V magic + word-aligned size */
+bool isSpirv(const std::vector<std::byte>& code) noexcept;
+
+} // namespace gfx
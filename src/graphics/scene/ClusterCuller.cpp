@@ -0,0 +1,79 @@
+#include "graphics/scene/ClusterCuller.h"
+#include "core/jobs/JobSystem.h"
+
+namespace gfx {
+
+using core::math::Vec3;
+using core::math::Vec4;
+
+namespace {
+
+enum : std::uint8_t { kVisible, kFrustumCulled, kBackfaceCulled };
+
+constexpr std::size_t kCullGrain = 64;
+
+} // namespace
+
+Frustum Frustum::fromMatrix(const core::math::Mat4& clip) noexcept {
+    /* Gribb/Hartmann: plane = row3 ± rowN; near is row2 alone for 0..w depth */
+    auto row = [&](std::size_t r) { return Vec4{clip(0, r), clip(1, r), clip(2, r), clip(3, r)}; };
+    const Vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+    Frustum f;
+    f.planes = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2};
+    for (Vec4& p : f.planes) {
+        const float len = Vec3{p[0], p[1], p[2]}.length();
+        if (len > 0.f)
+            p *= 1.f / len;
+    }
+    return f;
+}
+
+bool Frustum::intersectsSphere(const Vec3& center, float radius) const noexcept {
+    for (const Vec4& p : planes)
+        if (p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3] < -radius)
+            return false;
+    return true;
+}
+
+bool meshletBackfacing(const CookedMeshlet& m, const Vec3& eye) noexcept {
+    if (m.coneCutoff >= 1.f)
+        return false;
+    const Vec3 toCenter = m.center - eye;
+    return toCenter.dot(m.coneAxis) >= m.coneCutoff * toCenter.length() + m.radius;
+}
+
+ClusterCullStats cullClusters(std::span<const CookedMeshlet> meshlets, const Frustum& frustum, const Vec3& eye,
+                              std::vector<IndexRange>& out) {
+    std::vector<std::uint8_t> result(meshlets.size());
+    core::jobs::JobSystem::parallelFor(meshlets.size(), kCullGrain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const CookedMeshlet& m = meshlets[i];
+            result[i] = !frustum.intersectsSphere(m.center, m.radius) ? kFrustumCulled
+                        : meshletBackfacing(m, eye)                   ? kBackfaceCulled
+                                                                      : kVisible;
+        }
+    });
+
+    ClusterCullStats stats;
+    const std::size_t firstOut = out.size(); // never merge into another call's ranges
+    for (std::size_t i = 0; i < meshlets.size(); ++i) {
+        if (result[i] == kFrustumCulled) {
+            ++stats.frustumCulled;
+            continue;
+        }
+        if (result[i] == kBackfaceCulled) {
+            ++stats.backfaceCulled;
+            continue;
+        }
+        ++stats.visible;
+        const CookedMeshlet& m = meshlets[i];
+        const std::uint32_t count = m.triangleCount * 3u;
+        if (out.size() > firstOut && out.back().firstIndex + out.back().indexCount == m.firstIndex)
+            out.back().indexCount += count;
+        else
+            out.push_back({m.firstIndex, count});
+    }
+    return stats;
+}
+
+} // namespace gfx
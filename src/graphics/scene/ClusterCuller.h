@@ -0,0 +1,45 @@
+#pragma once
+#include "core/math/Mat4.hpp"
+#include "graphics/resources/CookedMesh.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace gfx {
+
+/* ----------------------------------------------------------------- *
+   CPU cluster culling over cooked meshlets
+   * Frustum: six planes pulled out of a clip matrix (Vulkan 0..w
+     depth); pass proj * view * model to cull in object space
+   * Backface: the meshlet's normal cone, see CookedMeshlet
+   * Meshlets are tested in parallel on the JobSystem, then the
+     survivors are merged into as few index ranges as possible –
+     adjacent visible meshlets become one draw
+ * ----------------------------------------------------------------- */
+struct Frustum {
+    std::array<core::math::Vec4, 6> planes{}; // xyz normal (inward, unit), w distance
+
+    static Frustum fromMatrix(const core::math::Mat4& clip) noexcept;
+    bool intersectsSphere(const core::math::Vec3& center, float radius) const noexcept;
+};
+
+struct IndexRange {
+    std::uint32_t firstIndex;
+    std::uint32_t indexCount;
+};
+
+struct ClusterCullStats {
+    std::uint32_t visible{0};
+    std::uint32_t frustumCulled{0};
+    std::uint32_t backfaceCulled{0};
+};
+
+bool meshletBackfacing(const CookedMeshlet& m, const core::math::Vec3& eye) noexcept;
+
+/* Appends the visible ranges to `out` (not cleared).  `frustum` and
+   `eye` must be in the meshlets' (object) space. */
+ClusterCullStats cullClusters(std::span<const CookedMeshlet> meshlets, const Frustum& frustum,
+                              const core::math::Vec3& eye, std::vector<IndexRange>& out);
+
+} // namespace gfx
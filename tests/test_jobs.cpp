@@ -16,3 +16,38 @@ TEST_CASE("JobSystem submit and wait", "[jobs]") {
 
     JobSystem::stop();
 }
+
+TEST_CASE("JobSystem numbers its worker threads", "[jobs]") {
+    using namespace core::jobs;
+    REQUIRE(JobSystem::workerIndex() == 0);
+    JobSystem::start(2);
+    REQUIRE(JobSystem::workerCount() == 2);
+
+    std::atomic<int> seen[3]{};
+    JobSystem::parallelFor(64, 1, [&](std::size_t, std::size_t) {
+        const std::size_t w = JobSystem::workerIndex();
+        if (w <= 2)
+            ++seen[w];
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    });
+    REQUIRE(seen[0] > 0); // the caller takes part but is no worker
+    REQUIRE(seen[0] + seen[1] + seen[2] == 64);
+    REQUIRE(JobSystem::workerIndex() == 0);
+
+    JobSystem::stop();
+    REQUIRE(JobSystem::workerCount() == 0);
+}
+
+TEST_CASE("JobSystem runs parallelFor inline inside a job", "[jobs]") {
+    using namespace core::jobs;
+    JobSystem::start(1); // the only worker must not wait for ranges nobody is left to run
+
+    auto sum = JobSystem::submit([] {
+        std::size_t total = 0;
+        JobSystem::parallelFor(64, 1, [&](std::size_t begin, std::size_t end) { total += end - begin; });
+        return total;
+    });
+    REQUIRE(sum.get() == 64);
+
+    JobSystem::stop();
+}
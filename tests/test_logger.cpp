@@ -0,0 +1,94 @@
+#include "core/util/Logger.h"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct CaptureSink final : core::util::LogSink {
+    std::mutex* m;
+    std::string* out;
+    void write(std::string_view batch) override {
+        std::lock_guard lk{*m};
+        out->append(batch);
+    }
+};
+} // namespace
+
+TEST_CASE("Logger drains records from many threads", "[logger]") {
+    using core::util::Logger;
+    std::mutex m;
+    std::string out;
+    auto sink = std::make_unique<CaptureSink>();
+    sink->m = &m;
+    sink->out = &out;
+    const auto* sinkPtr = sink.get();
+    Logger::addSink(std::move(sink));
+    Logger::init("test");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([t] {
+            for (int i = 0; i < 200; ++i)
+                Logger::info("worker {} line {}", t, i);
+        });
+    for (auto& th : threads)
+        th.join();
+    Logger::flush();
+
+    std::size_t lines = 0;
+    {
+        std::lock_guard lk{m};
+        for (char c : out)
+            lines += (c == '\n');
+        REQUIRE(out.find("[I] test #") != std::string::npos);
+        REQUIRE(out.find("worker 3 line 199") != std::string::npos);
+    }
+    REQUIRE(lines + Logger::droppedCount() >= 800);
+    Logger::shutdown();
+    Logger::removeSink(sinkPtr);
+}
+
+TEST_CASE("Logger defers formatting of raw arguments", "[logger]") {
+    using core::util::Logger;
+    std::mutex m;
+    std::string out;
+    auto sink = std::make_unique<CaptureSink>();
+    sink->m = &m;
+    sink->out = &out;
+    const auto* sinkPtr = sink.get();
+    Logger::addSink(std::move(sink));
+    Logger::init("test");
+
+    std::string owned = "temporary";
+    const char* nothing = nullptr;
+    Logger::info("i={} f={:.2f} s={} sv={} n={} b={}", 42, 1.5, owned, std::string_view{"view"}, nothing, true);
+    owned = "overwritten"; // the record must hold its own copy
+    Logger::warn("{:>4}|{:#x}", 7, 255u);
+    Logger::info("{}", std::string(400, 'x')); // too big to defer or to fit a record → written whole
+    Logger::shutdown();
+    Logger::removeSink(sinkPtr);
+
+    REQUIRE(out.find("i=42 f=1.50 s=temporary sv=view n=(null) b=true") != std::string::npos);
+    REQUIRE(out.find("   7|0xff") != std::string::npos);
+    REQUIRE(out.find(std::string(400, 'x') + "\n") != std::string::npos);
+}
+
+TEST_CASE("RotatingFileSink rolls over", "[logger]") {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "ve_log_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    {
+        core::util::RotatingFileSink sink{dir / "engine.log", 64, 2};
+        for (int i = 0; i < 8; ++i)
+            sink.write("0123456789012345678901234567890123456789\n");
+    }
+    REQUIRE(fs::exists(dir / "engine.log"));
+    REQUIRE(fs::exists(dir / "engine.1.log"));
+    REQUIRE(fs::exists(dir / "engine.2.log"));
+    REQUIRE_FALSE(fs::exists(dir / "engine.3.log"));
+    fs::remove_all(dir);
+}
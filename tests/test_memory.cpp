@@ -0,0 +1,42 @@
+#include "core/memory/VirtualArena.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+
+TEST_CASE("VirtualArena commits on demand", "[memory]") {
+    using core::memory::VirtualArena;
+    VirtualArena arena{64ull << 20}; // 64 MiB reserved
+    REQUIRE(arena.committed() == 0);
+
+    auto* a = static_cast<char*>(arena.alloc(100));
+    std::memset(a, 0xAB, 100);
+    REQUIRE(arena.committed() >= 100);
+    REQUIRE(arena.committed() < arena.reserved());
+
+    /* growth never moves earlier allocations */
+    void* big = arena.alloc(8u << 20, 64);
+    REQUIRE(big != nullptr);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(big) % 64 == 0);
+    REQUIRE(static_cast<unsigned char>(a[99]) == 0xAB);
+    REQUIRE(arena.committed() >= arena.used());
+}
+
+TEST_CASE("VirtualArena rewind and reset", "[memory]") {
+    using core::memory::VirtualArena;
+    VirtualArena arena{16ull << 20};
+    arena.alloc(1024);
+    const auto m = arena.marker();
+    arena.alloc(4u << 20);
+    arena.rewind(m);
+    REQUIRE(arena.used() == m);
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.committed() == 0);
+
+    /* pages come back zeroed and writable after decommit */
+    auto* p = arena.allocArray<std::uint32_t>(256);
+    REQUIRE(p != nullptr);
+    REQUIRE(p[0] == 0);
+    p[255] = 7;
+    REQUIRE(p[255] == 7);
+}
@@ -0,0 +1,393 @@
+#include "graphics/resources/CookedMesh.h"
+#include "graphics/resources/MeshOptimizer.h"
+#include "core/jobs/JobSystem.h"
+#include "graphics/resources/MeshSimplifier.h"
+#include "graphics/resources/MeshletBuilder.h"
+#include "graphics/scene/ClusterCuller.h"
+#include <algorithm>
+#include <array>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+/* n×n grid in the XZ plane, normals tilted so every octant gets exercised */
+gfx::SourceSubmesh grid(std::uint32_t n, float y) {
+    gfx::SourceSubmesh sm;
+    for (std::uint32_t j = 0; j <= n; ++j) {
+        for (std::uint32_t i = 0; i <= n; ++i) {
+            gfx::SourceVertex v;
+            v.position = {static_cast<float>(i), y, static_cast<float>(j)};
+            v.normal = core::math::Vec3{std::sin(i * 0.7f), std::cos(j * 0.3f), std::sin(i + j * 1.3f)}.normalized();
+            v.uv = {i / static_cast<float>(n), 1.f - j / static_cast<float>(n)};
+            v.color = {i / static_cast<float>(n), 0.5f, 0.25f, 1.f};
+            sm.vertices.push_back(v);
+        }
+    }
+    for (std::uint32_t j = 0; j < n; ++j) {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const std::uint32_t a = j * (n + 1) + i, b = a + 1, c = a + n + 1, d = c + 1;
+            sm.indices.insert(sm.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return sm;
+}
+
+/* UV sphere with a seam at u = 0/1 (duplicated vertices) and pole fans */
+gfx::SourceSubmesh uvSphere(std::uint32_t rings, std::uint32_t segments, float radius) {
+    gfx::SourceSubmesh sm;
+    for (std::uint32_t r = 0; r <= rings; ++r) {
+        const float theta = 3.14159265f * r / rings;
+        for (std::uint32_t s = 0; s <= segments; ++s) {
+            const float phi = 2.f * 3.14159265f * s / segments;
+            const core::math::Vec3 n{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+            gfx::SourceVertex v;
+            v.position = n * radius;
+            v.normal = n;
+            v.uv = {static_cast<float>(s) / segments, static_cast<float>(r) / rings};
+            sm.vertices.push_back(v);
+        }
+    }
+    for (std::uint32_t r = 0; r < rings; ++r) {
+        for (std::uint32_t s = 0; s < segments; ++s) {
+            const std::uint32_t a = r * (segments + 1) + s, b = a + 1, c = a + segments + 1, d = c + 1;
+            if (r != 0)
+                sm.indices.insert(sm.indices.end(), {a, b, c});
+            if (r != rings - 1)
+                sm.indices.insert(sm.indices.end(), {b, d, c});
+        }
+    }
+    return sm;
+}
+
+float surfaceArea(const gfx::SourceSubmesh& m, const std::vector<std::uint32_t>& indices) {
+    float area = 0.f;
+    for (std::size_t t = 0; t < indices.size(); t += 3) {
+        const auto& a = m.vertices[indices[t]].position;
+        const auto& b = m.vertices[indices[t + 1]].position;
+        const auto& c = m.vertices[indices[t + 2]].position;
+        area += (b - a).cross(c - a).length() * 0.5f;
+    }
+    return area;
+}
+
+/* unindexed copy with triangles in a scrambled (LCG) order – worst case for the cache */
+gfx::SourceSubmesh scrambledSoup(const gfx::SourceSubmesh& src) {
+    std::vector<std::size_t> order(src.indices.size() / 3);
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::uint32_t state = 12345;
+    for (std::size_t i = order.size(); i > 1; --i) {
+        state = state * 1664525u + 1013904223u;
+        std::swap(order[i - 1], order[state % i]);
+    }
+    gfx::SourceSubmesh soup;
+    for (std::size_t t : order) {
+        for (int k = 0; k < 3; ++k) {
+            soup.indices.push_back(static_cast<std::uint32_t>(soup.vertices.size()));
+            soup.vertices.push_back(src.vertices[src.indices[t * 3 + k]]);
+        }
+    }
+    return soup;
+}
+
+/* triangles as position triples, rotated to a canonical start (winding kept), sorted */
+std::vector<std::array<float, 9>> triangleSet(const gfx::SourceSubmesh& m) {
+    std::vector<std::array<float, 9>> tris;
+    for (std::size_t t = 0; t < m.indices.size(); t += 3) {
+        std::array<std::array<float, 3>, 3> p;
+        for (int k = 0; k < 3; ++k)
+            p[k] = m.vertices[m.indices[t + k]].position.v;
+        std::rotate(p.begin(), std::min_element(p.begin(), p.end()), p.end());
+        tris.push_back({p[0][0], p[0][1], p[0][2], p[1][0], p[1][1], p[1][2], p[2][0], p[2][1], p[2][2]});
+    }
+    std::sort(tris.begin(), tris.end());
+    return tris;
+}
+
+} // namespace
+
+TEST_CASE("Half floats and octahedral normals round-trip", "[mesh]") {
+    using namespace gfx;
+    for (float f : {0.f, 1.f, -2.5f, 0.333f, 65504.f, 1e-6f})
+        REQUIRE(halfToFloat(floatToHalf(f)) == Catch::Approx(f).epsilon(1e-3).margin(1e-7));
+    REQUIRE(std::isinf(halfToFloat(floatToHalf(1e6f))));
+
+    using core::math::Vec3;
+    for (const Vec3 n : {Vec3{0, 0, 1}, Vec3{0, 0, -1}, Vec3{1, -2, -3}.normalized(), Vec3{-1, 1, 0.1f}.normalized()}) {
+        std::int16_t q[2];
+        octEncode(n, q);
+        REQUIRE(octDecode(q).dot(n) > 0.99999f);
+    }
+}
+
+TEST_CASE("Cooked mesh round-trips through a mapped file", "[mesh]") {
+    using namespace gfx;
+    const SourceSubmesh parts[] = {grid(8, 0.f), grid(3, 2.f)};
+    const auto blob = buildCookedMesh(parts);
+
+    const auto path = std::filesystem::temp_directory_path() / "ve_test_mesh.vmesh";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    const MeshFile mesh = loadCookedMesh(path);
+    const CookedMeshView& v = mesh.view;
+
+    REQUIRE(v.header->indexType == IndexType::U16);
+    REQUIRE(v.submeshes.size() == 2);
+    REQUIRE(v.vertices.size() == 81 + 16);
+    REQUIRE(v.indices16().size() == 8 * 8 * 6 + 3 * 3 * 6);
+    REQUIRE(v.indices32().empty());
+    REQUIRE(v.header->bounds.max[1] == 2.f);
+    REQUIRE(v.header->bounds.radius == Catch::Approx(std::sqrt(4.f * 4 + 1 + 4 * 4)));
+
+    const CookedSubmesh& second = v.submeshes[1];
+    REQUIRE(second.firstVertex == 81);
+    REQUIRE(second.firstIndex == 8 * 8 * 6);
+    REQUIRE(second.max[0] == 3.f);
+    for (std::uint32_t k = 0; k < second.indexCount; ++k)
+        REQUIRE(v.indices16()[second.firstIndex + k] == parts[1].indices[k]);
+
+    for (std::size_t i = 0; i < parts[0].vertices.size(); ++i) {
+        const SourceVertex& src = parts[0].vertices[i];
+        const SourceVertex back = decodeVertex(v.vertices[i], v.header->bounds);
+        REQUIRE((back.position - src.position).length() < 1e-3f);
+        REQUIRE(back.normal.dot(src.normal) > 0.9999f);
+        REQUIRE(std::abs(back.uv[0] - src.uv[0]) < 1e-3f);
+        REQUIRE(std::abs(back.color[0] - src.color[0]) < 1.f / 255);
+    }
+
+    auto bad = blob;
+    bad.resize(blob.size() - 16);
+    REQUIRE_THROWS(parseCookedMesh(bad));
+
+    /* an index offset that wraps offset + size back into the file */
+    auto wrapped = blob;
+    CookedMeshHeader h;
+    std::memcpy(&h, wrapped.data(), sizeof(h));
+    h.indexOffset = ~std::uint64_t{0} - (CookedMeshHeader::kSectionAlign - 1);
+    std::memcpy(wrapped.data(), &h, sizeof(h));
+    REQUIRE_THROWS(parseCookedMesh(wrapped));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Cooked mesh widens indices only when a submesh needs it", "[mesh]") {
+    using namespace gfx;
+    const SourceSubmesh big[] = {grid(256, 0.f)}; // 257² vertices
+    const auto blob = buildCookedMesh(big);
+    const CookedMeshView v = parseCookedMesh(blob);
+    REQUIRE(v.header->indexType == IndexType::U32);
+    REQUIRE(v.indices32().back() == big[0].indices.back());
+}
+
+TEST_CASE("Mesh optimizer welds, reorders and keeps every triangle", "[mesh]") {
+    using namespace gfx;
+    const SourceSubmesh reference = grid(32, 0.f);
+    SourceSubmesh mesh = scrambledSoup(reference);
+    const SourceSubmesh parts[] = {mesh};
+
+    const MeshOptimizeReport r = optimizeMesh(mesh, computeBounds(parts));
+    REQUIRE(r.welded == 32 * 32 * 6 - 33 * 33);
+    REQUIRE(mesh.vertices.size() == 33 * 33);
+    REQUIRE(r.before.atvr == Catch::Approx(1.f)); // soup: every vertex is used exactly once
+    REQUIRE(r.after.acmr < 1.f);
+    REQUIRE(r.after.atvr < 1.6f);
+    REQUIRE(r.after.acmr < r.before.acmr / 2);
+    REQUIRE(triangleSet(mesh) == triangleSet(reference));
+
+    /* fetch order: each index is either already seen or the next new vertex */
+    std::uint32_t next = 0;
+    for (std::uint32_t i : mesh.indices) {
+        REQUIRE(i <= next);
+        next = std::max(next, i + 1);
+    }
+}
+
+TEST_CASE("Vertex cache optimization beats row-major order on a grid", "[mesh]") {
+    using namespace gfx;
+    SourceSubmesh indexed = grid(64, 0.f);
+    const auto before = analyzeVertexCache(indexed.indices, static_cast<std::uint32_t>(indexed.vertices.size()));
+    optimizeVertexCache(indexed.indices, static_cast<std::uint32_t>(indexed.vertices.size()));
+    const auto after = analyzeVertexCache(indexed.indices, static_cast<std::uint32_t>(indexed.vertices.size()));
+    REQUIRE(after.acmr < before.acmr);
+    REQUIRE(after.acmr < 0.8f);
+}
+
+TEST_CASE("QEM simplifier collapses flat regions for free and keeps borders", "[mesh][lod]") {
+    using namespace gfx;
+    const SourceSubmesh flat = grid(32, 0.f);
+    const SimplifyResult r = simplifyMesh(flat.indices, flat.vertices, flat.indices.size() / 4, 1e-4f);
+    REQUIRE(r.indices.size() <= flat.indices.size() / 4);
+    REQUIRE(r.error < 1e-4f);
+    REQUIRE(surfaceArea(flat, r.indices) == Catch::Approx(32.f * 32.f)); // outline intact, nothing folded
+    for (std::size_t t = 0; t < r.indices.size(); t += 3) {
+        const auto& a = flat.vertices[r.indices[t]].position;
+        const auto& b = flat.vertices[r.indices[t + 1]].position;
+        const auto& c = flat.vertices[r.indices[t + 2]].position;
+        REQUIRE((b - a).cross(c - a)[1] > 0.f);
+    }
+}
+
+TEST_CASE("LOD chain is monotonic, cooked and selected by screen size", "[mesh][lod]") {
+    using namespace gfx;
+    SourceSubmesh sphere = uvSphere(32, 64, 1.f);
+    generateLods(sphere, 4, 0.2f);
+    REQUIRE(sphere.lods.size() == 3);
+
+    std::size_t prevCount = sphere.indices.size();
+    float prevError = 0.f;
+    for (const SourceLod& lod : sphere.lods) {
+        REQUIRE(lod.indices.size() < prevCount);
+        REQUIRE(lod.error >= prevError);
+        REQUIRE(lod.error <= 0.2f);
+        prevCount = lod.indices.size();
+        prevError = lod.error;
+    }
+    /* error bounds how far in a LOD sinks below the input (its vertices all stay on the unit sphere) */
+    auto sunk = [&](const std::vector<std::uint32_t>& indices) {
+        float deepest = 0.f;
+        for (std::size_t t = 0; t < indices.size(); t += 3) {
+            const auto centroid = (sphere.vertices[indices[t]].position + sphere.vertices[indices[t + 1]].position +
+                                   sphere.vertices[indices[t + 2]].position) *
+                                  (1.f / 3.f);
+            deepest = std::max(deepest, 1.f - centroid.length());
+        }
+        return deepest;
+    };
+    const float inputSunk = sunk(sphere.indices);
+    for (const SourceLod& lod : sphere.lods)
+        REQUIRE(sunk(lod.indices) <= inputSunk + lod.error);
+    /* silhouette survives: still roughly a unit sphere's area */
+    REQUIRE(surfaceArea(sphere, sphere.lods.back().indices) > 0.8f * 4.f * 3.14159265f);
+
+    const SourceSubmesh parts[] = {sphere};
+    const auto blob = buildCookedMesh(parts);
+    const CookedMeshView v = parseCookedMesh(blob);
+    const auto lods = v.lodsOf(v.submeshes[0]);
+    REQUIRE(lods.size() == 4);
+    REQUIRE(lods[0].indexCount == sphere.indices.size());
+    REQUIRE(std::isinf(lods[0].maxScreenSize));
+    for (std::size_t i = 1; i < lods.size(); ++i) {
+        REQUIRE(lods[i].firstIndex == lods[i - 1].firstIndex + lods[i - 1].indexCount);
+        REQUIRE(lods[i].maxScreenSize < lods[i - 1].maxScreenSize);
+    }
+
+    const float projScale = 1.f / std::tan(0.5f * 1.0472f); // 60° fov
+    const core::math::Vec3 eye{0.f, 0.f, 0.f};
+    REQUIRE(selectLod(lods, projectedSphereSize({0.f, 0.f, -3.f}, 1.f, eye, projScale)) == 0);
+    REQUIRE(selectLod(lods, projectedSphereSize({0.f, 0.f, -1e4f}, 1.f, eye, projScale)) == 3);
+    REQUIRE(selectLod(lods, projectedSphereSize({0.f, 0.f, 0.5f}, 1.f, eye, projScale)) == 0); // inside
+
+    const core::math::Vec4 spheres[] = {{0.f, 0.f, -3.f, 1.f}, {0.f, 0.f, -1e4f, 1.f}, {0.f, 0.f, -1e4f, 1e4f}};
+    std::uint32_t picked[3];
+    selectLods(lods, spheres, eye, projScale, picked);
+    REQUIRE(picked[0] == 0);
+    REQUIRE(picked[1] == 3);
+    REQUIRE(picked[2] == 0); // scaled instance up close
+}
+
+TEST_CASE("Meshlets partition LOD 0 within limits and their cones bound every face", "[mesh][meshlet]") {
+    using namespace gfx;
+    using core::math::Vec3;
+    SourceSubmesh sphere = uvSphere(32, 64, 1.f);
+    optimizeVertexCache(sphere.indices, static_cast<std::uint32_t>(sphere.vertices.size()));
+    generateMeshlets(sphere);
+    REQUIRE(sphere.meshlets.size() > 1);
+
+    std::uint32_t next = 0;
+    for (const CookedMeshlet& m : sphere.meshlets) {
+        REQUIRE(m.firstIndex == next);
+        REQUIRE(m.triangleCount > 0);
+        REQUIRE(m.triangleCount <= kMeshletMaxTriangles);
+        next += m.triangleCount * 3u;
+
+        std::vector<std::uint32_t> used(sphere.indices.begin() + m.firstIndex, sphere.indices.begin() + next);
+        std::sort(used.begin(), used.end());
+        used.erase(std::unique(used.begin(), used.end()), used.end());
+        REQUIRE(used.size() == m.vertexCount);
+        REQUIRE(m.vertexCount <= kMeshletMaxVertices);
+        for (std::uint32_t i : used)
+            REQUIRE((sphere.vertices[i].position - m.center).length() <= m.radius * 1.0001f);
+
+        REQUIRE(m.coneCutoff < 1.f); // a sphere patch is far from a hemisphere
+        const float minDot = std::sqrt(1.f - m.coneCutoff * m.coneCutoff);
+        for (std::uint32_t t = m.firstIndex; t < next; t += 3) {
+            const Vec3& a = sphere.vertices[sphere.indices[t]].position;
+            const Vec3 n = (sphere.vertices[sphere.indices[t + 1]].position - a)
+                               .cross(sphere.vertices[sphere.indices[t + 2]].position - a);
+            if (n.length() > 0.f)
+                REQUIRE(n.normalized().dot(m.coneAxis) >= minDot - 1e-4f);
+        }
+    }
+    REQUIRE(next == sphere.indices.size());
+
+    /* cooked: same meshlets, indices made absolute */
+    generateLods(sphere, 2, 0.2f);
+    const SourceSubmesh parts[] = {sphere, sphere};
+    const auto blob = buildCookedMesh(parts);
+    const CookedMeshView v = parseCookedMesh(blob);
+    REQUIRE(v.meshlets.size() == 2 * sphere.meshlets.size());
+    const auto second = v.meshletsOf(v.submeshes[1]);
+    REQUIRE(second.size() == sphere.meshlets.size());
+    REQUIRE(second[0].firstIndex == v.submeshes[1].firstIndex);
+    REQUIRE(second.back().firstIndex == v.submeshes[1].firstIndex + sphere.meshlets.back().firstIndex);
+}
+
+TEST_CASE("Cluster culler keeps every front-facing triangle and merges ranges", "[mesh][meshlet]") {
+    using namespace gfx;
+    using core::math::Mat4;
+    using core::math::Vec3;
+    SourceSubmesh sphere = uvSphere(32, 64, 1.f);
+    optimizeVertexCache(sphere.indices, static_cast<std::uint32_t>(sphere.vertices.size()));
+    generateMeshlets(sphere);
+
+    const Mat4 proj = Mat4::perspective(1.0472f, 1.f, 0.1f, 100.f);
+    auto cull = [&](const Vec3& eye, const Vec3& target, std::vector<IndexRange>& out) {
+        const Frustum f = Frustum::fromMatrix(proj * Mat4::lookAt(eye, target, {0.f, 1.f, 0.f}));
+        return cullClusters(sphere.meshlets, f, eye, out);
+    };
+
+    for (const Vec3& eye : {Vec3{0.f, 0.f, 4.f}, Vec3{3.f, 2.f, -1.f}, Vec3{0.f, -6.f, 0.5f}}) {
+        std::vector<IndexRange> ranges;
+        const ClusterCullStats st = cull(eye, {0.f, 0.f, 0.f}, ranges);
+        REQUIRE(st.visible + st.frustumCulled + st.backfaceCulled == sphere.meshlets.size());
+        REQUIRE(st.frustumCulled == 0); // whole sphere in view
+        REQUIRE(st.backfaceCulled > 0);
+        REQUIRE(ranges.size() <= st.visible);
+        for (std::size_t i = 1; i < ranges.size(); ++i)
+            REQUIRE(ranges[i].firstIndex > ranges[i - 1].firstIndex + ranges[i - 1].indexCount); // merged
+
+        auto drawn = [&](std::size_t t) {
+            return std::any_of(ranges.begin(), ranges.end(), [&](const IndexRange& r) {
+                return t >= r.firstIndex && t < r.firstIndex + r.indexCount;
+            });
+        };
+        for (std::size_t t = 0; t < sphere.indices.size(); t += 3) {
+            const Vec3& a = sphere.vertices[sphere.indices[t]].position;
+            const Vec3 n = (sphere.vertices[sphere.indices[t + 1]].position - a)
+                               .cross(sphere.vertices[sphere.indices[t + 2]].position - a);
+            if (n.dot(a - eye) < 0.f)
+                REQUIRE(drawn(t));
+        }
+    }
+
+    /* looking away: nothing survives the frustum */
+    std::vector<IndexRange> none;
+    const ClusterCullStats away = cull({0.f, 0.f, 4.f}, {0.f, 0.f, 8.f}, none);
+    REQUIRE(away.frustumCulled == sphere.meshlets.size());
+    REQUIRE(none.empty());
+
+    /* same answer when the tests run on the job system */
+    std::vector<IndexRange> serial, parallel;
+    cull({3.f, 2.f, -1.f}, {0.f, 0.f, 0.f}, serial);
+    core::jobs::JobSystem::start(3);
+    cull({3.f, 2.f, -1.f}, {0.f, 0.f, 0.f}, parallel);
+    core::jobs::JobSystem::stop();
+    REQUIRE(serial.size() == parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        REQUIRE(serial[i].firstIndex == parallel[i].firstIndex);
+        REQUIRE(serial[i].indexCount == parallel[i].indexCount);
+    }
+}
@@ -0,0 +1,617 @@
+#include "backend/RenderDevice.h"
+#include "core/jobs/JobSystem.h"
+#include "graphics/render/RenderGraph.h"
+#include "plugins/null/NullBackend.hpp"
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Names = std::vector<std::string>;
+
+/* compile() allocates through RenderDevice – give it the null backend */
+struct NullDevice {
+    NullDevice() {
+        gfx::RenderDevice::init(nullptr, "null");
+    }
+    ~NullDevice() {
+        gfx::RenderDevice::shutdown();
+    }
+};
+
+void addLogged(gfx::RenderGraph& g, const std::string& name, const Names& reads, const Names& writes,
+               std::vector<std::string>& log) {
+    g.addPass(name, gfx::PassType::Graphics, reads, writes, [&log, name](const auto&) { log.push_back(name); });
+}
+
+std::size_t position(const std::vector<std::string>& log, const std::string& name) {
+    return static_cast<std::size_t>(std::find(log.begin(), log.end(), name) - log.begin());
+}
+
+} // namespace
+
+TEST_CASE("RenderGraph orders passes by their resource dependencies", "[rendergraph]") {
+    NullDevice device;
+    gfx::RenderGraph g;
+    for (const char* r : {"depth", "gbuffer", "shadow", "hdr", "color"})
+        g.addTexture(r, {64, 64});
+
+    /* declared back to front: only the edges can produce the right order */
+    std::vector<std::string> log;
+    addLogged(g, "tonemap", {"hdr"}, {"color"}, log);
+    addLogged(g, "lighting", {"gbuffer", "shadow", "depth"}, {"hdr"}, log);
+    addLogged(g, "shadows", {}, {"shadow"}, log);
+    addLogged(g, "gbuffer", {"depth"}, {"gbuffer"}, log);
+    addLogged(g, "prepass", {}, {"depth"}, log);
+    g.compile();
+    g.execute(0, {});
+
+    REQUIRE(log.size() == 5);
+    REQUIRE(position(log, "prepass") < position(log, "gbuffer"));
+    REQUIRE(position(log, "gbuffer") < position(log, "lighting"));
+    REQUIRE(position(log, "shadows") < position(log, "lighting"));
+    REQUIRE(position(log, "lighting") < position(log, "tonemap"));
+    REQUIRE(position(log, "shadows") < position(log, "prepass")); // independent: declaration order breaks the tie
+}
+
+TEST_CASE("RenderGraph versions resources with several writers", "[rendergraph]") {
+    NullDevice device;
+    gfx::RenderGraph g;
+    g.addTexture("color", {64, 64});
+    g.addTexture("history", {64, 64});
+
+    std::vector<std::string> log;
+    addLogged(g, "clear", {}, {"color"}, log);
+    addLogged(g, "opaque", {"color"}, {"color"}, log);      // read-modify-write
+    addLogged(g, "copyHistory", {"color"}, {"history"}, log); // must read before "ui" overwrites
+    addLogged(g, "ui", {"color"}, {"color"}, log);
+    g.compile();
+    g.execute(0, {});
+    REQUIRE(log == std::vector<std::string>{"clear", "opaque", "copyHistory", "ui"});
+
+    auto hasEdge = [&](int from, int to, gfx::Hazard h) {
+        const auto e = g.edges();
+        return std::any_of(e.begin(), e.end(), [&](const gfx::GraphEdge& x) {
+            return x.from == from && x.to == to && x.hazard == h;
+        });
+    };
+    REQUIRE(hasEdge(0, 1, gfx::Hazard::WriteAfterWrite));
+    REQUIRE(hasEdge(1, 2, gfx::Hazard::ReadAfterWrite));
+    REQUIRE(hasEdge(2, 3, gfx::Hazard::WriteAfterRead));
+}
+
+TEST_CASE("RenderGraph reports dependency cycles and unknown resources", "[rendergraph]") {
+    NullDevice device;
+    std::vector<std::string> log;
+    {
+        gfx::RenderGraph g;
+        g.addTexture("a", {8, 8});
+        g.addTexture("b", {8, 8});
+        addLogged(g, "first", {"b"}, {"a"}, log);
+        addLogged(g, "second", {"a"}, {"b"}, log);
+        addLogged(g, "unrelated", {}, {}, log);
+        std::string what;
+        try {
+            g.compile();
+        } catch (const std::runtime_error& e) {
+            what = e.what();
+        }
+        REQUIRE(what.find("cycle") != std::string::npos);
+        REQUIRE(what.find("first -[a]-> second") != std::string::npos);
+        REQUIRE(what.find("second -[b]-> first") != std::string::npos);
+        REQUIRE(what.find("unrelated") == std::string::npos);
+    }
+    {
+        gfx::RenderGraph g;
+        REQUIRE_THROWS_AS(addLogged(g, "orphan", {"missing"}, {}, log), std::runtime_error);
+        g.addPass("stale", gfx::PassType::Graphics, {{gfx::ResourceId{7}}}, {}, {}); // id from another graph
+        REQUIRE_THROWS_AS(g.compile(), std::runtime_error);
+    }
+}
+
+TEST_CASE("RenderGraph culls passes that don't reach an output", "[rendergraph]") {
+    NullDevice device;
+    std::vector<std::string> log;
+    auto build = [&](gfx::RenderGraph& g) {
+        for (const char* r : {"depth", "hdr", "color", "debugView", "ssao", "readback"})
+            g.addTexture(r, {64, 64});
+        addLogged(g, "prepass", {}, {"depth"}, log);
+        addLogged(g, "ssao", {"depth"}, {"ssao"}, log); // feeds only the debug view
+        addLogged(g, "lighting", {"depth"}, {"hdr"}, log);
+        addLogged(g, "debug", {"ssao", "hdr"}, {"debugView"}, log); // output never consumed
+        addLogged(g, "tonemap", {"hdr"}, {"color"}, log);
+        addLogged(g, "overlay", {"color"}, {"color"}, log);
+    };
+    {
+        gfx::RenderGraph g; // no outputs marked: everything runs
+        build(g);
+        g.compile();
+        g.execute(0, {});
+        REQUIRE(log.size() == 6);
+    }
+    {
+        log.clear();
+        gfx::RenderGraph g;
+        build(g);
+        g.markOutput("color");
+        g.compile();
+        g.execute(0, {});
+        REQUIRE(log == std::vector<std::string>{"prepass", "lighting", "tonemap", "overlay"});
+        REQUIRE(g.isCulled(gfx::PassId{1}));
+        REQUIRE(g.isCulled(gfx::PassId{3}));
+        REQUIRE_FALSE(g.isResourceUsed(g.findResource("debugView")));
+        REQUIRE_FALSE(g.isResourceUsed(g.findResource("ssao")));
+        REQUIRE(g.isResourceUsed(g.findResource("depth")));
+    }
+    {
+        log.clear();
+        gfx::RenderGraph g; // a side-effect pass keeps itself and its inputs alive
+        build(g);
+        const gfx::PassId capture = g.addPass("capture", gfx::PassType::Copy, Names{"ssao"}, Names{"readback"},
+                                              [&log](const auto&) { log.push_back("capture"); });
+        g.pass(capture).sideEffects = true;
+        g.markOutput("color");
+        g.compile();
+        g.execute(0, {});
+        REQUIRE(std::find(log.begin(), log.end(), "ssao") != log.end());
+        REQUIRE(log.back() == "capture");
+        REQUIRE(g.isCulled(gfx::PassId{3}));
+    }
+    {
+        gfx::RenderGraph g;
+        build(g);
+        REQUIRE_THROWS_AS(g.markOutput("swapchain"), std::runtime_error);
+    }
+}
+
+TEST_CASE("RenderGraph batches the barriers each pass needs", "[rendergraph]") {
+    using gfx::ResourceUsage;
+    NullDevice device;
+    gfx::RenderGraph g;
+    const gfx::ResourceId backbuffer = g.importTexture("backbuffer", {64, 64}, gfx::BackbufferTexture,
+                                                       ResourceUsage::Undefined, ResourceUsage::Present);
+    const gfx::ResourceId shadow = g.addTexture("shadow", {64, 64, 1, 1, gfx::TextureDesc::Format::Depth24});
+    const gfx::ResourceId hdr = g.addTexture("hdr", {64, 64});
+    const auto noop = [](const auto&) {};
+    g.addPass("shadows", gfx::PassType::Graphics, {}, {{shadow}}, noop); // default → depth attachment
+    g.addPass("lighting", gfx::PassType::Graphics, {{shadow, ResourceUsage::Sampled}},
+              {{hdr, ResourceUsage::ColorAttachment}}, noop);
+    g.addPass("tonemap", gfx::PassType::Graphics, Names{"hdr"}, Names{"backbuffer"}, noop);
+    g.addPass("debug", gfx::PassType::Graphics,
+              {{shadow, ResourceUsage::Sampled}, {backbuffer, ResourceUsage::ColorAttachment}},
+              {{backbuffer, ResourceUsage::ColorAttachment}}, noop);
+    g.markOutput(backbuffer);
+    g.compile();
+    g.execute(0, {});
+    REQUIRE(g.executionOrder().size() == 4);
+
+    auto has = [&](std::size_t slot, ResourceUsage before, ResourceUsage after) {
+        const auto b = g.barriersAt(slot);
+        return std::any_of(b.begin(), b.end(), [&](const gfx::ResourceBarrier& x) {
+            return x.before == before && x.after == after;
+        });
+    };
+    REQUIRE(g.barriersAt(0).size() == 1);
+    REQUIRE(g.barriersAt(0)[0].depth);
+    REQUIRE(has(0, ResourceUsage::Undefined, ResourceUsage::DepthAttachment));
+    REQUIRE(g.barriersAt(1).size() == 2);
+    REQUIRE(has(1, ResourceUsage::DepthAttachment, ResourceUsage::Sampled));
+    REQUIRE(has(1, ResourceUsage::Undefined, ResourceUsage::ColorAttachment));
+    REQUIRE(g.barriersAt(2).size() == 2);
+    REQUIRE(has(2, ResourceUsage::ColorAttachment, ResourceUsage::Sampled));
+    REQUIRE(has(2, ResourceUsage::Undefined, ResourceUsage::ColorAttachment));
+    /* shadow stays Sampled, and the write-after-write on the backbuffer is
+       covered by debug drawing into tonemap's render pass */
+    REQUIRE(g.barriersAt(3).empty());
+    REQUIRE(g.renderPassGroupOf(3) == g.renderPassGroupOf(2));
+    REQUIRE(g.barriersAt(4).size() == 1);
+    REQUIRE(has(4, ResourceUsage::ColorAttachment, ResourceUsage::Present));
+    REQUIRE(std::get<gfx::TextureHandle>(g.barriersAt(4)[0].handle).id == gfx::BackbufferTexture.id);
+
+    gfx::RenderGraph bad;
+    const gfx::ResourceId feedback = bad.addTexture("hdr", {64, 64});
+    bad.addPass("feedback", gfx::PassType::Graphics, {{feedback, ResourceUsage::Sampled}},
+                {{feedback, ResourceUsage::ColorAttachment}}, noop);
+    REQUIRE_THROWS_AS(bad.compile(), std::runtime_error);
+}
+
+TEST_CASE("RenderGraph aliases transients whose lifetimes don't overlap", "[rendergraph]") {
+    using gfx::ResourceUsage;
+    NullDevice device;
+    auto build = [](gfx::RenderGraph& g) {
+        /* post chain: each target lives for two passes, so every other one can share memory */
+        for (const char* r : {"scene", "bloom", "blur", "graded"})
+            g.addTexture(r, {256, 256});
+        g.addTexture("final", {256, 256});
+        const auto noop = [](const auto&) {};
+        g.addPass("scene", gfx::PassType::Graphics, Names{}, Names{"scene"}, noop);
+        g.addPass("bloom", gfx::PassType::Graphics, Names{"scene"}, Names{"bloom"}, noop);
+        g.addPass("blur", gfx::PassType::Graphics, Names{"bloom"}, Names{"blur"}, noop);
+        g.addPass("grade", gfx::PassType::Graphics, Names{"blur"}, Names{"graded"}, noop);
+        g.addPass("final", gfx::PassType::Graphics, Names{"graded"}, Names{"final"}, noop);
+        g.markOutput("final");
+    };
+    const uint64_t size = 256 * 256 * 4;
+
+    gfx::RenderGraph g;
+    build(g);
+    g.compile();
+    const gfx::TransientMemoryStats& mem = g.transientMemory();
+    REQUIRE(mem.requestedBytes == 5 * size);
+    REQUIRE(mem.heapCount == 1);
+    REQUIRE(mem.heapBytes == 2 * size);
+    REQUIRE(mem.savedBytes() == 3 * size);
+
+    /* neighbours in the chain are alive together and must not overlap */
+    for (int r = 0; r + 1 < 5; ++r) {
+        const gfx::TransientPlacement& a = g.placement({r});
+        const gfx::TransientPlacement& b = g.placement({r + 1});
+        REQUIRE(a.lastSlot >= b.firstSlot);
+        REQUIRE((a.offset + a.size <= b.offset || b.offset + b.size <= a.offset));
+    }
+    REQUIRE(g.placement(g.findResource("scene")).offset == g.placement(g.findResource("blur")).offset);
+
+    /* "blur" moves into the memory "scene" was sampled from: its first barrier waits for that */
+    const auto first = g.barriersAt(static_cast<std::size_t>(g.placement(g.findResource("blur")).firstSlot));
+    REQUIRE(std::any_of(first.begin(), first.end(), [](const gfx::ResourceBarrier& b) {
+        return b.before == ResourceUsage::Undefined && b.previousAlias == ResourceUsage::Sampled;
+    }));
+
+    gfx::RenderGraph unaliased;
+    build(unaliased);
+    unaliased.setAliasingEnabled(false);
+    unaliased.compile();
+    REQUIRE(unaliased.transientMemory().heapBytes == 5 * size);
+    REQUIRE(unaliased.transientMemory().savedBytes() == 0);
+}
+
+TEST_CASE("RenderGraph passes look resources up by id", "[rendergraph]") {
+    NullDevice device;
+    gfx::RenderGraph g;
+    const gfx::ResourceId target = g.importTexture("target", {64, 64}, gfx::TextureHandle{42},
+                                                   gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Undefined);
+    uint32_t seen = 0;
+    const gfx::PassId pass = g.addPass("draw", gfx::PassType::Graphics, {}, {{target}},
+                                       [&seen, target](const gfx::RenderPass::ExecCtx& ctx) {
+                                           seen = ctx.graph->texture(target).id;
+                                       });
+    g.markOutput(target);
+    g.compile();
+    g.execute(0, {});
+
+    REQUIRE(seen == 42);
+    REQUIRE(g.findResource("target") == target);
+    REQUIRE_FALSE(g.findResource("nothing").valid());
+    REQUIRE(g.pass(pass).name == "draw");
+    REQUIRE(g.resource(target).name == "target");
+}
+
+TEST_CASE("RenderGraph reuses its compiled result for unchanged declarations", "[rendergraph]") {
+    using gfx::CompileScope;
+    NullDevice device;
+    gfx::RenderGraph g;
+    std::vector<std::string> log;
+    auto declare = [&](uint32_t size, uint32_t backbuffer, bool withUi) {
+        g.reset();
+        const gfx::ResourceId out = g.importTexture("backbuffer", {size, size}, gfx::TextureHandle{backbuffer},
+                                                    gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Present);
+        g.addTexture("hdr", {size, size});
+        addLogged(g, "scene", {}, {"hdr"}, log);
+        addLogged(g, "tonemap", {"hdr"}, {"backbuffer"}, log);
+        if (withUi)
+            addLogged(g, "ui", {"backbuffer"}, {"backbuffer"}, log);
+        g.markOutput(out);
+        g.compile();
+    };
+
+    declare(64, 100, false);
+    REQUIRE(g.lastCompileScope() == CompileScope::Full);
+    const std::size_t barriers = g.barriersAt(1).size();
+
+    declare(64, 100, false);
+    REQUIRE(g.lastCompileScope() == CompileScope::Reused);
+    REQUIRE(g.barriersAt(1).size() == barriers);
+
+    declare(64, 101, false); // next swapchain image
+    REQUIRE(g.lastCompileScope() == CompileScope::Barriers);
+    REQUIRE(std::get<gfx::TextureHandle>(g.barriersAt(g.executionOrder().size())[0].handle).id == 101);
+
+    const auto* null = static_cast<const gfx::NullBackend*>(gfx::RenderDevice::backend());
+    g.execute(7, {});
+    REQUIRE(null->liveHeaps() == 1);
+    declare(128, 101, false); // resize
+    REQUIRE(g.lastCompileScope() == CompileScope::Memory);
+    REQUIRE(g.transientMemory().requestedBytes == 128 * 128 * 4);
+
+    /* frame 7 may still be on the GPU until frame 9 (two in flight) records */
+    REQUIRE(null->liveHeaps() == 2);
+    g.execute(8, {});
+    REQUIRE(null->liveHeaps() == 2);
+    g.execute(9, {});
+    REQUIRE(null->liveHeaps() == 1);
+
+    declare(128, 101, true); // a pass more
+    REQUIRE(g.lastCompileScope() == CompileScope::Full);
+    REQUIRE(g.executionOrder().size() == 3);
+
+    /* the callbacks run are always the ones from the latest declaration */
+    log.clear();
+    declare(128, 101, true);
+    REQUIRE(g.lastCompileScope() == CompileScope::Reused);
+    log.clear();
+    g.execute(10, {});
+    REQUIRE(log == std::vector<std::string>{"scene", "tonemap", "ui"});
+
+    g.releaseMemory();
+    REQUIRE(null->liveHeaps() == 0);
+}
+
+TEST_CASE("RenderGraph records passes and chunks in parallel", "[rendergraph]") {
+    NullDevice dev;
+    core::jobs::JobSystem::start(3);
+
+    gfx::RenderGraph g;
+    g.setParallelRecording(true);
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1},
+                                                gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Present);
+    std::atomic<int> shadows{0}, chunks{0}, prologues{0};
+    std::atomic<bool> ordered{true};
+    for (int i = 0; i < 6; ++i) {
+        const std::string name = "shadow" + std::to_string(i);
+        g.addTexture(name, {16, 16});
+        g.addPass(name, gfx::PassType::Graphics, Names{}, Names{name},
+                  [&](const gfx::RenderPass::ExecCtx&) { ++shadows; });
+    }
+    Names inputs;
+    for (int i = 0; i < 6; ++i)
+        inputs.push_back("shadow" + std::to_string(i));
+    /* the prologue sees every shadow pass recorded; chunks continue its render pass when parallel */
+    const gfx::PassId lit = g.addPass("lit", gfx::PassType::Graphics, inputs, Names{"backbuffer"},
+                                      [&](const gfx::RenderPass::ExecCtx& ctx) {
+                                          const bool parallel = core::jobs::JobSystem::running();
+                                          ordered = ordered && ctx.secondaryContents == parallel && shadows == 6;
+                                          ++prologues;
+                                      });
+    gfx::RenderPass& rp = g.pass(lit);
+    rp.chunkCount = 16;
+    std::vector<std::atomic<int>> perChunk(rp.chunkCount);
+    rp.onChunk = [&](const gfx::RenderPass::ExecCtx&, uint32_t chunk) {
+        ordered = ordered && prologues == 1;
+        ++perChunk[chunk];
+        ++chunks;
+    };
+    rp.onFinish = [&](const gfx::RenderPass::ExecCtx&) { ordered = ordered && chunks == 16; };
+    g.markOutput(out);
+    g.compile();
+
+    g.execute(0, {});
+    REQUIRE(shadows == 6);
+    REQUIRE(chunks == 16);
+    REQUIRE(ordered);
+    REQUIRE(std::all_of(perChunk.begin(), perChunk.end(), [](const std::atomic<int>& n) { return n == 1; }));
+
+    /* serial fallback runs the same callbacks */
+    core::jobs::JobSystem::stop();
+    shadows = chunks = prologues = 0;
+    for (auto& n : perChunk)
+        n = 0;
+    g.execute(1, {});
+    REQUIRE(shadows == 6);
+    REQUIRE(chunks == 16);
+    REQUIRE(ordered);
+}
+
+TEST_CASE("RenderGraph records graphics passes on the primary", "[rendergraph]") {
+    NullDevice dev;
+    core::jobs::JobSystem::start(2);
+
+    gfx::RenderGraph g;
+    g.setParallelRecording(true);
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1},
+                                                gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Present);
+    g.addTexture("noise", {16, 16});
+    char primary = 0;
+    gfx::CmdHandle computeCmd{}, graphicsCmd{};
+    g.addPass("noise", gfx::PassType::Compute, Names{}, Names{"noise"},
+              [&](const gfx::RenderPass::ExecCtx& ctx) { computeCmd = ctx.cmd; });
+    g.addPass("draw", gfx::PassType::Graphics, Names{"noise"}, Names{"backbuffer"},
+              [&](const gfx::RenderPass::ExecCtx& ctx) { graphicsCmd = ctx.cmd; });
+    g.markOutput(out);
+    g.compile();
+    g.execute(0, {&primary});
+    core::jobs::JobSystem::stop();
+
+    /* the compute pass goes to a worker secondary, the one beginning a render pass doesn't */
+    REQUIRE(computeCmd.ptr != nullptr);
+    REQUIRE(computeCmd.ptr != &primary);
+    REQUIRE(graphicsCmd.ptr == &primary);
+}
+
+TEST_CASE("RenderGraph schedules compute passes on the async queue", "[rendergraph]") {
+    using gfx::QueueType;
+    using gfx::QueueTransfer;
+    NullDevice dev;
+    gfx::RenderGraph g;
+    g.setAsyncCompute(true);
+    std::vector<std::string> log;
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1},
+                                                gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Present);
+    const gfx::ResourceId depth = g.addTexture("depth", {64, 64, 1, 1, gfx::TextureDesc::Format::Depth24});
+    g.addTexture("ao", {64, 64});
+    const gfx::ResourceId shadow = g.addTexture("shadow", {64, 64, 1, 1, gfx::TextureDesc::Format::Depth24});
+    addLogged(g, "prepass", {}, {"depth"}, log);
+    g.addPass("ao", gfx::PassType::Compute, Names{"depth"}, Names{"ao"},
+              [&log](const auto&) { log.push_back("ao"); });
+    addLogged(g, "shadows", {}, {"shadow"}, log);
+    addLogged(g, "lighting", {"ao", "shadow"}, {"backbuffer"}, log);
+    g.markOutput(out);
+    g.compile();
+
+    /* prepass | ao (waits prepass) | shadows overlaps ao | lighting waits ao */
+    REQUIRE(g.queueOf(1) == QueueType::AsyncCompute);
+    const auto batches = g.queueBatches();
+    REQUIRE(batches.size() == 4);
+    REQUIRE(batches[0].queue == QueueType::Graphics);
+    REQUIRE(batches[0].signals);
+    REQUIRE(batches[1].queue == QueueType::AsyncCompute);
+    REQUIRE(batches[1].wait == 0);
+    REQUIRE(batches[1].signals);
+    REQUIRE(batches[2].slots == std::vector<std::size_t>{2});
+    REQUIRE(batches[2].wait == -1);
+    REQUIRE(batches[3].wait == 1);
+    REQUIRE(batches[3].queue == QueueType::Graphics);
+
+    /* depth changes hands: released after the prepass, acquired before ao */
+    REQUIRE(g.releasesAt(0).size() == 1);
+    REQUIRE(g.releasesAt(0)[0].transfer == QueueTransfer::Release);
+    REQUIRE(g.releasesAt(0)[0].dstQueue == QueueType::AsyncCompute);
+    const auto acquire = g.barriersAt(1);
+    REQUIRE(std::any_of(acquire.begin(), acquire.end(), [](const gfx::ResourceBarrier& b) {
+        return b.transfer == QueueTransfer::Acquire && b.srcQueue == QueueType::Graphics;
+    }));
+    REQUIRE(g.releasesAt(1).size() == 1); // ao, back to graphics
+
+    /* depth's slot range ends before shadow's, but the async queue makes it overlap */
+    REQUIRE((g.placement(depth).heap != g.placement(shadow).heap ||
+             g.placement(depth).offset != g.placement(shadow).offset));
+
+    g.execute(0, {});
+    REQUIRE(log == std::vector<std::string>{"prepass", "ao", "shadows", "lighting"});
+
+    /* off: one graphics batch, no ownership transfers */
+    g.setAsyncCompute(false);
+    g.compile();
+    REQUIRE(g.lastCompileScope() == gfx::CompileScope::Full);
+    REQUIRE(g.queueBatches().size() == 1);
+    REQUIRE(g.releasesAt(0).empty());
+}
+
+TEST_CASE("RenderGraph keeps compute passes that read imported contents on graphics", "[rendergraph]") {
+    NullDevice dev;
+    gfx::RenderGraph g;
+    g.setAsyncCompute(true);
+    g.importTexture("history", {64, 64}, gfx::TextureHandle{5}, gfx::ResourceUsage::Sampled,
+                    gfx::ResourceUsage::Sampled);
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1},
+                                                gfx::ResourceUsage::Undefined, gfx::ResourceUsage::Present);
+    g.addTexture("resolved", {64, 64});
+    g.addPass("taa", gfx::PassType::Compute, Names{"history"}, Names{"resolved"}, {});
+    g.addPass("blur", gfx::PassType::Compute, Names{"resolved"}, Names{"backbuffer"}, {});
+    g.markOutput(out);
+    g.compile();
+
+    REQUIRE(g.queueOf(0) == gfx::QueueType::Graphics);
+    REQUIRE(g.queueOf(1) == gfx::QueueType::AsyncCompute);
+    /* the backbuffer is presented from graphics: a final graphics batch waits for blur's */
+    REQUIRE(g.queueBatches().back().queue == gfx::QueueType::Graphics);
+    REQUIRE(g.queueBatches().back().wait == 1);
+    REQUIRE(g.barriersAt(g.executionOrder().size())[0].transfer == gfx::QueueTransfer::Acquire);
+}
+
+TEST_CASE("RenderGraph merges passes drawing to the same attachments", "[rendergraph]") {
+    using gfx::LoadOp;
+    using gfx::ResourceUsage;
+    using gfx::StoreOp;
+    NullDevice device;
+    gfx::RenderGraph g;
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1}, ResourceUsage::Undefined,
+                                                ResourceUsage::Present);
+    const gfx::ResourceId hdr = g.addTexture("hdr", {64, 64});
+    const gfx::ResourceId depth = g.addTexture("depth", {64, 64, 1, 1, gfx::TextureDesc::Format::Depth24});
+    std::vector<std::string> log;
+    auto logged = [&log](std::string name) {
+        return [&log, name](const gfx::RenderPass::ExecCtx& ctx) {
+            log.push_back(name + (ctx.continuesRenderPass ? " continues" : "") +
+                          (ctx.keepsRenderPassOpen ? " keeps" : ""));
+        };
+    };
+    const gfx::PassId opaque =
+        g.addPass("opaque", gfx::PassType::Graphics, {},
+                  {{hdr, ResourceUsage::ColorAttachment}, {depth, ResourceUsage::DepthAttachment}}, logged("opaque"));
+    g.pass(opaque).clearsAttachments = true;
+    g.addPass("transparent", gfx::PassType::Graphics, {{depth, ResourceUsage::DepthAttachment}},
+              {{hdr, ResourceUsage::ColorAttachment}}, logged("transparent"));
+    g.addPass("tonemap", gfx::PassType::Graphics, {{hdr, ResourceUsage::Sampled}},
+              {{out, ResourceUsage::ColorAttachment}}, logged("tonemap"));
+    g.markOutput(out);
+    g.compile();
+
+    /* opaque + transparent share a render pass: no attachment barriers between them */
+    const auto groups = g.renderPassGroups();
+    REQUIRE(groups.size() == 2);
+    REQUIRE(groups[0].firstSlot == 0);
+    REQUIRE(groups[0].lastSlot == 1);
+    REQUIRE(groups[0].color == hdr);
+    REQUIRE(groups[0].depth == depth);
+    REQUIRE(g.renderPassGroupOf(1) == 0);
+    REQUIRE(g.barriersAt(1).empty());
+
+    /* cleared, hdr kept for tonemap, depth dropped; the backbuffer's old contents don't matter */
+    REQUIRE(groups[0].ops.color.load == LoadOp::Clear);
+    REQUIRE(groups[0].ops.color.store == StoreOp::Store);
+    REQUIRE(groups[0].ops.depth.load == LoadOp::Clear);
+    REQUIRE(groups[0].ops.depth.store == StoreOp::DontCare);
+    REQUIRE(groups[1].color == out);
+    REQUIRE(!groups[1].depth.valid());
+    REQUIRE(groups[1].ops.color.load == LoadOp::DontCare);
+    REQUIRE(groups[1].ops.color.store == StoreOp::Store);
+
+    g.execute(0, {});
+    REQUIRE(log == std::vector<std::string>{"opaque keeps", "transparent continues", "tonemap"});
+
+    /* without the clear, the transient's first contents are undefined */
+    g.pass(opaque).clearsAttachments = false;
+    g.compile();
+    REQUIRE(g.lastCompileScope() == gfx::CompileScope::Full);
+    REQUIRE(g.renderPassGroups()[0].ops.color.load == LoadOp::DontCare);
+    REQUIRE(g.renderPassGroups()[0].lastSlot == 1);
+}
+
+TEST_CASE("RenderGraph exports the compiled graph with pass costs", "[rendergraph]") {
+    using gfx::ResourceUsage;
+    NullDevice device;
+    gfx::RenderGraph g;
+    REQUIRE_THROWS_AS(g.exportJson(), std::runtime_error);
+
+    const gfx::ResourceId out = g.importTexture("backbuffer", {64, 64}, gfx::TextureHandle{1}, ResourceUsage::Undefined,
+                                                ResourceUsage::Present);
+    g.addTexture("hdr", {64, 64});
+    g.addTexture("bloom", {64, 64});
+    g.addTexture("unused \"debug\"", {64, 64});
+    const auto noop = [](const auto&) {};
+    g.addPass("lighting", gfx::PassType::Graphics, Names{}, Names{"hdr"}, noop);
+    g.addPass("bloom", gfx::PassType::Graphics, Names{"hdr"}, Names{"bloom"}, noop);
+    g.addPass("tonemap", gfx::PassType::Graphics, Names{"hdr", "bloom"}, Names{"backbuffer"}, noop);
+    const gfx::PassId debug = g.addPass("debug", gfx::PassType::Graphics, Names{}, Names{"unused \"debug\""}, noop);
+    g.markOutput(out);
+    g.compile();
+    g.execute(0, {});
+
+    /* recording was timed; the null backend has no GPU clock */
+    REQUIRE(g.passCost(gfx::PassId{0}).cpuSeconds >= 0.0);
+    REQUIRE(g.passCost(gfx::PassId{0}).gpuSeconds < 0.0);
+    REQUIRE(g.passCost(debug).cpuSeconds == 0.0);
+
+    const std::string json = g.exportJson();
+    for (const char* key : {"\"passes\"", "\"resources\"", "\"edges\"", "\"barriers\"", "\"batches\"",
+                            "\"renderPasses\"", "\"memory\"", "\"cpuMs\"", "\"gpuMs\": null"})
+        REQUIRE(json.find(key) != std::string::npos);
+    REQUIRE(json.find("\"name\": \"debug\", \"type\": \"Graphics\", \"culled\": true, \"slot\": -1") !=
+            std::string::npos);
+    REQUIRE(json.find("unused \\\"debug\\\"") != std::string::npos);
+    REQUIRE(json.find("\"hazard\": \"ReadAfterWrite\"") != std::string::npos);
+    REQUIRE(json.find("\"before\": \"ColorAttachment\", \"after\": \"Sampled\"") != std::string::npos);
+    REQUIRE(json.find("\"heap\": 0, \"offset\": ") != std::string::npos); // transients carry their placement
+
+    const std::string dot = g.exportDot();
+    REQUIRE(dot.rfind("digraph RenderGraph {", 0) == 0);
+    REQUIRE(dot.find("subgraph cluster_rp0") != std::string::npos);
+    REQUIRE(dot.find("debug\\nGraphics · culled") != std::string::npos);
+    REQUIRE(dot.find("r0 -> p2") == std::string::npos); // tonemap writes the backbuffer, it doesn't read it
+    REQUIRE(dot.find("p2 -> r0") != std::string::npos);
+    REQUIRE(dot.back() == '\n');
+}
@@ -0,0 +1,109 @@
+#include "graphics/resources/BlockCompression.h"
+#include "graphics/resources/CookedTexture.h"
+#include "graphics/resources/MipGenerator.h"
+#include "core/jobs/JobSystem.h"
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+/* mostly-diagonal gradient (what BC1's single line can represent) with a hard alpha edge */
+std::vector<std::uint8_t> testImage(std::uint32_t w, std::uint32_t h) {
+    std::vector<std::uint8_t> img(static_cast<std::size_t>(w) * h * 4);
+    for (std::uint32_t y = 0; y < h; ++y) {
+        for (std::uint32_t x = 0; x < w; ++x) {
+            std::uint8_t* p = &img[(y * w + x) * 4];
+            p[0] = static_cast<std::uint8_t>((x * 200 + y * 40) / (w + h - 2));
+            p[1] = static_cast<std::uint8_t>((x * 120 + y * 30) / (w + h - 2));
+            p[2] = 64;
+            p[3] = x < w / 2 ? 255 : 32;
+        }
+    }
+    return img;
+}
+
+} // namespace
+
+TEST_CASE("BC1/BC3 blocks decode close to the source", "[resources]") {
+    using namespace gfx;
+    const auto img = testImage(4, 4);
+
+    std::byte bc1[8], bc3[16];
+    std::uint8_t back[64];
+    bc::encodeBC1(img.data(), bc1);
+    bc::decodeBC1(bc1, back);
+    for (int i = 0; i < 16; ++i)
+        for (int k = 0; k < 3; ++k)
+            REQUIRE(std::abs(back[i * 4 + k] - img[i * 4 + k]) <= 16);
+
+    bc::encodeBC3(img.data(), bc3);
+    bc::decodeBC3(bc3, back);
+    for (int i = 0; i < 16; ++i)
+        REQUIRE(back[i * 4 + 3] == img[i * 4 + 3]); // two distinct alphas are endpoints: exact
+
+    /* flat block: exact colour, no stray indices */
+    std::vector<std::uint8_t> flat(64, 200);
+    bc::encodeBC1(flat.data(), bc1);
+    bc::decodeBC1(bc1, back);
+    REQUIRE(std::abs(back[0] - 200) <= 4);
+    REQUIRE(back[63] == 255);
+}
+
+TEST_CASE("Cooked texture container round-trips", "[resources]") {
+    using namespace gfx;
+    const std::uint32_t w = 10, h = 6; // non-multiple of 4 → partial edge blocks
+    std::vector<std::vector<std::byte>> mips;
+    for (std::uint32_t lw = w, lh = h;; lw = std::max(lw / 2, 1u), lh = std::max(lh / 2, 1u)) {
+        const auto img = testImage(std::max(lw, 2u), std::max(lh, 2u));
+        mips.push_back(bc::compressImage(TexelFormat::BC3_sRGB, img.data(), lw, lh));
+        if (lw == 1 && lh == 1)
+            break;
+    }
+    REQUIRE(mips.size() == 4);
+    REQUIRE(mips[0].size() == 3 * 2 * 16);
+
+    const auto blob = buildCookedTexture(TexelFormat::BC3_sRGB, w, h, mips);
+    REQUIRE(isCookedTexture(blob));
+    const auto view = parseCookedTexture(blob);
+    REQUIRE(view.header->mipCount == 4);
+    REQUIRE(view.mips[3].width == 1);
+    REQUIRE(view.mips[3].size == 16);
+    for (const auto& m : view.mips)
+        REQUIRE(m.offset % CookedTextureHeader::kPayloadAlign == 0);
+
+    auto broken = blob;
+    broken.resize(blob.size() - 1);
+    REQUIRE_THROWS(parseCookedTexture(broken));
+}
+
+TEST_CASE("Mip generation is sRGB-correct and job-count independent", "[resources]") {
+    using namespace gfx;
+    REQUIRE(mipLevelCount(256, 64) == 9);
+    REQUIRE(mipLevelCount(1, 1) == 1);
+
+    /* black/white checker: box-averaged in linear light → 50 % linear ≈ sRGB 188, not 128 */
+    std::vector<std::uint8_t> checker(4 * 4 * 4);
+    for (int i = 0; i < 16; ++i) {
+        const std::uint8_t v = ((i % 4) + (i / 4)) % 2 ? 255 : 0;
+        checker[i * 4 + 0] = checker[i * 4 + 1] = checker[i * 4 + 2] = v;
+        checker[i * 4 + 3] = 255;
+    }
+    const MipChain box = generateMips(checker.data(), 4, 4, {MipFilter::Box, true, 0});
+    REQUIRE(box.levels.size() == 3);
+    REQUIRE(box.levels[2].offset + box.levels[2].size == box.rgba.size());
+    const std::uint8_t mid = box.rgba[box.levels[1].offset];
+    REQUIRE(mid >= 186);
+    REQUIRE(mid <= 190);
+    REQUIRE(box.rgba[box.levels[1].offset + 3] == 255);
+
+    /* Kaiser on a 300×200 image, inline vs. spread across workers */
+    const auto img = testImage(300, 200);
+    const MipChain inlineChain = generateMips(img.data(), 300, 200);
+    core::jobs::JobSystem::start(3);
+    const MipChain parallelChain = generateMips(img.data(), 300, 200);
+    core::jobs::JobSystem::stop();
+    REQUIRE(inlineChain.levels.size() == 9);
+    REQUIRE(inlineChain.levels.back().width == 1);
+    REQUIRE(inlineChain.rgba == parallelChain.rgba);
+}
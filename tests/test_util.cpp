@@ -1,6 +1,14 @@
+#include "core/util/AsyncIO.h"
 #include "core/util/FileSystem.h"
+#include "core/util/FileWatcher.h"
+#include "core/util/FrameStats.h"
 #include "core/util/Time.h"
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <fstream>
+#include <thread>
+
+using Catch::Approx;
 
 TEST_CASE("Time tick", "[util]") {
     using core::util::Time;
@@ -9,7 +17,147 @@ TEST_CASE("Time tick", "[util]") {
     REQUIRE(Time::delta() >= 0.0); // should be small but non-negative
 }
 
+TEST_CASE("Tsc is calibrated against steady_clock", "[util]") {
+    using core::util::Tsc;
+    Tsc::calibrate(std::chrono::milliseconds(5));
+    const auto t0 = Tsc::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const double secs = Tsc::toSeconds(Tsc::now() - t0);
+    REQUIRE(secs >= 0.015);
+    REQUIRE(secs < 0.5);
+}
+
+TEST_CASE("FrameStats percentiles and hitches", "[util]") {
+    core::util::FrameStats stats;
+    for (int i = 0; i < 100; ++i)
+        REQUIRE_FALSE(stats.record(0.016));
+    REQUIRE(stats.record(0.100)); // 6x the median
+
+    const auto s = stats.summary();
+    REQUIRE(s.frames == 101);
+    REQUIRE(s.hitches == 1);
+    REQUIRE(s.p50 == Approx(0.016));
+    REQUIRE(s.p95 == Approx(0.016));
+    REQUIRE(s.max == Approx(0.100));
+    REQUIRE(s.mean == Approx((100 * 0.016 + 0.1) / 101));
+}
+
+TEST_CASE("FrameStats keeps only recent history", "[util]") {
+    core::util::FrameStats stats;
+    for (std::size_t i = 0; i < core::util::FrameStats::kHistory; ++i)
+        stats.record(0.050);
+    for (std::size_t i = 0; i < core::util::FrameStats::kHistory; ++i)
+        stats.record(0.010);
+    const auto s = stats.summary();
+    REQUIRE(s.frames == core::util::FrameStats::kHistory);
+    REQUIRE(s.max == Approx(0.010));
+    REQUIRE(stats.last() == Approx(0.010));
+}
+
 TEST_CASE("FileSystem exists", "[util]") {
     using core::util::FileSystem;
     REQUIRE(FileSystem::exists(std::filesystem::current_path()));
 }
+
+TEST_CASE("MappedFile views the whole file", "[util]") {
+    using core::util::FileSystem;
+    using core::util::MappedFile;
+    const auto path = std::filesystem::temp_directory_path() / "ve_mapped_file_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 10000; ++i)
+            out.put(static_cast<char>(i & 0xFF));
+    }
+
+    {
+        auto file = FileSystem::map(path);
+        REQUIRE(file.isOpen());
+        REQUIRE(file.size() == 10000);
+        REQUIRE(std::to_integer<int>(file.bytes()[0]) == 0);
+        REQUIRE(std::to_integer<int>(file.bytes()[9999]) == (9999 & 0xFF));
+
+        MappedFile moved = std::move(file);
+        REQUIRE(moved.size() == 10000);
+        REQUIRE_FALSE(file.isOpen());
+        REQUIRE(FileSystem::readBinary(path).size() == 10000);
+    }
+
+    { std::ofstream truncate(path, std::ios::binary | std::ios::trunc); }
+    REQUIRE(FileSystem::map(path).bytes().empty());
+    std::filesystem::remove(path);
+    REQUIRE_THROWS(FileSystem::map(path));
+}
+
+TEST_CASE("AsyncIO reads batches on both backends", "[util]") {
+    using core::util::AsyncIO;
+    using core::util::IoResult;
+    const auto dir = std::filesystem::temp_directory_path();
+    std::vector<std::filesystem::path> paths;
+    for (int i = 0; i < 16; ++i) {
+        paths.push_back(dir / ("ve_async_io_" + std::to_string(i) + ".bin"));
+        std::ofstream out(paths.back(), std::ios::binary);
+        for (int j = 0; j < 1000 * i; ++j)
+            out.put(static_cast<char>(i));
+    }
+
+    for (bool allowIoUring : {false, true}) {
+        AsyncIO::init(8, 2, allowIoUring); // depth 8 < 16 requests: exercises the overflow queue
+        std::size_t okCount = 0, errors = 0, chained = 0;
+        for (int i = 0; i < 16; ++i) {
+            AsyncIO::read(paths[i], [&, i](IoResult& r) {
+                REQUIRE(r.ok());
+                REQUIRE(r.size == static_cast<std::size_t>(1000 * i));
+                if (r.size)
+                    REQUIRE(std::to_integer<int>(r.bytes().back()) == i);
+                ++okCount;
+            });
+        }
+        AsyncIO::read(dir / "ve_async_io_missing.bin", [&](IoResult& r) {
+            errors += !r.ok();
+            AsyncIO::read(paths[1], [&](IoResult&) { ++chained; }); // callbacks may issue more reads
+        });
+        REQUIRE(AsyncIO::pending() == 17);
+        AsyncIO::wait();
+        REQUIRE(okCount == 16);
+        REQUIRE(errors == 1);
+        REQUIRE(chained == 1);
+        REQUIRE(AsyncIO::pending() == 0);
+        AsyncIO::shutdown();
+    }
+
+    for (const auto& p : paths)
+        std::filesystem::remove(p);
+}
+
+TEST_CASE("FileWatcher coalesces changes and fires on poll", "[util]") {
+    using core::util::FileWatcher;
+    using namespace std::chrono_literals;
+    const auto dir = std::filesystem::temp_directory_path() / "ve_file_watcher";
+    std::filesystem::create_directories(dir);
+    const auto watched = dir / "shader.vert", other = dir / "other.txt";
+    std::ofstream(watched) << "v1";
+
+    for (bool allowInotify : {false, true}) {
+        FileWatcher watcher(50ms, allowInotify, 10ms);
+        std::vector<std::filesystem::path> fired;
+        watcher.watch(watched, [&](const std::filesystem::path& p) { fired.push_back(p); });
+        std::this_thread::sleep_for(30ms);
+        REQUIRE(watcher.poll() == 0);
+
+        std::ofstream(other) << "ignored";
+        for (int i = 0; i < 3; ++i) { // one save, several writes
+            std::ofstream(watched) << "version " << i + 2;
+            std::this_thread::sleep_for(5ms);
+        }
+        REQUIRE(fired.empty()); // callbacks only run inside poll()
+        for (int i = 0; i < 200 && fired.empty(); ++i) {
+            std::this_thread::sleep_for(10ms);
+            watcher.poll();
+        }
+        REQUIRE(fired.size() == 1);
+        REQUIRE(fired[0].filename() == "shader.vert");
+        std::this_thread::sleep_for(100ms);
+        REQUIRE(watcher.poll() == 0);
+    }
+    std::filesystem::remove_all(dir);
+}
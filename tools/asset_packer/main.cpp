@@ -0,0 +1,96 @@
+/* asset_packer – bundles a directory tree into one .vepk archive
+ *
+ *   asset_packer <out.vepk> <dir> [<dir> …] [--lz4] [--align N]
+ *
+ * Entry names are paths relative to each <dir>, '/'-separated, so
+ * "assets/textures/checker.png" packed from "assets" is looked up as
+ * "textures/checker.png".
+ */
+#include "core/util/Archive.h"
+#include "core/util/FileSystem.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+using core::util::ArchiveWriter;
+using core::util::Compression;
+using core::util::FileSystem;
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: asset_packer <out.vepk> <dir> [<dir> ...] [--lz4] [--align N]\n");
+}
+
+/* Already-compressed formats are stored as-is – LZ4 won't shrink them */
+bool worthCompressing(const fs::path& p) {
+    static constexpr std::string_view kSkip[] = {".png", ".jpg", ".jpeg", ".ktx2", ".vepk"};
+    const std::string ext = p.extension().string();
+    return std::find(std::begin(kSkip), std::end(kSkip), ext) == std::end(kSkip);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    fs::path out;
+    std::vector<fs::path> roots;
+    bool lz4 = false;
+    unsigned long align = 64;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--lz4") {
+            lz4 = true;
+        } else if (arg == "--align" && i + 1 < argc) {
+            align = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg.starts_with("--")) {
+            usage();
+            return 2;
+        } else if (out.empty()) {
+            out = arg;
+        } else {
+            roots.emplace_back(arg);
+        }
+    }
+    if (out.empty() || roots.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        ArchiveWriter writer{static_cast<std::uint32_t>(align)};
+        std::uint64_t rawBytes = 0;
+
+        for (const fs::path& root : roots) {
+            /* sorted so the archive is byte-identical between runs */
+            std::vector<fs::path> files;
+            for (const auto& entry : fs::recursive_directory_iterator(root))
+                if (entry.is_regular_file())
+                    files.push_back(entry.path());
+            std::sort(files.begin(), files.end());
+
+            for (const fs::path& file : files) {
+                const auto mapped = FileSystem::map(file);
+                const std::string name = fs::relative(file, root).generic_string();
+                const Compression c = lz4 && worthCompressing(file) ? Compression::LZ4 : Compression::None;
+                writer.add(name, mapped.bytes(), c);
+                rawBytes += mapped.size();
+            }
+        }
+
+        writer.write(out);
+        std::printf("%s: %zu entries, %llu -> %llu bytes\n", out.string().c_str(), writer.size(),
+                    static_cast<unsigned long long>(rawBytes),
+                    static_cast<unsigned long long>(writer.storedBytes()));
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "asset_packer: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
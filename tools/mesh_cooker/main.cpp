@@ -0,0 +1,147 @@
+/* mesh_cooker – any assimp-readable scene → GPU-ready .vmesh
+ *
+ *   mesh_cooker <in.obj|fbx|gltf|…> <out.vmesh> [--flip-uv] [--no-optimize]
+ *               [--lods N] [--lod-error F]
+ *
+ * The scene is flattened (node transforms baked in), triangulated and
+ * split into one submesh per assimp mesh; submeshes keep their
+ * material index.  Missing normals are generated, missing UVs and
+ * colours default to 0 and white.
+ * Each submesh is then welded and reordered for the post-transform
+ * cache, overdraw and vertex fetch (see MeshOptimizer.h), and gets up
+ * to N LODs (default 4, 1 disables) simplified until the deviation
+ * reaches F × the mesh's bounding radius (default 0.05).  LOD 0 is
+ * split into meshlets for cluster culling (see MeshletBuilder.h).
+ */
+#include "graphics/resources/CookedMesh.h"
+#include "graphics/resources/MeshOptimizer.h"
+#include "graphics/resources/MeshSimplifier.h"
+#include "graphics/resources/MeshletBuilder.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: mesh_cooker <in> <out.vmesh> [--flip-uv] [--no-optimize] [--lods N] "
+                         "[--lod-error F]\n");
+}
+
+gfx::SourceSubmesh convert(const aiMesh& m) {
+    gfx::SourceSubmesh sm;
+    sm.material = m.mMaterialIndex;
+    sm.vertices.resize(m.mNumVertices);
+    for (unsigned i = 0; i < m.mNumVertices; ++i) {
+        gfx::SourceVertex& v = sm.vertices[i];
+        v.position = {m.mVertices[i].x, m.mVertices[i].y, m.mVertices[i].z};
+        if (m.HasNormals())
+            v.normal = {m.mNormals[i].x, m.mNormals[i].y, m.mNormals[i].z};
+        if (m.HasTextureCoords(0))
+            v.uv = {m.mTextureCoords[0][i].x, m.mTextureCoords[0][i].y};
+        if (m.HasVertexColors(0))
+            v.color = {m.mColors[0][i].r, m.mColors[0][i].g, m.mColors[0][i].b, m.mColors[0][i].a};
+    }
+    sm.indices.reserve(std::size_t{m.mNumFaces} * 3);
+    for (unsigned f = 0; f < m.mNumFaces; ++f) {
+        const aiFace& face = m.mFaces[f];
+        if (face.mNumIndices == 3) // points/lines were split off by SortByPType
+            sm.indices.insert(sm.indices.end(), {face.mIndices[0], face.mIndices[1], face.mIndices[2]});
+    }
+    return sm;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string in, out;
+    bool flipUv = false, optimize = true;
+    unsigned long lodLevels = 4;
+    float lodError = 0.05f;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--flip-uv")
+            flipUv = true;
+        else if (arg == "--no-optimize")
+            optimize = false;
+        else if (arg == "--lods" && i + 1 < argc)
+            lodLevels = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--lod-error" && i + 1 < argc)
+            lodError = std::strtof(argv[++i], nullptr);
+        else if (arg.starts_with("--")) {
+            usage();
+            return 2;
+        } else if (in.empty())
+            in = arg;
+        else
+            out = arg;
+    }
+    if (in.empty() || out.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        unsigned flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals |
+                         aiProcess_PreTransformVertices | aiProcess_SortByPType | aiProcess_ValidateDataStructure;
+        if (flipUv)
+            flags |= aiProcess_FlipUVs;
+
+        Assimp::Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+        const aiScene* scene = importer.ReadFile(in, flags);
+        if (!scene || !scene->HasMeshes())
+            throw std::runtime_error("cannot import " + in + ": " + importer.GetErrorString());
+
+        std::vector<gfx::SourceSubmesh> submeshes;
+        for (unsigned i = 0; i < scene->mNumMeshes; ++i) {
+            gfx::SourceSubmesh sm = convert(*scene->mMeshes[i]);
+            if (sm.indices.empty())
+                continue;
+            submeshes.push_back(std::move(sm));
+        }
+
+        /* weld against the quantization the file will actually use */
+        const gfx::MeshBounds bounds = gfx::computeBounds(submeshes);
+        for (std::size_t i = 0; i < submeshes.size(); ++i) {
+            gfx::SourceSubmesh& sm = submeshes[i];
+            if (optimize) {
+                const gfx::MeshOptimizeReport r = gfx::optimizeMesh(sm, bounds);
+                std::printf("  submesh %zu: welded %u, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", i, r.welded,
+                            r.before.acmr, r.after.acmr, r.before.atvr, r.after.atvr);
+            }
+            if (lodLevels > 1) {
+                gfx::generateLods(sm, static_cast<std::uint32_t>(lodLevels), lodError * bounds.radius);
+                for (std::size_t l = 0; l < sm.lods.size(); ++l)
+                    std::printf("    LOD %zu: %zu triangles, error %.4g\n", l + 1, sm.lods[l].indices.size() / 3,
+                                sm.lods[l].error);
+            }
+            gfx::generateMeshlets(sm);
+            std::printf("    %zu meshlets\n", sm.meshlets.size());
+        }
+
+        const auto blob = gfx::buildCookedMesh(submeshes);
+        std::ofstream file(out, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!file)
+            throw std::runtime_error("cannot write " + out);
+
+        const gfx::CookedMeshView view = gfx::parseCookedMesh(blob);
+        std::printf("%s: %zu submeshes, %u vertices, %u triangles, %s indices, %zu bytes\n", out.c_str(),
+                    submeshes.size(), view.header->vertexCount, view.header->indexCount / 3,
+                    view.header->indexType == gfx::IndexType::U16 ? "16-bit" : "32-bit", blob.size());
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "mesh_cooker: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
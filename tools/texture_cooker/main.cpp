@@ -0,0 +1,115 @@
+/* texture_cooker – source image → GPU-ready .vtex (mip chain + BC blocks)
+ *
+ *   texture_cooker <in.png|jpg|tga> <out.vtex> [--format auto|bc1|bc3|rgba8] [--filter kaiser|box]
+ *                  [--linear] [--no-mips]
+ *
+ * auto picks BC3 when any texel is translucent, BC1 otherwise.
+ * Colour textures are treated as sRGB (mips filtered in linear light); pass
+ * --linear for data textures such as normal or roughness maps.
+ */
+#include "graphics/resources/BlockCompression.h"
+#include "graphics/resources/CookedTexture.h"
+#include "graphics/resources/MipGenerator.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using gfx::TexelFormat;
+
+namespace {
+
+void usage() {
+    std::fprintf(stderr, "usage: texture_cooker <in> <out.vtex> [--format auto|bc1|bc3|rgba8] "
+                         "[--filter kaiser|box] [--linear] [--no-mips]\n");
+}
+
+TexelFormat pickFormat(std::string_view name, const std::vector<std::uint8_t>& rgba, bool srgb) {
+    if (name == "auto") {
+        bool translucent = false;
+        for (std::size_t i = 3; i < rgba.size() && !translucent; i += 4)
+            translucent = rgba[i] < 255;
+        name = translucent ? "bc3" : "bc1";
+    }
+    if (name == "bc1")
+        return srgb ? TexelFormat::BC1_sRGB : TexelFormat::BC1;
+    if (name == "bc3")
+        return srgb ? TexelFormat::BC3_sRGB : TexelFormat::BC3;
+    if (name == "rgba8")
+        return srgb ? TexelFormat::RGBA8_sRGB : TexelFormat::RGBA8;
+    throw std::invalid_argument("unknown format: " + std::string{name});
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string in, out, formatName = "auto";
+    gfx::MipOptions mipOptions;
+    bool mips = true;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--format" && i + 1 < argc)
+            formatName = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            mipOptions.filter = std::string_view{argv[++i]} == "box" ? gfx::MipFilter::Box : gfx::MipFilter::Kaiser;
+        else if (arg == "--linear")
+            mipOptions.srgb = false;
+        else if (arg == "--no-mips")
+            mips = false;
+        else if (arg.starts_with("--")) {
+            usage();
+            return 2;
+        } else if (in.empty())
+            in = arg;
+        else
+            out = arg;
+    }
+    if (in.empty() || out.empty()) {
+        usage();
+        return 2;
+    }
+
+    try {
+        int w, h, channels;
+        stbi_uc* pixels = stbi_load(in.c_str(), &w, &h, &channels, STBI_rgb_alpha);
+        if (!pixels)
+            throw std::runtime_error("cannot decode " + in + ": " + stbi_failure_reason());
+        const std::vector<std::uint8_t> source(pixels, pixels + static_cast<std::size_t>(w) * h * 4);
+        stbi_image_free(pixels);
+
+        const TexelFormat format = pickFormat(formatName, source, mipOptions.srgb);
+        mipOptions.maxLevels = mips ? 0 : 1;
+        const gfx::MipChain levels = gfx::generateMips(source.data(), w, h, mipOptions);
+
+        std::vector<std::vector<std::byte>> chain;
+        for (const gfx::CookedMip& m : levels.levels) {
+            const std::uint8_t* texels = levels.rgba.data() + m.offset;
+            if (gfx::isBlockCompressed(format)) {
+                chain.push_back(gfx::bc::compressImage(format, texels, m.width, m.height));
+            } else {
+                const auto* first = reinterpret_cast<const std::byte*>(texels);
+                chain.emplace_back(first, first + m.size);
+            }
+        }
+
+        const auto blob = gfx::buildCookedTexture(format, static_cast<std::uint32_t>(w),
+                                                  static_cast<std::uint32_t>(h), chain);
+        std::ofstream file(out, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!file)
+            throw std::runtime_error("cannot write " + out);
+
+        std::printf("%s: %dx%d, %zu mips, %llu bytes (RGBA8 level 0 alone: %llu)\n", out.c_str(), w, h, chain.size(),
+                    static_cast<unsigned long long>(blob.size()),
+                    static_cast<unsigned long long>(std::uint64_t{4} * w * h));
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "texture_cooker: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}